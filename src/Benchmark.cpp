@@ -0,0 +1,95 @@
+#include "Benchmark.h"
+
+#include "Logger.h"
+#include "string_formatting.h"
+
+#include <chrono>
+#include <iostream>
+#include <algorithm>
+#include <cctype>
+
+Benchmark::Benchmark(const std::string &romFilename, const std::string &inputScriptFilename,
+        bool isIdleSkippingEnabled, const std::vector<FusedPair> &fusedPairs,
+        int frameSkip/*=0*/)
+    : m_machine{romFilename}
+{
+    m_machine.setIdleSkipping(isIdleSkippingEnabled);
+    m_machine.setFusedPairs(fusedPairs);
+    m_machine.setFrameSkip(frameSkip);
+
+    if (!inputScriptFilename.empty())
+    {
+        m_inputScript = InputScript{inputScriptFilename};
+        m_inputScript.queueTCycleEvents(&m_machine);
+    }
+}
+
+void Benchmark::updateHashes()
+{
+    const PPU *ppu{m_machine.getPpu()};
+    m_frameBufferHash = hashFnv1a64(
+            ppu->getPixelData(),
+            ppu->getPixelPitch()*TILE_MAP_DISPLAYED_TILES_PER_COL*TILE_SIZE,
+            m_frameBufferHash);
+
+    const Memory *memory{m_machine.getMemory()};
+    m_wramHash = hashFnv1a64(memory->getWram().data(), memory->getWram().size(), m_wramHash);
+}
+
+bool Benchmark::run(unsigned long frames, const std::string &expectedHashes)
+{
+    namespace chr = std::chrono;
+
+    const auto startTime{chr::steady_clock::now()};
+    chr::steady_clock::duration hashingTime{};
+
+    for (unsigned long frameI{}; frameI < frames; ++frameI)
+    {
+        m_inputScript.applyFrame(frameI, m_machine.getJoypad());
+        const unsigned long skippedFrames{m_machine.getSkippedFrames()};
+        m_machine.emulateFrame();
+
+        // Don't count the hashing and printing to the emulation time
+        const auto hashStartTime{chr::steady_clock::now()};
+        updateHashes();
+        std::cout << "frame " << frameI
+            << " fb " << toHexStr(m_frameBufferHash, 16, false)
+            << " wram " << toHexStr(m_wramHash, 16, false)
+            << (m_machine.getSkippedFrames() != skippedFrames ? " skipped" : "") << '\n';
+        hashingTime += chr::steady_clock::now()-hashStartTime;
+    }
+
+    const double seconds{chr::duration<double>(chr::steady_clock::now()-startTime-hashingTime).count()};
+    const unsigned long framesDone{m_machine.getFramesDone()};
+    const unsigned long long tCyclesDone{m_machine.getTCyclesDone()};
+
+    std::cout << std::dec
+        << "----- Benchmark results -----\n"
+        << "Frames:            " << framesDone << '\n'
+        << "Time:              " << seconds << " s\n"
+        << "Rendered frames:   " << m_machine.getRenderedFrames() << '\n'
+        << "Skipped frames:    " << m_machine.getSkippedFrames() << '\n'
+        << "Emulated FPS:      " << framesDone/seconds << '\n'
+        << "T-cycles/s:        " << tCyclesDone/seconds
+            << " (" << tCyclesDone/seconds/DMG_CLOCK_HZ << "x real speed)\n"
+        << "Framebuffer hash:  " << toHexStr(m_frameBufferHash, 16, false) << '\n'
+        << "WRAM hash:         " << toHexStr(m_wramHash, 16, false) << '\n';
+    std::cout.flush();
+
+    if (!expectedHashes.empty())
+    {
+        const std::string actualHashes{
+            toHexStr(m_frameBufferHash, 16, false)+":"+toHexStr(m_wramHash, 16, false)};
+        std::string expectedLower{expectedHashes};
+        std::transform(expectedLower.begin(), expectedLower.end(), expectedLower.begin(),
+                [](unsigned char c){ return std::tolower(c); });
+        if (actualHashes != expectedLower)
+        {
+            Logger::error("Hash mismatch! Expected: "+expectedLower+", got: "+actualHashes);
+            return false;
+        }
+        std::cout << "Hashes match\n";
+    }
+
+    return true;
+}
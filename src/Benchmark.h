@@ -0,0 +1,50 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "config.h"
+#include "common.h"
+
+#include "GBMachine.h"
+#include "InputScript.h"
+#include "hashing.h"
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+/*
+ * Runs a ROM headless for a fixed number of frames, replaying an input script.
+ *
+ * After every frame a rolling hash of the framebuffer and of the WRAM is printed,
+ * so a change in the emulation output can be detected.
+ */
+class Benchmark final
+{
+private:
+    GBMachine       m_machine;
+    InputScript     m_inputScript;
+
+    uint64_t        m_frameBufferHash{FNV1A64_OFFSET_BASIS};
+    uint64_t        m_wramHash{FNV1A64_OFFSET_BASIS};
+
+    void updateHashes();
+
+public:
+    /*
+     * `inputScriptFilename` can be empty.
+     * `frameSkip` is passed to GBMachine::setFrameSkip(), the hash of a skipped frame is the hash of the last drawn one.
+     */
+    Benchmark(const std::string &romFilename, const std::string &inputScriptFilename,
+            bool isIdleSkippingEnabled, const std::vector<FusedPair> &fusedPairs,
+            int frameSkip=0);
+
+    /*
+     * Emulates `frames` frames and prints the results.
+     *
+     * `expectedHashes` is either empty or "<framebuffer hash>:<WRAM hash>" in hex.
+     * Returns false if the final hashes don't match the expected ones.
+     */
+    bool run(unsigned long frames, const std::string &expectedHashes);
+};
+
+#endif // BENCHMARK_H
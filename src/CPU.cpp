@@ -1,611 +1,504 @@
 #include "CPU.h"
-#include "opcode_sizes.h"
+#include "opcode_table.h"
 
 #include "common.h"
 
+#include <algorithm>
+
+//#define LOG_OPCODE
+
 CPU::CPU(Memory *memory)
 {
-    m_registers = new Registers;
     m_memoryPtr = memory;
+    setFusedPairs({defaultFusedPairs.begin(), defaultFusedPairs.end()});
+}
+
+void CPU::setFusedPairs(const std::vector<FusedPair> &pairs)
+{
+    for (std::bitset<256> &seconds : m_fusedPairs)
+        seconds.reset();
+    for (const FusedPair &pair : pairs)
+    {
+        // Only these have a handler in executeFusedPair()
+        if (std::none_of(defaultFusedPairs.begin(), defaultFusedPairs.end(), [&pair](const FusedPair &supported){
+                    return supported.first == pair.first && supported.second == pair.second; }))
+        {
+            Logger::warning("No handler for the fused pair "+toHexStr(pair.first, 2)+' '+toHexStr(pair.second, 2)+", ignored");
+            continue;
+        }
+        m_fusedPairs[pair.first][pair.second] = true;
+    }
+
+    for (int i{}; i < 256; ++i)
+        m_isFusedPairFirst[i] = m_fusedPairs[i].any();
 }
 
 void CPU::fetchOpcode()
 {
-    uint32_t bytesAtPc{m_memoryPtr->getOpcodeNoSwap(m_registers->getPC())};
+    const uint16_t pc{m_registers.getPC()};
+    m_currentOpcodeAddr = pc;
+
+    // Get the page again only when the PC leaves it or a bank is switched
+    if ((pc >> 8) != m_fetchPageI || m_memoryPtr->getPageMapVersion() != m_fetchPageMapVersion)
+    {
+        m_fetchPageI = pc >> 8;
+        m_fetchPageMapVersion = m_memoryPtr->getPageMapVersion();
+        m_fetchPagePtr = m_memoryPtr->getPagePtr(pc);
+    }
+
+    // The HALT bug: the byte after HALT is read twice, so the operands start at the opcode
+    const uint16_t operandAddr{(uint16_t)(m_isHaltBug ? pc : pc+1)};
+
+    uint8_t operandLow{};
+    uint8_t operandHigh{};
+    // The page pointer can be used if the whole instruction is in the page
+    if (m_fetchPagePtr && (pc & 0xff) <= 0xfd)
+    {
+        m_currentOpcode = m_fetchPagePtr[pc & 0xff];
+        operandLow = m_fetchPagePtr[operandAddr & 0xff];
+        operandHigh = m_fetchPagePtr[(operandAddr & 0xff)+1];
+    }
+    else
+    {
+        m_currentOpcode = m_memoryPtr->get(pc, false);
+        operandLow = m_memoryPtr->get(operandAddr, false);
+        operandHigh = m_memoryPtr->get(operandAddr+1, false);
+    }
 
-    int opcodeSize{};
+    // The prefixed opcode is in the place of the operand, so it is fetched with the prefix
+    m_isPrefixedOpcode = (m_currentOpcode == 0xcb);
     if (m_isPrefixedOpcode)
-        opcodeSize = prefixedOpcodeSizes[bytesAtPc >> 24];
+    {
+        m_currentOpcode = operandLow;
+        m_opcodeSize = prefixedOpcodeTable[m_currentOpcode].size;
+        m_currentOperand = 0;
+    }
     else
-        opcodeSize = opcodeSizes[bytesAtPc >> 24];
+    {
+        m_opcodeSize = opcodeTable[m_currentOpcode].size;
+        switch (m_opcodeSize)
+        {
+        case 1:
+            m_currentOperand = 0;
+            break;
+        case 2:
+            m_currentOperand = operandLow;
+            break;
+        case 3:
+            m_currentOperand = operandLow | (operandHigh << 8);
+            break;
+        default:
+            IMPOSSIBLE();
+        }
+    }
 
-    switch (opcodeSize)
+    // Look at the next opcode only if the current one can start a fused pair.
+    // After EI the IME is set between the two opcodes, so an interrupt could come between them.
+    m_fusedPairCycles = 0;
+    if (m_isFusedPairFirst[m_currentOpcode] && !m_isPrefixedOpcode && !m_isHaltBug && !m_wasEiInstruction)
     {
-    case 1:
-        m_currentOpcode = bytesAtPc & 0xff000000;
-        break;
-    case 2:
-        m_currentOpcode = bytesAtPc & 0xffff0000;
-        break;
-    case 3:
-        m_currentOpcode =  (bytesAtPc & 0xff000000) |
-                          ((bytesAtPc & 0x00ff0000) >> 8) |
-                          ((bytesAtPc & 0x0000ff00) << 8);
-        break;
-    default:
-        IMPOSSIBLE();
+        const uint16_t nextAddr{(uint16_t)(pc+m_opcodeSize)};
+        uint8_t nextOpcode;
+        uint8_t nextOperand;
+        if (m_fetchPagePtr && (nextAddr >> 8) == (pc >> 8) && (nextAddr & 0xff) <= 0xfe)
+        {
+            nextOpcode = m_fetchPagePtr[nextAddr & 0xff];
+            nextOperand = m_fetchPagePtr[(nextAddr & 0xff)+1];
+        }
+        else
+        {
+            nextOpcode = m_memoryPtr->get(nextAddr, false);
+            nextOperand = m_memoryPtr->get(nextAddr+1, false);
+        }
+
+        // LD (DE),A is only fused if the write can't change the hardware: not to the ROM (the MBC),
+        // the OAM or the I/O registers
+        const uint16_t de{m_registers.getDE()};
+        const bool isWriteSafe{nextOpcode != 0x12
+            || (de >= 0x8000 && de < 0xfe00) || (de >= 0xff80 && de < 0xffff)};
+
+        if (m_fusedPairs[m_currentOpcode][nextOpcode] && isWriteSafe)
+        {
+            m_fusedOpcode = nextOpcode;
+            m_fusedOperand = nextOperand;
+            m_fusedPairCycles = opcodeTable[m_currentOpcode].cycles+opcodeTable[nextOpcode].branchCycles;
+        }
     }
 
-    m_opcodeSize = opcodeSize;
+    // The jumps and the calls set the PC relative to the next opcode
+    if (m_isHaltBug)
+    {
+        m_registers.setPC(pc+m_opcodeSize-1);
+        m_isHaltBug = false;
+    }
+    else
+    {
+        m_registers.setPC(pc+m_opcodeSize);
+    }
 }
 
-bool CPU::handleInterrupts()
+int CPU::fetchNext()
 {
-    for (int i{}; i < 5; ++i)
+    // The interrupt dispatch takes 5 M-cycles
+    const int mCycles{handleInterrupts() ? 5 : 0};
+    if (m_isHalted)
     {
-        // If interrrupts are disabled, exit
-        if (!m_registers->getIme()) break;
+        m_fusedPairCycles = 0;
+        return mCycles;
+    }
 
-        // Interrupt enable
-        uint8_t ieValue{m_memoryPtr->get(REGISTER_ADDR_IE, false)};
-        // Interrupt request
-        uint8_t ifValue{m_memoryPtr->get(REGISTER_ADDR_IF, false)};
+    fetchOpcode();
 
-        // If the interrupt is enabled and is requested
-        if (ieValue & ifValue & (1 << i))
-        {
-            //Logger::info("Handling interrupt: "+toHexStr(m_interruptHandlers[i]));
+#ifdef LOG_OPCODE
+    Logger::info("----- Cycle -----");
+    Logger::info("PC: "+toHexStr(m_currentOpcodeAddr));
+    Logger::info("Opcode value: "+toHexStr(m_currentOpcode));
+    Logger::info("Operand:      "+toHexStr(m_currentOperand));
+    Logger::info("Opcode name:  "+disassemble(m_currentOpcode, m_currentOperand, m_isPrefixedOpcode));
+    Logger::info("Opcode size:  "+std::to_string(m_opcodeSize));
+#endif
+
+    return mCycles;
+}
 
-            m_registers->unsetIme();
+int CPU::executeOpcode()
+{
+    const int mCycles{m_isPrefixedOpcode ? emulateCurrentPrefixedOpcode() : emulateCurrentOpcode()};
+    enableImaIfNeeded();
+    return mCycles;
+}
 
-            // Reset the current bit
-            ifValue &= ~(1 << i);
+int CPU::executeFusedPair()
+{
+    const opcode_t firstOpcode{m_currentOpcode};
+    const uint16_t firstOperand{m_currentOperand};
+    const uint16_t secondAddr{m_registers.getPC()};
 
-            // Feed back the new value of IF
-            m_memoryPtr->set(REGISTER_ADDR_IF, ifValue, false);
+    // The second opcode becomes the current one, the first opcodes don't use the PC
+    m_currentOpcode = m_fusedOpcode;
+    m_currentOpcodeAddr = secondAddr;
+    m_opcodeSize = opcodeTable[m_fusedOpcode].size;
+    m_currentOperand = (m_opcodeSize == 2 ? m_fusedOperand : 0);
+    m_registers.setPC(secondAddr+m_opcodeSize);
+    m_isBranchTaken = false;
 
-            // Call the handler
-            call(0x40 + i*8);
-            return true;
-        }
+    switch ((firstOpcode << 8) | m_fusedOpcode)
+    {
+    case 0x2a12: i_0x2a(); i_0x12(); break;
+    case 0x0b78: i_0x0b(); i_0x78(); break;
+    case 0x78b1: i_0x78(); i_0xb1(); break;
+    case 0x0520: i_0x05(); i_0x20(m_currentOperand); break;
+    case 0x0d20: i_0x0d(); i_0x20(m_currentOperand); break;
+    case 0x3d20: i_0x3d(); i_0x20(m_currentOperand); break;
+    case 0xf0e6: i_0xf0(firstOperand); i_0xe6(m_currentOperand); break;
+    case 0xf0fe: i_0xf0(firstOperand); i_0xfe(m_currentOperand); break;
+    default: IMPOSSIBLE(); break;
     }
-    return false;
+
+    const OpcodeInfo &second{opcodeTable[m_fusedOpcode]};
+    m_fusedPairCycles = 0;
+    return opcodeTable[firstOpcode].cycles+(m_isBranchTaken ? second.branchCycles : second.cycles);
 }
 
-int CPU::emulateCurrentOpcode()
+const std::array<CPU::PrefixedOpcodeHandler, 256> CPU::prefixedOpcodeHandlers{
+        CPU::makePrefixedOpcodeHandlers(std::make_index_sequence<256>{})};
+
+bool CPU::handleInterrupts()
 {
-    m_wasJump = false;
+    const uint8_t pendingInterrupts{m_memoryPtr->getPendingInterrupts()};
+    // Usually nothing is pending
+    if (!pendingInterrupts)
+        return false;
 
-    switch (m_currentOpcode >> 24)
-    {
-    case 0x00: return i_0x00();
-    case 0x01: return i_0x01((m_currentOpcode&0x00ffff00)>>8);
-    case 0x02: return i_0x02();
-    case 0x03: return i_0x03();
-    case 0x04: return i_0x04();
-    case 0x05: return i_0x05();
-    case 0x06: return i_0x06((m_currentOpcode&0x00ff0000)>>16);
-    case 0x07: return i_0x07();
-    case 0x08: return i_0x08((m_currentOpcode&0x00ffff00)>>8);
-    case 0x09: return i_0x09();
-    case 0x0a: return i_0x0a();
-    case 0x0b: return i_0x0b();
-    case 0x0c: return i_0x0c();
-    case 0x0d: return i_0x0d();
-    case 0x0e: return i_0x0e((m_currentOpcode&0x00ff0000)>>16);
-    case 0x0f: return i_0x0f();
-    case 0x10: return i_0x10();
-    case 0x11: return i_0x11((m_currentOpcode&0x00ffff00)>>8);
-    case 0x12: return i_0x12();
-    case 0x13: return i_0x13();
-    case 0x14: return i_0x14();
-    case 0x15: return i_0x15();
-    case 0x16: return i_0x16((m_currentOpcode&0x00ff0000)>>16);
-    case 0x17: return i_0x17();
-    case 0x18: return i_0x18((m_currentOpcode&0x00ff0000)>>16);
-    case 0x19: return i_0x19();
-    case 0x1a: return i_0x1a();
-    case 0x1b: return i_0x1b();
-    case 0x1c: return i_0x1c();
-    case 0x1d: return i_0x1d();
-    case 0x1e: return i_0x1e((m_currentOpcode&0x00ff0000)>>16);
-    case 0x1f: return i_0x1f();
-    case 0x20: return i_0x20((m_currentOpcode&0x00ff0000)>>16);
-    case 0x21: return i_0x21((m_currentOpcode&0x00ffff00)>>8);
-    case 0x22: return i_0x22();
-    case 0x23: return i_0x23();
-    case 0x24: return i_0x24();
-    case 0x25: return i_0x25();
-    case 0x26: return i_0x26((m_currentOpcode&0x00ff0000)>>16);
-    case 0x27: return i_0x27();
-    case 0x28: return i_0x28((m_currentOpcode&0x00ff0000)>>16);
-    case 0x29: return i_0x29();
-    case 0x2a: return i_0x2a();
-    case 0x2b: return i_0x2b();
-    case 0x2c: return i_0x2c();
-    case 0x2d: return i_0x2d();
-    case 0x2e: return i_0x2e((m_currentOpcode&0x00ff0000)>>16);
-    case 0x2f: return i_0x2f();
-    case 0x30: return i_0x30((m_currentOpcode&0x00ff0000)>>16);
-    case 0x31: return i_0x31((m_currentOpcode&0x00ffff00)>>8);
-    case 0x32: return i_0x32();
-    case 0x33: return i_0x33();
-    case 0x34: return i_0x34();
-    case 0x35: return i_0x35();
-    case 0x36: return i_0x36((m_currentOpcode&0x00ff0000)>>16);
-    case 0x37: return i_0x37();
-    case 0x38: return i_0x38((m_currentOpcode&0x00ff0000)>>16);
-    case 0x39: return i_0x39();
-    case 0x3a: return i_0x3a();
-    case 0x3b: return i_0x3b();
-    case 0x3c: return i_0x3c();
-    case 0x3d: return i_0x3d();
-    case 0x3e: return i_0x3e((m_currentOpcode&0x00ff0000)>>16);
-    case 0x3f: return i_0x3f();
-    case 0x40: return i_0x40();
-    case 0x41: return i_0x41();
-    case 0x42: return i_0x42();
-    case 0x43: return i_0x43();
-    case 0x44: return i_0x44();
-    case 0x45: return i_0x45();
-    case 0x46: return i_0x46();
-    case 0x47: return i_0x47();
-    case 0x48: return i_0x48();
-    case 0x49: return i_0x49();
-    case 0x4a: return i_0x4a();
-    case 0x4b: return i_0x4b();
-    case 0x4c: return i_0x4c();
-    case 0x4d: return i_0x4d();
-    case 0x4e: return i_0x4e();
-    case 0x4f: return i_0x4f();
-    case 0x50: return i_0x50();
-    case 0x51: return i_0x51();
-    case 0x52: return i_0x52();
-    case 0x53: return i_0x53();
-    case 0x54: return i_0x54();
-    case 0x55: return i_0x55();
-    case 0x56: return i_0x56();
-    case 0x57: return i_0x57();
-    case 0x58: return i_0x58();
-    case 0x59: return i_0x59();
-    case 0x5a: return i_0x5a();
-    case 0x5b: return i_0x5b();
-    case 0x5c: return i_0x5c();
-    case 0x5d: return i_0x5d();
-    case 0x5e: return i_0x5e();
-    case 0x5f: return i_0x5f();
-    case 0x60: return i_0x60();
-    case 0x61: return i_0x61();
-    case 0x62: return i_0x62();
-    case 0x63: return i_0x63();
-    case 0x64: return i_0x64();
-    case 0x65: return i_0x65();
-    case 0x66: return i_0x66();
-    case 0x67: return i_0x67();
-    case 0x68: return i_0x68();
-    case 0x69: return i_0x69();
-    case 0x6a: return i_0x6a();
-    case 0x6b: return i_0x6b();
-    case 0x6c: return i_0x6c();
-    case 0x6d: return i_0x6d();
-    case 0x6e: return i_0x6e();
-    case 0x6f: return i_0x6f();
-    case 0x70: return i_0x70();
-    case 0x71: return i_0x71();
-    case 0x72: return i_0x72();
-    case 0x73: return i_0x73();
-    case 0x74: return i_0x74();
-    case 0x75: return i_0x75();
-    case 0x76: return i_0x76();
-    case 0x77: return i_0x77();
-    case 0x78: return i_0x78();
-    case 0x79: return i_0x79();
-    case 0x7a: return i_0x7a();
-    case 0x7b: return i_0x7b();
-    case 0x7c: return i_0x7c();
-    case 0x7d: return i_0x7d();
-    case 0x7e: return i_0x7e();
-    case 0x7f: return i_0x7f();
-    case 0x80: return i_0x80();
-    case 0x81: return i_0x81();
-    case 0x82: return i_0x82();
-    case 0x83: return i_0x83();
-    case 0x84: return i_0x84();
-    case 0x85: return i_0x85();
-    case 0x86: return i_0x86();
-    case 0x87: return i_0x87();
-    case 0x88: return i_0x88();
-    case 0x89: return i_0x89();
-    case 0x8a: return i_0x8a();
-    case 0x8b: return i_0x8b();
-    case 0x8c: return i_0x8c();
-    case 0x8d: return i_0x8d();
-    case 0x8e: return i_0x8e();
-    case 0x8f: return i_0x8f();
-    case 0x90: return i_0x90();
-    case 0x91: return i_0x91();
-    case 0x92: return i_0x92();
-    case 0x93: return i_0x93();
-    case 0x94: return i_0x94();
-    case 0x95: return i_0x95();
-    case 0x96: return i_0x96();
-    case 0x97: return i_0x97();
-    case 0x98: return i_0x98();
-    case 0x99: return i_0x99();
-    case 0x9a: return i_0x9a();
-    case 0x9b: return i_0x9b();
-    case 0x9c: return i_0x9c();
-    case 0x9d: return i_0x9d();
-    case 0x9e: return i_0x9e();
-    case 0x9f: return i_0x9f();
-    case 0xa0: return i_0xa0();
-    case 0xa1: return i_0xa1();
-    case 0xa2: return i_0xa2();
-    case 0xa3: return i_0xa3();
-    case 0xa4: return i_0xa4();
-    case 0xa5: return i_0xa5();
-    case 0xa6: return i_0xa6();
-    case 0xa7: return i_0xa7();
-    case 0xa8: return i_0xa8();
-    case 0xa9: return i_0xa9();
-    case 0xaa: return i_0xaa();
-    case 0xab: return i_0xab();
-    case 0xac: return i_0xac();
-    case 0xad: return i_0xad();
-    case 0xae: return i_0xae();
-    case 0xaf: return i_0xaf();
-    case 0xb0: return i_0xb0();
-    case 0xb1: return i_0xb1();
-    case 0xb2: return i_0xb2();
-    case 0xb3: return i_0xb3();
-    case 0xb4: return i_0xb4();
-    case 0xb5: return i_0xb5();
-    case 0xb6: return i_0xb6();
-    case 0xb7: return i_0xb7();
-    case 0xb8: return i_0xb8();
-    case 0xb9: return i_0xb9();
-    case 0xba: return i_0xba();
-    case 0xbb: return i_0xbb();
-    case 0xbc: return i_0xbc();
-    case 0xbd: return i_0xbd();
-    case 0xbe: return i_0xbe();
-    case 0xbf: return i_0xbf();
-    case 0xc0: return i_0xc0();
-    case 0xc1: return i_0xc1();
-    case 0xc2: return i_0xc2((m_currentOpcode&0x00ffff00)>>8);
-    case 0xc3: return i_0xc3((m_currentOpcode&0x00ffff00)>>8);
-    case 0xc4: return i_0xc4((m_currentOpcode&0x00ffff00)>>8);
-    case 0xc5: return i_0xc5();
-    case 0xc6: return i_0xc6((m_currentOpcode&0x00ff0000)>>16);
-    case 0xc7: return i_0xc7();
-    case 0xc8: return i_0xc8();
-    case 0xc9: return i_0xc9();
-    case 0xca: return i_0xca((m_currentOpcode&0x00ffff00)>>8);
-    case 0xcb: return i_0xcb();
-    case 0xcc: return i_0xcc((m_currentOpcode&0x00ffff00)>>8);
-    case 0xcd: return i_0xcd((m_currentOpcode&0x00ffff00)>>8);
-    case 0xce: return i_0xce((m_currentOpcode&0x00ff0000)>>16);
-    case 0xcf: return i_0xcf();
-    case 0xd0: return i_0xd0();
-    case 0xd1: return i_0xd1();
-    case 0xd2: return i_0xd2((m_currentOpcode&0x00ffff00)>>8);
-    case 0xd3: return i_0xd3();
-    case 0xd4: return i_0xd4((m_currentOpcode&0x00ffff00)>>8);
-    case 0xd5: return i_0xd5();
-    case 0xd6: return i_0xd6((m_currentOpcode&0x00ff0000)>>16);
-    case 0xd7: return i_0xd7();
-    case 0xd8: return i_0xd8();
-    case 0xd9: return i_0xd9();
-    case 0xda: return i_0xda((m_currentOpcode&0x00ffff00)>>8);
-    case 0xdb: return i_0xdb();
-    case 0xdc: return i_0xdc((m_currentOpcode&0x00ffff00)>>8);
-    case 0xdd: return i_0xdd();
-    case 0xde: return i_0xde((m_currentOpcode&0x00ff0000)>>16);
-    case 0xdf: return i_0xdf();
-    case 0xe0: return i_0xe0((m_currentOpcode&0x00ff0000)>>16);
-    case 0xe1: return i_0xe1();
-    case 0xe2: return i_0xe2();
-    case 0xe3: return i_0xe3();
-    case 0xe4: return i_0xe4();
-    case 0xe5: return i_0xe5();
-    case 0xe6: return i_0xe6((m_currentOpcode&0x00ff0000)>>16);
-    case 0xe7: return i_0xe7();
-    case 0xe8: return i_0xe8((m_currentOpcode&0x00ff0000)>>16);
-    case 0xe9: return i_0xe9();
-    case 0xea: return i_0xea((m_currentOpcode&0x00ff0000)>>16);
-    case 0xeb: return i_0xeb();
-    case 0xec: return i_0xec();
-    case 0xed: return i_0xed();
-    case 0xee: return i_0xee((m_currentOpcode&0x00ff0000)>>16);
-    case 0xef: return i_0xef();
-    case 0xf0: return i_0xf0((m_currentOpcode&0x00ff0000)>>16);
-    case 0xf1: return i_0xf1();
-    case 0xf2: return i_0xf2();
-    case 0xf3: return i_0xf3();
-    case 0xf4: return i_0xf4();
-    case 0xf5: return i_0xf5();
-    case 0xf6: return i_0xf6((m_currentOpcode&0x00ff0000)>>16);
-    case 0xf7: return i_0xf7();
-    case 0xf8: return i_0xf8((m_currentOpcode&0x00ff0000)>>16);
-    case 0xf9: return i_0xf9();
-    case 0xfa: return i_0xfa((m_currentOpcode&0x00ff0000)>>16);
-    case 0xfb: return i_0xfb();
-    case 0xfc: return i_0xfc();
-    case 0xfd: return i_0xfd();
-    case 0xfe: return i_0xfe((m_currentOpcode&0x00ff0000)>>16);
-    case 0xff: return i_0xff();
-    default:   return -1;
-    }
+    // A requested interrupt wakes up the CPU, even if the interrupts are disabled
+    m_isHalted = false;
+
+    if (!m_registers.getIme())
+        return false;
+
+    // The lowest bit has the highest priority
+    const int i{__builtin_ctz(pendingInterrupts)};
+
+    m_registers.unsetIme();
+    m_memoryPtr->acknowledgeInterrupt(1 << i);
+
+    // Call the handler
+    // The current instruction is not executed yet, so it is the return address
+    _push16(m_registers.getPC());
+    jpToAddress(0x40 + i*8);
+    return true;
 }
 
-int CPU::emulateCurrentPrefixedOpcode()
+int CPU::emulateCurrentOpcode()
 {
-    m_wasJump = false;
-    m_isPrefixedOpcode = false;
+    m_isBranchTaken = false;
 
-    switch (m_currentOpcode >> 24)
+    switch (m_currentOpcode)
     {
-    case 0x00: return i_pref_0x00();
-    case 0x01: return i_pref_0x01();
-    case 0x02: return i_pref_0x02();
-    case 0x03: return i_pref_0x03();
-    case 0x04: return i_pref_0x04();
-    case 0x05: return i_pref_0x05();
-    case 0x06: return i_pref_0x06();
-    case 0x07: return i_pref_0x07();
-    case 0x08: return i_pref_0x08();
-    case 0x09: return i_pref_0x09();
-    case 0x0a: return i_pref_0x0a();
-    case 0x0b: return i_pref_0x0b();
-    case 0x0c: return i_pref_0x0c();
-    case 0x0d: return i_pref_0x0d();
-    case 0x0e: return i_pref_0x0e();
-    case 0x0f: return i_pref_0x0f();
-    case 0x10: return i_pref_0x10();
-    case 0x11: return i_pref_0x11();
-    case 0x12: return i_pref_0x12();
-    case 0x13: return i_pref_0x13();
-    case 0x14: return i_pref_0x14();
-    case 0x15: return i_pref_0x15();
-    case 0x16: return i_pref_0x16();
-    case 0x17: return i_pref_0x17();
-    case 0x18: return i_pref_0x18();
-    case 0x19: return i_pref_0x19();
-    case 0x1a: return i_pref_0x1a();
-    case 0x1b: return i_pref_0x1b();
-    case 0x1c: return i_pref_0x1c();
-    case 0x1d: return i_pref_0x1d();
-    case 0x1e: return i_pref_0x1e();
-    case 0x1f: return i_pref_0x1f();
-    case 0x20: return i_pref_0x20();
-    case 0x21: return i_pref_0x21();
-    case 0x22: return i_pref_0x22();
-    case 0x23: return i_pref_0x23();
-    case 0x24: return i_pref_0x24();
-    case 0x25: return i_pref_0x25();
-    case 0x26: return i_pref_0x26();
-    case 0x27: return i_pref_0x27();
-    case 0x28: return i_pref_0x28();
-    case 0x29: return i_pref_0x29();
-    case 0x2a: return i_pref_0x2a();
-    case 0x2b: return i_pref_0x2b();
-    case 0x2c: return i_pref_0x2c();
-    case 0x2d: return i_pref_0x2d();
-    case 0x2e: return i_pref_0x2e();
-    case 0x2f: return i_pref_0x2f();
-    case 0x30: return i_pref_0x30();
-    case 0x31: return i_pref_0x31();
-    case 0x32: return i_pref_0x32();
-    case 0x33: return i_pref_0x33();
-    case 0x34: return i_pref_0x34();
-    case 0x35: return i_pref_0x35();
-    case 0x36: return i_pref_0x36();
-    case 0x37: return i_pref_0x37();
-    case 0x38: return i_pref_0x38();
-    case 0x39: return i_pref_0x39();
-    case 0x3a: return i_pref_0x3a();
-    case 0x3b: return i_pref_0x3b();
-    case 0x3c: return i_pref_0x3c();
-    case 0x3d: return i_pref_0x3d();
-    case 0x3e: return i_pref_0x3e();
-    case 0x3f: return i_pref_0x3f();
-    case 0x40: return i_pref_0x40();
-    case 0x41: return i_pref_0x41();
-    case 0x42: return i_pref_0x42();
-    case 0x43: return i_pref_0x43();
-    case 0x44: return i_pref_0x44();
-    case 0x45: return i_pref_0x45();
-    case 0x46: return i_pref_0x46();
-    case 0x47: return i_pref_0x47();
-    case 0x48: return i_pref_0x48();
-    case 0x49: return i_pref_0x49();
-    case 0x4a: return i_pref_0x4a();
-    case 0x4b: return i_pref_0x4b();
-    case 0x4c: return i_pref_0x4c();
-    case 0x4d: return i_pref_0x4d();
-    case 0x4e: return i_pref_0x4e();
-    case 0x4f: return i_pref_0x4f();
-    case 0x50: return i_pref_0x50();
-    case 0x51: return i_pref_0x51();
-    case 0x52: return i_pref_0x52();
-    case 0x53: return i_pref_0x53();
-    case 0x54: return i_pref_0x54();
-    case 0x55: return i_pref_0x55();
-    case 0x56: return i_pref_0x56();
-    case 0x57: return i_pref_0x57();
-    case 0x58: return i_pref_0x58();
-    case 0x59: return i_pref_0x59();
-    case 0x5a: return i_pref_0x5a();
-    case 0x5b: return i_pref_0x5b();
-    case 0x5c: return i_pref_0x5c();
-    case 0x5d: return i_pref_0x5d();
-    case 0x5e: return i_pref_0x5e();
-    case 0x5f: return i_pref_0x5f();
-    case 0x60: return i_pref_0x60();
-    case 0x61: return i_pref_0x61();
-    case 0x62: return i_pref_0x62();
-    case 0x63: return i_pref_0x63();
-    case 0x64: return i_pref_0x64();
-    case 0x65: return i_pref_0x65();
-    case 0x66: return i_pref_0x66();
-    case 0x67: return i_pref_0x67();
-    case 0x68: return i_pref_0x68();
-    case 0x69: return i_pref_0x69();
-    case 0x6a: return i_pref_0x6a();
-    case 0x6b: return i_pref_0x6b();
-    case 0x6c: return i_pref_0x6c();
-    case 0x6d: return i_pref_0x6d();
-    case 0x6e: return i_pref_0x6e();
-    case 0x6f: return i_pref_0x6f();
-    case 0x70: return i_pref_0x70();
-    case 0x71: return i_pref_0x71();
-    case 0x72: return i_pref_0x72();
-    case 0x73: return i_pref_0x73();
-    case 0x74: return i_pref_0x74();
-    case 0x75: return i_pref_0x75();
-    case 0x76: return i_pref_0x76();
-    case 0x77: return i_pref_0x77();
-    case 0x78: return i_pref_0x78();
-    case 0x79: return i_pref_0x79();
-    case 0x7a: return i_pref_0x7a();
-    case 0x7b: return i_pref_0x7b();
-    case 0x7c: return i_pref_0x7c();
-    case 0x7d: return i_pref_0x7d();
-    case 0x7e: return i_pref_0x7e();
-    case 0x7f: return i_pref_0x7f();
-    case 0x80: return i_pref_0x80();
-    case 0x81: return i_pref_0x81();
-    case 0x82: return i_pref_0x82();
-    case 0x83: return i_pref_0x83();
-    case 0x84: return i_pref_0x84();
-    case 0x85: return i_pref_0x85();
-    case 0x86: return i_pref_0x86();
-    case 0x87: return i_pref_0x87();
-    case 0x88: return i_pref_0x88();
-    case 0x89: return i_pref_0x89();
-    case 0x8a: return i_pref_0x8a();
-    case 0x8b: return i_pref_0x8b();
-    case 0x8c: return i_pref_0x8c();
-    case 0x8d: return i_pref_0x8d();
-    case 0x8e: return i_pref_0x8e();
-    case 0x8f: return i_pref_0x8f();
-    case 0x90: return i_pref_0x90();
-    case 0x91: return i_pref_0x91();
-    case 0x92: return i_pref_0x92();
-    case 0x93: return i_pref_0x93();
-    case 0x94: return i_pref_0x94();
-    case 0x95: return i_pref_0x95();
-    case 0x96: return i_pref_0x96();
-    case 0x97: return i_pref_0x97();
-    case 0x98: return i_pref_0x98();
-    case 0x99: return i_pref_0x99();
-    case 0x9a: return i_pref_0x9a();
-    case 0x9b: return i_pref_0x9b();
-    case 0x9c: return i_pref_0x9c();
-    case 0x9d: return i_pref_0x9d();
-    case 0x9e: return i_pref_0x9e();
-    case 0x9f: return i_pref_0x9f();
-    case 0xa0: return i_pref_0xa0();
-    case 0xa1: return i_pref_0xa1();
-    case 0xa2: return i_pref_0xa2();
-    case 0xa3: return i_pref_0xa3();
-    case 0xa4: return i_pref_0xa4();
-    case 0xa5: return i_pref_0xa5();
-    case 0xa6: return i_pref_0xa6();
-    case 0xa7: return i_pref_0xa7();
-    case 0xa8: return i_pref_0xa8();
-    case 0xa9: return i_pref_0xa9();
-    case 0xaa: return i_pref_0xaa();
-    case 0xab: return i_pref_0xab();
-    case 0xac: return i_pref_0xac();
-    case 0xad: return i_pref_0xad();
-    case 0xae: return i_pref_0xae();
-    case 0xaf: return i_pref_0xaf();
-    case 0xb0: return i_pref_0xb0();
-    case 0xb1: return i_pref_0xb1();
-    case 0xb2: return i_pref_0xb2();
-    case 0xb3: return i_pref_0xb3();
-    case 0xb4: return i_pref_0xb4();
-    case 0xb5: return i_pref_0xb5();
-    case 0xb6: return i_pref_0xb6();
-    case 0xb7: return i_pref_0xb7();
-    case 0xb8: return i_pref_0xb8();
-    case 0xb9: return i_pref_0xb9();
-    case 0xba: return i_pref_0xba();
-    case 0xbb: return i_pref_0xbb();
-    case 0xbc: return i_pref_0xbc();
-    case 0xbd: return i_pref_0xbd();
-    case 0xbe: return i_pref_0xbe();
-    case 0xbf: return i_pref_0xbf();
-    case 0xc0: return i_pref_0xc0();
-    case 0xc1: return i_pref_0xc1();
-    case 0xc2: return i_pref_0xc2();
-    case 0xc3: return i_pref_0xc3();
-    case 0xc4: return i_pref_0xc4();
-    case 0xc5: return i_pref_0xc5();
-    case 0xc6: return i_pref_0xc6();
-    case 0xc7: return i_pref_0xc7();
-    case 0xc8: return i_pref_0xc8();
-    case 0xc9: return i_pref_0xc9();
-    case 0xca: return i_pref_0xca();
-    case 0xcb: return i_pref_0xcb();
-    case 0xcc: return i_pref_0xcc();
-    case 0xcd: return i_pref_0xcd();
-    case 0xce: return i_pref_0xce();
-    case 0xcf: return i_pref_0xcf();
-    case 0xd0: return i_pref_0xd0();
-    case 0xd1: return i_pref_0xd1();
-    case 0xd2: return i_pref_0xd2();
-    case 0xd3: return i_pref_0xd3();
-    case 0xd4: return i_pref_0xd4();
-    case 0xd5: return i_pref_0xd5();
-    case 0xd6: return i_pref_0xd6();
-    case 0xd7: return i_pref_0xd7();
-    case 0xd8: return i_pref_0xd8();
-    case 0xd9: return i_pref_0xd9();
-    case 0xda: return i_pref_0xda();
-    case 0xdb: return i_pref_0xdb();
-    case 0xdc: return i_pref_0xdc();
-    case 0xdd: return i_pref_0xdd();
-    case 0xde: return i_pref_0xde();
-    case 0xdf: return i_pref_0xdf();
-    case 0xe0: return i_pref_0xe0();
-    case 0xe1: return i_pref_0xe1();
-    case 0xe2: return i_pref_0xe2();
-    case 0xe3: return i_pref_0xe3();
-    case 0xe4: return i_pref_0xe4();
-    case 0xe5: return i_pref_0xe5();
-    case 0xe6: return i_pref_0xe6();
-    case 0xe7: return i_pref_0xe7();
-    case 0xe8: return i_pref_0xe8();
-    case 0xe9: return i_pref_0xe9();
-    case 0xea: return i_pref_0xea();
-    case 0xeb: return i_pref_0xeb();
-    case 0xec: return i_pref_0xec();
-    case 0xed: return i_pref_0xed();
-    case 0xee: return i_pref_0xee();
-    case 0xef: return i_pref_0xef();
-    case 0xf0: return i_pref_0xf0();
-    case 0xf1: return i_pref_0xf1();
-    case 0xf2: return i_pref_0xf2();
-    case 0xf3: return i_pref_0xf3();
-    case 0xf4: return i_pref_0xf4();
-    case 0xf5: return i_pref_0xf5();
-    case 0xf6: return i_pref_0xf6();
-    case 0xf7: return i_pref_0xf7();
-    case 0xf8: return i_pref_0xf8();
-    case 0xf9: return i_pref_0xf9();
-    case 0xfa: return i_pref_0xfa();
-    case 0xfb: return i_pref_0xfb();
-    case 0xfc: return i_pref_0xfc();
-    case 0xfd: return i_pref_0xfd();
-    case 0xfe: return i_pref_0xfe();
-    case 0xff: return i_pref_0xff();
-    default:   return -1;
+    case 0x00: i_0x00(); break;
+    case 0x01: i_0x01(m_currentOperand); break;
+    case 0x02: i_0x02(); break;
+    case 0x03: i_0x03(); break;
+    case 0x04: i_0x04(); break;
+    case 0x05: i_0x05(); break;
+    case 0x06: i_0x06(m_currentOperand); break;
+    case 0x07: i_0x07(); break;
+    case 0x08: i_0x08(m_currentOperand); break;
+    case 0x09: i_0x09(); break;
+    case 0x0a: i_0x0a(); break;
+    case 0x0b: i_0x0b(); break;
+    case 0x0c: i_0x0c(); break;
+    case 0x0d: i_0x0d(); break;
+    case 0x0e: i_0x0e(m_currentOperand); break;
+    case 0x0f: i_0x0f(); break;
+    case 0x10: i_0x10(); break;
+    case 0x11: i_0x11(m_currentOperand); break;
+    case 0x12: i_0x12(); break;
+    case 0x13: i_0x13(); break;
+    case 0x14: i_0x14(); break;
+    case 0x15: i_0x15(); break;
+    case 0x16: i_0x16(m_currentOperand); break;
+    case 0x17: i_0x17(); break;
+    case 0x18: i_0x18(m_currentOperand); break;
+    case 0x19: i_0x19(); break;
+    case 0x1a: i_0x1a(); break;
+    case 0x1b: i_0x1b(); break;
+    case 0x1c: i_0x1c(); break;
+    case 0x1d: i_0x1d(); break;
+    case 0x1e: i_0x1e(m_currentOperand); break;
+    case 0x1f: i_0x1f(); break;
+    case 0x20: i_0x20(m_currentOperand); break;
+    case 0x21: i_0x21(m_currentOperand); break;
+    case 0x22: i_0x22(); break;
+    case 0x23: i_0x23(); break;
+    case 0x24: i_0x24(); break;
+    case 0x25: i_0x25(); break;
+    case 0x26: i_0x26(m_currentOperand); break;
+    case 0x27: i_0x27(); break;
+    case 0x28: i_0x28(m_currentOperand); break;
+    case 0x29: i_0x29(); break;
+    case 0x2a: i_0x2a(); break;
+    case 0x2b: i_0x2b(); break;
+    case 0x2c: i_0x2c(); break;
+    case 0x2d: i_0x2d(); break;
+    case 0x2e: i_0x2e(m_currentOperand); break;
+    case 0x2f: i_0x2f(); break;
+    case 0x30: i_0x30(m_currentOperand); break;
+    case 0x31: i_0x31(m_currentOperand); break;
+    case 0x32: i_0x32(); break;
+    case 0x33: i_0x33(); break;
+    case 0x34: i_0x34(); break;
+    case 0x35: i_0x35(); break;
+    case 0x36: i_0x36(m_currentOperand); break;
+    case 0x37: i_0x37(); break;
+    case 0x38: i_0x38(m_currentOperand); break;
+    case 0x39: i_0x39(); break;
+    case 0x3a: i_0x3a(); break;
+    case 0x3b: i_0x3b(); break;
+    case 0x3c: i_0x3c(); break;
+    case 0x3d: i_0x3d(); break;
+    case 0x3e: i_0x3e(m_currentOperand); break;
+    case 0x3f: i_0x3f(); break;
+    case 0x40: i_0x40(); break;
+    case 0x41: i_0x41(); break;
+    case 0x42: i_0x42(); break;
+    case 0x43: i_0x43(); break;
+    case 0x44: i_0x44(); break;
+    case 0x45: i_0x45(); break;
+    case 0x46: i_0x46(); break;
+    case 0x47: i_0x47(); break;
+    case 0x48: i_0x48(); break;
+    case 0x49: i_0x49(); break;
+    case 0x4a: i_0x4a(); break;
+    case 0x4b: i_0x4b(); break;
+    case 0x4c: i_0x4c(); break;
+    case 0x4d: i_0x4d(); break;
+    case 0x4e: i_0x4e(); break;
+    case 0x4f: i_0x4f(); break;
+    case 0x50: i_0x50(); break;
+    case 0x51: i_0x51(); break;
+    case 0x52: i_0x52(); break;
+    case 0x53: i_0x53(); break;
+    case 0x54: i_0x54(); break;
+    case 0x55: i_0x55(); break;
+    case 0x56: i_0x56(); break;
+    case 0x57: i_0x57(); break;
+    case 0x58: i_0x58(); break;
+    case 0x59: i_0x59(); break;
+    case 0x5a: i_0x5a(); break;
+    case 0x5b: i_0x5b(); break;
+    case 0x5c: i_0x5c(); break;
+    case 0x5d: i_0x5d(); break;
+    case 0x5e: i_0x5e(); break;
+    case 0x5f: i_0x5f(); break;
+    case 0x60: i_0x60(); break;
+    case 0x61: i_0x61(); break;
+    case 0x62: i_0x62(); break;
+    case 0x63: i_0x63(); break;
+    case 0x64: i_0x64(); break;
+    case 0x65: i_0x65(); break;
+    case 0x66: i_0x66(); break;
+    case 0x67: i_0x67(); break;
+    case 0x68: i_0x68(); break;
+    case 0x69: i_0x69(); break;
+    case 0x6a: i_0x6a(); break;
+    case 0x6b: i_0x6b(); break;
+    case 0x6c: i_0x6c(); break;
+    case 0x6d: i_0x6d(); break;
+    case 0x6e: i_0x6e(); break;
+    case 0x6f: i_0x6f(); break;
+    case 0x70: i_0x70(); break;
+    case 0x71: i_0x71(); break;
+    case 0x72: i_0x72(); break;
+    case 0x73: i_0x73(); break;
+    case 0x74: i_0x74(); break;
+    case 0x75: i_0x75(); break;
+    case 0x76: i_0x76(); break;
+    case 0x77: i_0x77(); break;
+    case 0x78: i_0x78(); break;
+    case 0x79: i_0x79(); break;
+    case 0x7a: i_0x7a(); break;
+    case 0x7b: i_0x7b(); break;
+    case 0x7c: i_0x7c(); break;
+    case 0x7d: i_0x7d(); break;
+    case 0x7e: i_0x7e(); break;
+    case 0x7f: i_0x7f(); break;
+    case 0x80: i_0x80(); break;
+    case 0x81: i_0x81(); break;
+    case 0x82: i_0x82(); break;
+    case 0x83: i_0x83(); break;
+    case 0x84: i_0x84(); break;
+    case 0x85: i_0x85(); break;
+    case 0x86: i_0x86(); break;
+    case 0x87: i_0x87(); break;
+    case 0x88: i_0x88(); break;
+    case 0x89: i_0x89(); break;
+    case 0x8a: i_0x8a(); break;
+    case 0x8b: i_0x8b(); break;
+    case 0x8c: i_0x8c(); break;
+    case 0x8d: i_0x8d(); break;
+    case 0x8e: i_0x8e(); break;
+    case 0x8f: i_0x8f(); break;
+    case 0x90: i_0x90(); break;
+    case 0x91: i_0x91(); break;
+    case 0x92: i_0x92(); break;
+    case 0x93: i_0x93(); break;
+    case 0x94: i_0x94(); break;
+    case 0x95: i_0x95(); break;
+    case 0x96: i_0x96(); break;
+    case 0x97: i_0x97(); break;
+    case 0x98: i_0x98(); break;
+    case 0x99: i_0x99(); break;
+    case 0x9a: i_0x9a(); break;
+    case 0x9b: i_0x9b(); break;
+    case 0x9c: i_0x9c(); break;
+    case 0x9d: i_0x9d(); break;
+    case 0x9e: i_0x9e(); break;
+    case 0x9f: i_0x9f(); break;
+    case 0xa0: i_0xa0(); break;
+    case 0xa1: i_0xa1(); break;
+    case 0xa2: i_0xa2(); break;
+    case 0xa3: i_0xa3(); break;
+    case 0xa4: i_0xa4(); break;
+    case 0xa5: i_0xa5(); break;
+    case 0xa6: i_0xa6(); break;
+    case 0xa7: i_0xa7(); break;
+    case 0xa8: i_0xa8(); break;
+    case 0xa9: i_0xa9(); break;
+    case 0xaa: i_0xaa(); break;
+    case 0xab: i_0xab(); break;
+    case 0xac: i_0xac(); break;
+    case 0xad: i_0xad(); break;
+    case 0xae: i_0xae(); break;
+    case 0xaf: i_0xaf(); break;
+    case 0xb0: i_0xb0(); break;
+    case 0xb1: i_0xb1(); break;
+    case 0xb2: i_0xb2(); break;
+    case 0xb3: i_0xb3(); break;
+    case 0xb4: i_0xb4(); break;
+    case 0xb5: i_0xb5(); break;
+    case 0xb6: i_0xb6(); break;
+    case 0xb7: i_0xb7(); break;
+    case 0xb8: i_0xb8(); break;
+    case 0xb9: i_0xb9(); break;
+    case 0xba: i_0xba(); break;
+    case 0xbb: i_0xbb(); break;
+    case 0xbc: i_0xbc(); break;
+    case 0xbd: i_0xbd(); break;
+    case 0xbe: i_0xbe(); break;
+    case 0xbf: i_0xbf(); break;
+    case 0xc0: i_0xc0(); break;
+    case 0xc1: i_0xc1(); break;
+    case 0xc2: i_0xc2(m_currentOperand); break;
+    case 0xc3: i_0xc3(m_currentOperand); break;
+    case 0xc4: i_0xc4(m_currentOperand); break;
+    case 0xc5: i_0xc5(); break;
+    case 0xc6: i_0xc6(m_currentOperand); break;
+    case 0xc7: i_0xc7(); break;
+    case 0xc8: i_0xc8(); break;
+    case 0xc9: i_0xc9(); break;
+    case 0xca: i_0xca(m_currentOperand); break;
+    case 0xcb: IMPOSSIBLE(); break; // Fetched together with the prefixed opcode
+    case 0xcc: i_0xcc(m_currentOperand); break;
+    case 0xcd: i_0xcd(m_currentOperand); break;
+    case 0xce: i_0xce(m_currentOperand); break;
+    case 0xcf: i_0xcf(); break;
+    case 0xd0: i_0xd0(); break;
+    case 0xd1: i_0xd1(); break;
+    case 0xd2: i_0xd2(m_currentOperand); break;
+    case 0xd3: i_0xd3(); break;
+    case 0xd4: i_0xd4(m_currentOperand); break;
+    case 0xd5: i_0xd5(); break;
+    case 0xd6: i_0xd6(m_currentOperand); break;
+    case 0xd7: i_0xd7(); break;
+    case 0xd8: i_0xd8(); break;
+    case 0xd9: i_0xd9(); break;
+    case 0xda: i_0xda(m_currentOperand); break;
+    case 0xdb: i_0xdb(); break;
+    case 0xdc: i_0xdc(m_currentOperand); break;
+    case 0xdd: i_0xdd(); break;
+    case 0xde: i_0xde(m_currentOperand); break;
+    case 0xdf: i_0xdf(); break;
+    case 0xe0: i_0xe0(m_currentOperand); break;
+    case 0xe1: i_0xe1(); break;
+    case 0xe2: i_0xe2(); break;
+    case 0xe3: i_0xe3(); break;
+    case 0xe4: i_0xe4(); break;
+    case 0xe5: i_0xe5(); break;
+    case 0xe6: i_0xe6(m_currentOperand); break;
+    case 0xe7: i_0xe7(); break;
+    case 0xe8: i_0xe8(m_currentOperand); break;
+    case 0xe9: i_0xe9(); break;
+    case 0xea: i_0xea(m_currentOperand); break;
+    case 0xeb: i_0xeb(); break;
+    case 0xec: i_0xec(); break;
+    case 0xed: i_0xed(); break;
+    case 0xee: i_0xee(m_currentOperand); break;
+    case 0xef: i_0xef(); break;
+    case 0xf0: i_0xf0(m_currentOperand); break;
+    case 0xf1: i_0xf1(); break;
+    case 0xf2: i_0xf2(); break;
+    case 0xf3: i_0xf3(); break;
+    case 0xf4: i_0xf4(); break;
+    case 0xf5: i_0xf5(); break;
+    case 0xf6: i_0xf6(m_currentOperand); break;
+    case 0xf7: i_0xf7(); break;
+    case 0xf8: i_0xf8(m_currentOperand); break;
+    case 0xf9: i_0xf9(); break;
+    case 0xfa: i_0xfa(m_currentOperand); break;
+    case 0xfb: i_0xfb(); break;
+    case 0xfc: i_0xfc(); break;
+    case 0xfd: i_0xfd(); break;
+    case 0xfe: i_0xfe(m_currentOperand); break;
+    case 0xff: i_0xff(); break;
     }
+
+    const OpcodeInfo &info{opcodeTable[m_currentOpcode]};
+    return m_isBranchTaken ? info.branchCycles : info.cycles;
 }
 
-CPU::~CPU()
+int CPU::emulateCurrentPrefixedOpcode()
 {
-    delete m_registers;
+    (this->*prefixedOpcodeHandlers[m_currentOpcode])();
+    return prefixedOpcodeTable[m_currentOpcode].cycles;
 }
@@ -10,8 +10,14 @@
 #include "Memory.h"
 #include "Logger.h"
 #include "string_formatting.h"
+#include "fused_pairs.h"
 
-using opcode_t = uint32_t;
+#include <array>
+#include <bitset>
+#include <utility>
+#include <vector>
+
+using opcode_t = uint8_t;
 
 #define JUMP_VECTOR_00 0x00
 #define JUMP_VECTOR_08 0x08
@@ -25,56 +31,152 @@ using opcode_t = uint32_t;
 class CPU final
 {
 private:
-    Registers       *m_registers{nullptr};
+    Registers       m_registers;
     Memory          *m_memoryPtr{nullptr};
 
     int             m_opcodeSize{};
 
     opcode_t        m_currentOpcode{};
-
-    // After executing an instruction the PC is incremented.
-    // After a JMP-like opcode we should not increment it,
-    // because we need to be at the address we jumped to.
-    bool            m_wasJump{};
+    // The immediate value after the opcode, if any (the 16-bit ones are in the little endian order)
+    uint16_t        m_currentOperand{};
+
+    // The host memory of the 256-byte page the PC is in, so the opcodes are not read through Memory::get().
+    // NULL if the page is not plain memory.
+    const uint8_t   *m_fetchPagePtr{};
+    int             m_fetchPageI{-1};
+    // Memory::getPageMapVersion() when the pointer was got
+    unsigned        m_fetchPageMapVersion{};
+
+    // The address of the current opcode, the PC is already after it when it is executed
+    uint16_t        m_currentOpcodeAddr{};
+    // Set by the conditional jumps, calls and returns if the condition was met
+    bool            m_isBranchTaken{};
     // The IMA has to be set after the instruction following EI
     bool            m_wasEiInstruction{};
-
+    // The current opcode is after a 0xcb prefix, the two bytes are fetched and executed together
     bool            m_isPrefixedOpcode{};
 
-public:
-    CPU(Memory *memory);
-    ~CPU();
-
-    inline Registers* getRegisters()             { return m_registers; }
-    inline const Registers* getRegisters() const { return m_registers; }
-
+    // HALT was executed, no instructions are executed until an interrupt is requested
+    bool            m_isHalted{};
+    // HALT was executed with IME unset and an interrupt already requested,
+    // so the PC is not incremented after reading the next opcode
+    bool            m_isHaltBug{};
+    // STOP was executed, everything is stopped until a button is pressed
+    bool            m_isStopped{};
+
+    // The fused opcode pairs, indexed by the first opcode and then by the second
+    std::array<std::bitset<256>, 256> m_fusedPairs{};
+    // Set for the opcodes that are the first of a pair, so the others don't have to look at the next opcode
+    std::array<bool, 256> m_isFusedPairFirst{};
+    // Set by fetchOpcode() to the M-cycles of the pair (with the branch taken) if the current opcode
+    // and the one after it are a fused pair, otherwise 0
+    int             m_fusedPairCycles{};
+    // The second opcode of the fused pair and its operand
+    opcode_t        m_fusedOpcode{};
+    uint16_t        m_fusedOperand{};
+
+    // Reads the opcode and its operand at the PC and moves the PC after them
     void fetchOpcode();
-    inline opcode_t getCurrentOpcode() const     { return m_currentOpcode; }
-    inline void stepPC()                         { if (m_wasJump) return; m_registers->setPC(m_registers->getPC()+m_opcodeSize); }
-    inline int getCurrentOpcodeSize() const      { return m_opcodeSize; }
     /*
-     * Emulates the current opcode and returns the number of M-cycles it took.
-     *
-     * 1 M-cycle is 4 T-cycles!
+     * Emulates the current opcode and returns the number of M-cycles it took,
+     * the cycles are looked up in the opcode table.
      */
     int emulateCurrentOpcode();
     int emulateCurrentPrefixedOpcode();
 
-    inline bool isPrefixedOpcode() const { return m_isPrefixedOpcode; }
-
     void enableImaIfNeeded()
     {
         // If there was an EI instruction and it is not the current one,
         // so this is the instruction after the EI
-        if (m_wasEiInstruction && (m_currentOpcode >> 24 != 0xfb))
+        if (m_wasEiInstruction && (m_currentOpcode != 0xfb || m_isPrefixedOpcode))
         {
             enableInterrupts();
             m_wasEiInstruction = false;
         }
     }
 
+    /*
+     * Wakes up the CPU from HALT if an interrupt is requested,
+     * and calls the handler of the interrupt if the interrupts are enabled.
+     * Returns true if a handler was called.
+     */
     bool handleInterrupts();
 
+public:
+    CPU(Memory *memory);
+
+    inline Registers* getRegisters()             { return &m_registers; }
+    inline const Registers* getRegisters() const { return &m_registers; }
+
+    /*
+     * Executes the next instruction: calls the handler of a pending interrupt,
+     * then fetches the opcode, moves the PC after it and executes it.
+     * Returns the number of M-cycles it took, the hardware is emulated by the caller.
+     * A halted CPU does not execute anything until an interrupt is requested.
+     *
+     * 1 M-cycle is 4 T-cycles!
+     */
+    inline int step()
+    {
+        const int mCycles{fetchNext()};
+        return m_isHalted ? mCycles : mCycles+executeOpcode();
+    }
+
+    /*
+     * The two halves of step(), so the caller can decide to execute a fused pair instead.
+     * fetchNext() calls the handler of a pending interrupt and fetches the opcode (unless the CPU is halted),
+     * it returns the M-cycles of the interrupt dispatch. executeOpcode() executes the fetched opcode.
+     */
+    int fetchNext();
+    int executeOpcode();
+    /*
+     * Returns the M-cycles of the fused pair that starts with the fetched opcode, with the branch taken,
+     * 0 if it does not start one. Then executeFusedPair() can be called instead of executeOpcode().
+     */
+    inline int getFusedPairCycles() const        { return m_fusedPairCycles; }
+    // Executes the fetched opcode and the one after it, returns the M-cycles of both
+    int executeFusedPair();
+
+    inline opcode_t getCurrentOpcode() const     { return m_currentOpcode; }
+    inline uint16_t getCurrentOperand() const    { return m_currentOperand; }
+    inline uint16_t getCurrentOpcodeAddr() const { return m_currentOpcodeAddr; }
+    inline int getCurrentOpcodeSize() const      { return m_opcodeSize; }
+
+    inline bool isPrefixedOpcode() const { return m_isPrefixedOpcode; }
+    inline bool isHalted() const { return m_isHalted; }
+    inline bool isStopped() const { return m_isStopped; }
+    // Called when a button is pressed in STOP mode
+    inline void wakeUpFromStop() { m_isStopped = false; }
+
+    // Returns true if an enabled interrupt is requested, even if IME is unset
+    inline bool isInterruptRequested() const
+    {
+        return m_memoryPtr->getPendingInterrupts() != 0;
+    }
+    // Returns true if an interrupt handler would be called before the next opcode
+    inline bool isInterruptPending() const
+    {
+        return m_registers.getIme() && isInterruptRequested();
+    }
+
+    // Replaces the fused opcode pairs, only the ones in `defaultFusedPairs` (fused_pairs.h) can be fused
+    void setFusedPairs(const std::vector<FusedPair> &pairs);
+
+    // Passes the state to `stream`, see StateStream.h
+    template <class Stream>
+    void serializeState(Stream &stream)
+    {
+        m_registers.serializeState(stream);
+        stream.value(m_opcodeSize);
+        stream.value(m_currentOpcode);
+        stream.value(m_currentOperand);
+        stream.value(m_wasEiInstruction);
+        stream.value(m_isPrefixedOpcode);
+        stream.value(m_isHalted);
+        stream.value(m_isStopped);
+        stream.value(m_isHaltBug);
+    }
+
 private:
     //--------- instructions --------------
     // r8   - 8-bit register
@@ -94,6 +196,7 @@ private:
     using u3    =        uint8_t; // constant
     using cc    = Registers::cond;// condition (enum class)
     using vec   =        uint8_t; // address
+    using FlagOp = Registers::FlagOp;
 
     //=========================================================================
     /*
@@ -119,752 +222,608 @@ private:
     }
 
     // Z0H-
-    inline int incrementRegister8F(r8 reg)
+    inline void incrementRegister8F(r8 reg)
     {
-        m_registers->setHalfCarryFlag(wouldAddHalfCarry8(m_registers->get8(reg), 1));
-        m_registers->set8(reg, m_registers->get8(reg)+1);
-        m_registers->setZeroFlag(m_registers->get8(reg) == 0);
-        m_registers->unsetNegativeFlag();
-
-        return 1;
+        const u8 value{m_registers.get8(reg)};
+        m_registers.set8(reg, value+1);
+        m_registers.setFlagsLazily(FlagOp::Inc, value, m_registers.getCarryFlag(), value+1);
     }
 
     // Z1H-
-    inline int decrementRegister8F(r8 reg)
+    inline void decrementRegister8F(r8 reg)
     {
-        m_registers->setHalfCarryFlag(wouldSubHalfCarry8(m_registers->get8(reg), 1));
-        m_registers->set8(reg, m_registers->get8(reg)-1);
-        m_registers->setZeroFlag(m_registers->get8(reg) == 0);
-        m_registers->setNegativeFlag();
-
-        return 1;
+        const u8 value{m_registers.get8(reg)};
+        m_registers.set8(reg, value-1);
+        m_registers.setFlagsLazily(FlagOp::Dec, value, m_registers.getCarryFlag(), value-1);
     }
 
     // ----
-    inline int incrementRegister16(r16 reg)
+    inline void incrementRegister16(r16 reg)
     {
-        m_registers->set16(reg, m_registers->get16(reg)+1);
-
-        return 2;
+        m_registers.set16(reg, m_registers.get16(reg)+1);
     }
 
     // ----
-    inline int decrementRegister16(r16 reg)
+    inline void decrementRegister16(r16 reg)
     {
-        m_registers->set16(reg, m_registers->get16(reg)-1);
-
-        return 2;
+        m_registers.set16(reg, m_registers.get16(reg)-1);
     }
 
     // Z0HC
-    inline int addToARegF(u8 value)
+    inline void addToARegF(u8 value)
     {
-        m_registers->setHalfCarryFlag(wouldAddHalfCarry8(m_registers->getA(), value));
-        m_registers->setCarryFlag(wouldAddCarry8(m_registers->getA(), value));
-        m_registers->setA(m_registers->getA()+value);
-        m_registers->setZeroFlag(m_registers->getA() == 0);
-        m_registers->unsetNegativeFlag();
-
-        return 2;
+        const u8 result{(u8)(m_registers.getA()+value)};
+        m_registers.setFlagsLazily(FlagOp::Add, m_registers.getA(), value, result);
+        m_registers.setA(result);
     }
 
     // ----
-    inline int setRegister8(r8 reg, u8 value)
+    inline void setRegister8(r8 reg, u8 value)
     {
-        m_registers->set8(reg, value);
-
-        return 2;
+        m_registers.set8(reg, value);
     }
 
     // ----
-    inline int setRegister16(r16 reg, u16 value)
+    inline void setRegister16(r16 reg, u16 value)
     {
-        m_registers->set16(reg, value);
-
-        return 3;
+        m_registers.set16(reg, value);
     }
 
     // Z1HC
-    inline int subFromARegF(u8 value)
+    inline void subFromARegF(u8 value)
     {
-        m_registers->setHalfCarryFlag(wouldSubHalfCarry8(m_registers->getA(), value));
-        m_registers->setCarryFlag(wouldSubCarry8(m_registers->getA(), value));
-        m_registers->setA(m_registers->getA()-value);
-        m_registers->setZeroFlag(m_registers->getA() == 0);
-        m_registers->unsetNegativeFlag();
-
-        return 2;
+        const u8 result{(u8)(m_registers.getA()-value)};
+        m_registers.setFlagsLazily(FlagOp::Sub, m_registers.getA(), value, result);
+        m_registers.setA(result);
     }
 
     // -0HC
-    inline int addRegister16ToHLRegF(r16 src)
+    inline void addRegister16ToHLRegF(r16 src)
     {
-        m_registers->setHalfCarryFlag(wouldAddHalfCarry16(m_registers->getHL(), m_registers->get16(src)));
-        m_registers->setCarryFlag(wouldAddCarry16(m_registers->getHL(), m_registers->get16(src)));
-        m_registers->setHL(m_registers->getHL()+m_registers->get16(src));
-        m_registers->unsetNegativeFlag();
-
-        return 2;
+        m_registers.setHalfCarryFlag(wouldAddHalfCarry16(m_registers.getHL(), m_registers.get16(src)));
+        m_registers.setCarryFlag(wouldAddCarry16(m_registers.getHL(), m_registers.get16(src)));
+        m_registers.setHL(m_registers.getHL()+m_registers.get16(src));
+        m_registers.unsetNegativeFlag();
     }
 
     // ----
-    inline int setValueAtAddressInHLReg(u8 value)
+    inline void setValueAtAddressInHLReg(u8 value)
     {
-        m_memoryPtr->set(m_registers->getHL(), value);
-
-        return 3;
+        m_memoryPtr->set(m_registers.getHL(), value);
     }
 
     // ----
-    inline int setValueAtAddressInRegister16ToRegister8(r16 addr, r8 val)
+    inline void setValueAtAddressInRegister16ToRegister8(r16 addr, r8 val)
     {
-        m_memoryPtr->set(m_registers->get16(addr), m_registers->get8(val));
-
-        return 2;
+        m_memoryPtr->set(m_registers.get16(addr), m_registers.get8(val));
     }
 
     // ----
-    inline int setValueAtAddressToAReg(u16 addr)
+    inline void setValueAtAddressToAReg(u16 addr)
     {
-        m_memoryPtr->set(addr, m_registers->getA());
-
-        return 4;
+        m_memoryPtr->set(addr, m_registers.getA());
     }
 
     // ----
-    inline int setRegister8ToValueAtAddressInRegister16(r8 destination, r16 sourceAddressRegister)
+    inline void setRegister8ToValueAtAddressInRegister16(r8 destination, r16 sourceAddressRegister)
     {
-        m_registers->set8(destination, m_memoryPtr->get(m_registers->get16(sourceAddressRegister)));
-
-        return 2;
+        m_registers.set8(destination, m_memoryPtr->get(m_registers.get16(sourceAddressRegister)));
     }
 
     // ----
-    inline int setRegister8ToRegister8(r8 destination, r8 source)
+    inline void setRegister8ToRegister8(r8 destination, r8 source)
     {
-        m_registers->set8(destination, m_registers->get8(source));
-
-        return 1;
+        m_registers.set8(destination, m_registers.get8(source));
     }
 
     // Z0H-
-    inline int incrementValueAtAddressInHLReg()
+    inline void incrementValueAtAddressInHLReg()
     {
-        m_registers->setHalfCarryFlag(wouldAddHalfCarry8(m_memoryPtr->get(m_registers->getHL()), 1));
-        m_memoryPtr->set(m_registers->getHL(), m_memoryPtr->get(m_registers->getHL())+1);
-        m_registers->setZeroFlag(m_memoryPtr->get(m_registers->getHL()) == 0);
-        m_registers->unsetNegativeFlag();
-
-        return 3;
+        m_registers.setHalfCarryFlag(wouldAddHalfCarry8(m_memoryPtr->get(m_registers.getHL()), 1));
+        m_memoryPtr->set(m_registers.getHL(), m_memoryPtr->get(m_registers.getHL())+1);
+        m_registers.setZeroFlag(m_memoryPtr->get(m_registers.getHL()) == 0);
+        m_registers.unsetNegativeFlag();
     }
 
     // Z1H-
-    inline int decrementValueAtAddressInHLReg()
+    inline void decrementValueAtAddressInHLReg()
     {
-        m_registers->setHalfCarryFlag(wouldSubHalfCarry8(m_memoryPtr->get(m_registers->getHL()), 1));
-        m_memoryPtr->set(m_registers->getHL(), m_memoryPtr->get(m_registers->getHL())-1);
-        m_registers->setZeroFlag(m_memoryPtr->get(m_registers->getHL()) == 0);
-        m_registers->setNegativeFlag();
-
-        return 3;
+        m_registers.setHalfCarryFlag(wouldSubHalfCarry8(m_memoryPtr->get(m_registers.getHL()), 1));
+        m_memoryPtr->set(m_registers.getHL(), m_memoryPtr->get(m_registers.getHL())-1);
+        m_registers.setZeroFlag(m_memoryPtr->get(m_registers.getHL()) == 0);
+        m_registers.setNegativeFlag();
     }
 
     // Z0HC
-    inline int addRegister8ToARegF(r8 src)
+    inline void addRegister8ToARegF(r8 src)
     {
-        m_registers->setHalfCarryFlag(wouldAddHalfCarry8(m_registers->getA(), m_registers->get8(src)));
-        m_registers->setCarryFlag(wouldAddCarry8(m_registers->getA(), m_registers->get8(src)));
-        m_registers->setA(m_registers->getA()+m_registers->get8(src));
-        m_registers->setZeroFlag(m_registers->getA() == 0);
-        m_registers->unsetNegativeFlag();
-
-        return 1;
+        const u8 operand{m_registers.get8(src)};
+        const u8 result{(u8)(m_registers.getA()+operand)};
+        m_registers.setFlagsLazily(FlagOp::Add, m_registers.getA(), operand, result);
+        m_registers.setA(result);
     }
 
     // Z0HC
-    inline int addValueAtAddressInHLRegToARegF()
+    inline void addValueAtAddressInHLRegToARegF()
     {
-        auto value{m_memoryPtr->get(m_registers->getHL())};
-        m_registers->setHalfCarryFlag(wouldAddHalfCarry8(m_registers->getA(), value));
-        m_registers->setCarryFlag(wouldAddCarry8(m_registers->getA(), value));
-        m_registers->setA(m_registers->getA()+value);
-        m_registers->setZeroFlag(m_registers->getA() == 0);
-        m_registers->unsetNegativeFlag();
-
-        return 2;
+        const u8 operand{m_memoryPtr->get(m_registers.getHL())};
+        const u8 result{(u8)(m_registers.getA()+operand)};
+        m_registers.setFlagsLazily(FlagOp::Add, m_registers.getA(), operand, result);
+        m_registers.setA(result);
     }
 
     // Z0HC
-    inline int addRegister8AndCarryFlagToARegF(r8 src)
+    inline void addRegister8AndCarryFlagToARegF(r8 src)
     {
-        m_registers->setHalfCarryFlag(wouldAddHalfCarry8(m_registers->getA(), m_registers->get8(src)+m_registers->getCarryFlag()));
-        m_registers->setCarryFlag(wouldAddCarry8(m_registers->getA(), m_registers->get8(src)+m_registers->getCarryFlag()));
-        m_registers->setA(m_registers->getA()+m_registers->get8(src)+m_registers->getCarryFlag());
-        m_registers->setZeroFlag(m_registers->getA() == 0);
-        m_registers->unsetNegativeFlag();
-
-        return 2;
+        // The flags are computed from the operand plus the carry
+        const u8 operand{(u8)(m_registers.get8(src)+m_registers.getCarryFlag())};
+        const u8 result{(u8)(m_registers.getA()+operand)};
+        m_registers.setFlagsLazily(FlagOp::Add, m_registers.getA(), operand, result);
+        m_registers.setA(result);
     }
 
     // Z1HC
-    inline int subRegister8FromARegF(r8 src)
+    inline void subRegister8FromARegF(r8 src)
     {
-        m_registers->setHalfCarryFlag(wouldSubHalfCarry8(m_registers->getA(), m_registers->get8(src)));
-        m_registers->setCarryFlag(wouldSubCarry8(m_registers->getA(), m_registers->get8(src)));
-        m_registers->setA(m_registers->getA()-m_registers->get8(src));
-        m_registers->setZeroFlag(m_registers->getA() == 0);
-        m_registers->setNegativeFlag();
-
-        return 1;
+        const u8 operand{m_registers.get8(src)};
+        const u8 result{(u8)(m_registers.getA()-operand)};
+        m_registers.setFlagsLazily(FlagOp::Sub, m_registers.getA(), operand, result);
+        m_registers.setA(result);
     }
 
     // Z1HC
-    inline int subRegister8AndCarryFlagFromARegF(r8 src)
+    inline void subRegister8AndCarryFlagFromARegF(r8 src)
     {
-        m_registers->setHalfCarryFlag(wouldSubHalfCarry8(m_registers->getA(), m_registers->get8(src)+m_registers->getCarryFlag()));
-        m_registers->setCarryFlag(wouldSubCarry8(m_registers->getA(), m_registers->get8(src)+m_registers->getCarryFlag()));
-        m_registers->setA(m_registers->getA()-m_registers->get8(src)-m_registers->getCarryFlag());
-        m_registers->setZeroFlag(m_registers->getA() == 0);
-        m_registers->setNegativeFlag();
-
-        return 1;
+        // The flags are computed from the operand plus the carry
+        const u8 operand{(u8)(m_registers.get8(src)+m_registers.getCarryFlag())};
+        const u8 result{(u8)(m_registers.getA()-operand)};
+        m_registers.setFlagsLazily(FlagOp::Sub, m_registers.getA(), operand, result);
+        m_registers.setA(result);
     }
 
     // Z010
-    inline int andRegister8AndARegF(r8 src)
+    inline void andRegister8AndARegF(r8 src)
     {
-        m_registers->setA(m_registers->getA() & m_registers->get8(src));
-        m_registers->setZeroFlag(m_registers->getA() == 0);
-        m_registers->unsetNegativeFlag();
-        m_registers->setHalfCarryFlag();
-        m_registers->unsetCarryFlag();
-
-        return 1;
+        m_registers.setA(m_registers.getA() & m_registers.get8(src));
+        m_registers.setFlagsLazily(FlagOp::And, 0, 0, m_registers.getA());
     }
 
     // Z000
-    inline int xorRegister8AndARegF(r8 src)
+    inline void xorRegister8AndARegF(r8 src)
     {
-        m_registers->setA(m_registers->getA() ^ m_registers->get8(src));
-        m_registers->setZeroFlag(m_registers->getA() == 0);
-        m_registers->unsetNegativeFlag();
-        m_registers->unsetHalfCarryFlag();
-        m_registers->unsetCarryFlag();
-
-        return 1;
+        m_registers.setA(m_registers.getA() ^ m_registers.get8(src));
+        m_registers.setFlagsLazily(FlagOp::Or, 0, 0, m_registers.getA());
     }
 
     // Z000
-    inline int orRegister8AndARegF(r8 src)
+    inline void orRegister8AndARegF(r8 src)
     {
-        m_registers->setA(m_registers->getA() | m_registers->get8(src));
-        m_registers->setZeroFlag(m_registers->getA() == 0);
-        m_registers->unsetNegativeFlag();
-        m_registers->unsetHalfCarryFlag();
-        m_registers->unsetCarryFlag();
-
-        return 1;
+        m_registers.setA(m_registers.getA() | m_registers.get8(src));
+        m_registers.setFlagsLazily(FlagOp::Or, 0, 0, m_registers.getA());
     }
 
     // Z1HC
-    inline int cpARegAndRegister8F(r8 reg2)
+    inline void cpARegAndRegister8F(r8 reg2)
     {
-        m_registers->setZeroFlag(m_registers->getA() == m_registers->get8(reg2));
-        m_registers->setNegativeFlag();
-        m_registers->setHalfCarryFlag(wouldSubHalfCarry8(m_registers->getA(), m_registers->get8(reg2)));
-        m_registers->setCarryFlag(wouldSubCarry8(m_registers->getA(), m_registers->get8(reg2)));
-
-        return 1;
+        const u8 operand{m_registers.get8(reg2)};
+        const u8 result{(u8)(m_registers.getA()-operand)};
+        m_registers.setFlagsLazily(FlagOp::Sub, m_registers.getA(), operand, result);
     }
 
     // Z0HC
-    inline int addValueAndCarryFlagToARegF(u8 val)
+    inline void addValueAndCarryFlagToARegF(u8 val)
     {
-        m_registers->setHalfCarryFlag(wouldAddHalfCarry8(m_registers->getA(), val+m_registers->getCarryFlag()));
-        m_registers->setCarryFlag(wouldAddCarry8(m_registers->getA(), val+m_registers->getCarryFlag()));
-        m_registers->setA(m_registers->getA()+val+m_registers->getCarryFlag());
-        m_registers->setZeroFlag(m_registers->getA() == 0);
-        m_registers->unsetNegativeFlag();
-
-        return 2;
+        // The flags are computed from the operand plus the carry
+        const u8 operand{(u8)(val+m_registers.getCarryFlag())};
+        const u8 result{(u8)(m_registers.getA()+operand)};
+        m_registers.setFlagsLazily(FlagOp::Add, m_registers.getA(), operand, result);
+        m_registers.setA(result);
     }
 
     // Z1HC
-    inline int subValueAndCarryFlagFromARegF(u8 val)
+    inline void subValueAndCarryFlagFromARegF(u8 val)
     {
-        m_registers->setHalfCarryFlag(wouldSubHalfCarry8(m_registers->getA(), val+m_registers->getCarryFlag()));
-        m_registers->setCarryFlag(wouldSubCarry8(m_registers->getA(), val+m_registers->getCarryFlag()));
-        m_registers->setA(m_registers->getA()-val-m_registers->getCarryFlag());
-        m_registers->setZeroFlag(m_registers->getA() == 0);
-        m_registers->setNegativeFlag();
-
-        return 2;
+        // The flags are computed from the operand plus the carry
+        const u8 operand{(u8)(val+m_registers.getCarryFlag())};
+        const u8 result{(u8)(m_registers.getA()-operand)};
+        m_registers.setFlagsLazily(FlagOp::Sub, m_registers.getA(), operand, result);
+        m_registers.setA(result);
     }
 
     // Z010
-    inline int andValueAndARegF(u8 val)
+    inline void andValueAndARegF(u8 val)
     {
-        m_registers->setA(m_registers->getA() & val);
-        m_registers->setZeroFlag(m_registers->getA() == 0);
-        m_registers->unsetNegativeFlag();
-        m_registers->setHalfCarryFlag();
-        m_registers->unsetCarryFlag();
-
-        return 2;
+        m_registers.setA(m_registers.getA() & val);
+        m_registers.setFlagsLazily(FlagOp::And, 0, 0, m_registers.getA());
     }
 
     // Z000
-    inline int xorValueAndARegF(u8 val)
+    inline void xorValueAndARegF(u8 val)
     {
-        m_registers->setA(m_registers->getA() ^ val);
-        m_registers->setZeroFlag(m_registers->getA() == 0);
-        m_registers->unsetNegativeFlag();
-        m_registers->unsetHalfCarryFlag();
-        m_registers->unsetCarryFlag();
-
-        return 2;
+        m_registers.setA(m_registers.getA() ^ val);
+        m_registers.setFlagsLazily(FlagOp::Or, 0, 0, m_registers.getA());
     }
 
     // Z000
-    inline int orValueAndARegF(u8 val)
+    inline void orValueAndARegF(u8 val)
     {
-        m_registers->setA(m_registers->getA() | val);
-        m_registers->setZeroFlag(m_registers->getA() == 0);
-        m_registers->unsetNegativeFlag();
-        m_registers->unsetHalfCarryFlag();
-        m_registers->unsetCarryFlag();
-
-        return 2;
+        m_registers.setA(m_registers.getA() | val);
+        m_registers.setFlagsLazily(FlagOp::Or, 0, 0, m_registers.getA());
     }
 
     // Z1HC
-    inline int cpARegAndValue(u8 val)
+    inline void cpARegAndValue(u8 val)
     {
-        m_registers->setZeroFlag(m_registers->getA() == val);
-        m_registers->setNegativeFlag();
-        m_registers->setHalfCarryFlag(wouldSubHalfCarry8(m_registers->getA(), val));
-        m_registers->setCarryFlag(wouldSubCarry8(m_registers->getA(), val));
-
-        return 2;
+        const u8 result{(u8)(m_registers.getA()-val)};
+        m_registers.setFlagsLazily(FlagOp::Sub, m_registers.getA(), val, result);
     }
 
     // 000C
-    inline int rotateARegBitsLeftF()
+    inline void rotateARegBitsLeftF()
     {
-        m_registers->setCarryFlag(m_registers->getA() & 1);
-        m_registers->setA((m_registers->getA() << 1) | (m_registers->getA() >> 7));
-
-        m_registers->unsetZeroFlag();
-        m_registers->unsetNegativeFlag();
-        m_registers->unsetHalfCarryFlag();
+        m_registers.setCarryFlag(m_registers.getA() & 1);
+        m_registers.setA((m_registers.getA() << 1) | (m_registers.getA() >> 7));
 
-        return 1;
+        m_registers.unsetZeroFlag();
+        m_registers.unsetNegativeFlag();
+        m_registers.unsetHalfCarryFlag();
     }
 
     // 000C
-    inline int rotateARegBitsRightF()
+    inline void rotateARegBitsRightF()
     {
-        m_registers->setCarryFlag(m_registers->getA() & 1);
-        m_registers->setA((m_registers->getA() >> 1) | (m_registers->getA() << 7));
+        m_registers.setCarryFlag(m_registers.getA() & 1);
+        m_registers.setA((m_registers.getA() >> 1) | (m_registers.getA() << 7));
 
-        m_registers->unsetZeroFlag();
-        m_registers->unsetNegativeFlag();
-        m_registers->unsetHalfCarryFlag();
-
-        return 1;
+        m_registers.unsetZeroFlag();
+        m_registers.unsetNegativeFlag();
+        m_registers.unsetHalfCarryFlag();
     }
 
     // 000C
-    inline int rotateARegBitsLeftThroughCarryFlagF()
+    inline void rotateARegBitsLeftThroughCarryFlagF()
     {
-        auto regVal{m_registers->getA()};
-
-        m_registers->setA((regVal << 1) | m_registers->getCarryFlag());
-        m_registers->setCarryFlag(regVal >> 7);
+        auto regVal{m_registers.getA()};
 
-        m_registers->unsetZeroFlag();
-        m_registers->unsetNegativeFlag();
-        m_registers->unsetHalfCarryFlag();
+        m_registers.setA((regVal << 1) | m_registers.getCarryFlag());
+        m_registers.setCarryFlag(regVal >> 7);
 
-        return 1;
+        m_registers.unsetZeroFlag();
+        m_registers.unsetNegativeFlag();
+        m_registers.unsetHalfCarryFlag();
     }
 
     // 000C
-    inline int rotateARegBitsRightThroughCarryFlagF()
+    inline void rotateARegBitsRightThroughCarryFlagF()
     {
-        auto regVal{m_registers->getA()};
-
-        m_registers->setA((regVal >> 1) | (m_registers->getCarryFlag() << 7));
-        m_registers->setCarryFlag(regVal & 1);
+        auto regVal{m_registers.getA()};
 
-        m_registers->unsetZeroFlag();
-        m_registers->unsetNegativeFlag();
-        m_registers->unsetHalfCarryFlag();
+        m_registers.setA((regVal >> 1) | (m_registers.getCarryFlag() << 7));
+        m_registers.setCarryFlag(regVal & 1);
 
-        return 1;
+        m_registers.unsetZeroFlag();
+        m_registers.unsetNegativeFlag();
+        m_registers.unsetHalfCarryFlag();
     }
 
     // ----
-    inline int relativeJump(i8 offset)
+    inline void relativeJump(i8 offset)
     {
-        jpToAddress(m_registers->getPC()+offset);
-        m_wasJump = false;
-
-        return 3;
+        jpToAddress(m_registers.getPC()+offset);
     }
 
     // -11-
-    inline int complementARegF()
+    inline void complementARegF()
     {
-        m_registers->setA(~m_registers->getA());
-
-        m_registers->setNegativeFlag();
-        m_registers->setHalfCarryFlag();
+        m_registers.setA(~m_registers.getA());
 
-        return 1;
+        m_registers.setNegativeFlag();
+        m_registers.setHalfCarryFlag();
     }
 
     // ----
-    inline int jpToAddress(u16 addr)
+    inline void jpToAddress(u16 addr)
     {
-        m_registers->setPC(addr);
-        m_wasJump = true;
-
-        return 4;
+        m_registers.setPC(addr);
     }
 
     // ----
-    inline int jpToAddressInHLReg()
+    inline void jpToAddressInHLReg()
     {
-        jpToAddress(m_registers->getHL());
-
-        return 1;
+        jpToAddress(m_registers.getHL());
     }
 
     // ----
-    inline int jpIf(cc cond, u16 addr)
+    inline void jpIf(cc cond, u16 addr)
     {
-        if (m_registers->getCondition(cond))
+        if (m_registers.getCondition(cond))
         {
             jpToAddress(addr);
-
-            return 4;
+            m_isBranchTaken = true;
         }
-
-        return 3;
     }
 
     // ----
-    inline int relativeJumpIf(cc cond, i8 offset)
+    inline void relativeJumpIf(cc cond, i8 offset)
     {
-        if (m_registers->getCondition(cond))
+        if (m_registers.getCondition(cond))
         {
             relativeJump(offset);
-
-            return 3;
+            m_isBranchTaken = true;
         }
-
-        return 2;
     }
 
     // ----
-    inline int ret()
+    inline void ret()
     {
         jpToAddress(_pop16());
-
-        return 4;
     }
 
     // ----
-    inline int retIf(cc cond)
+    inline void retIf(cc cond)
     {
-        if (m_registers->getCondition(cond))
+        if (m_registers.getCondition(cond))
         {
             ret();
-
-            return 5;
+            m_isBranchTaken = true;
         }
-
-        return 2;
     }
 
     inline u16 _pop16()
     {
-        const u16 val = m_memoryPtr->get16(m_registers->getSP());
-        m_registers->incrementSP(2);
+        const u16 val = m_memoryPtr->get16(m_registers.getSP());
+        m_registers.incrementSP(2);
         return val;
     }
 
     // ----
-    inline int popIntoReg16(r16 reg)
+    inline void popIntoReg16(r16 reg)
     {
-        m_registers->set16(reg, _pop16());
-        return 3;
+        m_registers.set16(reg, _pop16());
     }
 
     // ----
     inline void _push16(u16 val)
     {
-        m_registers->decrementSP(2);
-        m_memoryPtr->set16(m_registers->getSP(), val);
+        m_registers.decrementSP(2);
+        m_memoryPtr->set16(m_registers.getSP(), val);
     }
 
     // ----
-    inline int pushRegister16(r16 reg)
+    inline void pushRegister16(r16 reg)
     {
-        _push16(m_registers->get16(reg));
-
-        return 4;
+        _push16(m_registers.get16(reg));
     }
 
     // ----
-    inline int call(u16 addr)
+    inline void call(u16 addr)
     {
-        _push16(m_registers->getPC()+m_opcodeSize);
+        // The PC is already at the next opcode
+        _push16(m_registers.getPC());
         jpToAddress(addr);
-
-        return 6;
     }
 
     // ----
-    inline int callIf(cc cond, u16 addr)
+    inline void callIf(cc cond, u16 addr)
     {
-        if (m_registers->getCondition(cond))
+        if (m_registers.getCondition(cond))
         {
             call(addr);
-
-            return 6;
+            m_isBranchTaken = true;
         }
-
-        return 3;
     }
 
     // ----
-    inline int callVector(vec addr)
+    inline void callVector(vec addr)
     {
         call(addr);
-
-        return 4;
     }
 
     // ----
-    inline int disableInterrupts()
+    inline void disableInterrupts()
     {
-        m_registers->unsetIme();
-
-        return 1;
+        m_registers.unsetIme();
     }
 
     // ----
     inline void enableInterrupts()
     {
-        m_registers->setIme();
+        m_registers.setIme();
     }
 
     // Z-0C
-    inline int decimalAdjustAccumulator()
+    inline void decimalAdjustAccumulator()
     {
-        if (m_registers->getNegativeFlag()) // After a substraction
+        if (m_registers.getNegativeFlag()) // After a substraction
         {
-            if (m_registers->getCarryFlag())
-                m_registers->setA(m_registers->getA() - 0x60);
-            if (m_registers->getHalfCarryFlag())
-                m_registers->setA(m_registers->getA() - 0x06);
+            if (m_registers.getCarryFlag())
+                m_registers.setA(m_registers.getA() - 0x60);
+            if (m_registers.getHalfCarryFlag())
+                m_registers.setA(m_registers.getA() - 0x06);
         }
         else // After an addition
         {
-            if (m_registers->getCarryFlag() || m_registers->getA() > 0x99)
+            if (m_registers.getCarryFlag() || m_registers.getA() > 0x99)
             {
-                m_registers->setA(m_registers->getA() + 0x60);
-                m_registers->setCarryFlag();
+                m_registers.setA(m_registers.getA() + 0x60);
+                m_registers.setCarryFlag();
             }
-            if (m_registers->getHalfCarryFlag() || (m_registers->getA() & 0x0f) > 0x09)
-                m_registers->setA(m_registers->getA() + 0x06);
+            if (m_registers.getHalfCarryFlag() || (m_registers.getA() & 0x0f) > 0x09)
+                m_registers.setA(m_registers.getA() + 0x06);
         }
 
-        m_registers->setZeroFlag(m_registers->getA() == 0);
-        m_registers->unsetHalfCarryFlag();
-
-        return 1;
+        m_registers.setZeroFlag(m_registers.getA() == 0);
+        m_registers.unsetHalfCarryFlag();
     }
 
-    inline int handlePrefix()
-    {
-        m_isPrefixedOpcode = true;
-
-        return 1;
-    }
-
-    // ------------------ prefixed ----------------
-
-    // Z00C
-    inline int rotateRegisterBitsLeftF(r8 reg)
-    {
-        m_registers->set8(reg, m_registers->get8(reg) << 1 | m_registers->get8(reg) >> 7);
-        m_registers->setZeroFlag(m_registers->get8(reg) == 0);
-        m_registers->unsetNegativeFlag();
-        m_registers->unsetHalfCarryFlag();
-        m_registers->setCarryFlag(m_registers->get8(reg) & 1);
-
-        return 2;
-    }
-
-    // Z00C
-    inline int rotateRegisterBitsRightF(r8 reg)
+    // ----
+    inline void stop()
     {
-        m_registers->set8(reg, m_registers->get8(reg) >> 1 | m_registers->get8(reg) << 7);
-        m_registers->setZeroFlag(m_registers->get8(reg) == 0);
-        m_registers->unsetNegativeFlag();
-        m_registers->unsetHalfCarryFlag();
-        m_registers->setCarryFlag(m_registers->get8(reg) & (1 << 7));
-
-        return 2;
+        // Writing anything to DIV resets it
+        m_memoryPtr->set(REGISTER_ADDR_DIV, 0, false);
+        m_isStopped = true;
     }
 
-    // Z00C
-    inline int rotateRegisterBitsLeftThroughCarryF(r8 reg)
+    // ----
+    inline void halt()
     {
-        auto regVal{m_registers->get8(reg)};
-
-        m_registers->set8(reg, (regVal << 1) | m_registers->getCarryFlag());
-        m_registers->setCarryFlag(regVal >> 7);
-        m_registers->setZeroFlag(m_registers->get8(reg) == 0);
-        m_registers->unsetNegativeFlag();
-        m_registers->unsetHalfCarryFlag();
-
-        return 2;
+        // With IME unset and an interrupt already requested, HALT exits immediately
+        // and the next opcode byte is read twice
+        if (!m_registers.getIme() && isInterruptRequested())
+            m_isHaltBug = true;
+        else
+            m_isHalted = true;
     }
 
-    // Z00C
-    inline int rotateRegisterBitsRightThroughCarryF(r8 reg)
-    {
-        auto regVal{m_registers->get8(reg)};
-
-        m_registers->set8(reg, regVal >> 1 | (m_registers->getCarryFlag() << 7));
-        m_registers->setCarryFlag(regVal & 1);
-        m_registers->unsetNegativeFlag();
-        m_registers->unsetHalfCarryFlag();
+    // ------------------ prefixed ----------------
 
-        return 2;
-    }
+    /*
+     * The opcodes after the 0xcb prefix are decoded from their bit fields:
+     * bits 7-6 select the group (shift/rotate, BIT, RES, SET),
+     * bits 5-3 the shift/rotate operation or the bit index,
+     * bits 2-0 the operand (B, C, D, E, H, L, (HL), A).
+     * `executePrefixedOpcode` is instantiated for every opcode, so the fields are decoded at compile time.
+     */
 
-    // Z00C
-    inline int shiftRegisterBitsLeftToCarryF(r8 reg)
+    template <int operandI>
+    inline uint8_t getPrefixedOperand() const
     {
-        auto origVal{m_registers->get8(reg)};
-
-        m_registers->setCarryFlag(origVal & (1 << 7));
-        m_registers->set8(reg, origVal << 1);
-        m_registers->setZeroFlag(m_registers->get8(reg) == 0);
-        m_registers->unsetNegativeFlag();
-        m_registers->unsetHalfCarryFlag();
-
-        return 2;
+        if constexpr (operandI == 6)
+            return m_memoryPtr->get(m_registers.getHL());
+        else
+            return m_registers.get8(prefixedOperandRegisters[operandI]);
     }
 
-    // Z00C
-    inline int shiftRegisterBitsRightToCarryF(r8 reg)
+    template <int operandI>
+    inline void setPrefixedOperand(uint8_t value)
     {
-        auto origVal{m_registers->get8(reg)};
-
-        // Note: MSB remains unchanged
-        m_registers->set8(reg, (origVal >> 1) | (origVal & (1 << 7)));
-        m_registers->setZeroFlag(m_registers->get8(reg) == 0);
-        m_registers->unsetNegativeFlag();
-        m_registers->unsetHalfCarryFlag();
-        m_registers->setCarryFlag(origVal & 1);
-
-        return 2;
+        if constexpr (operandI == 6)
+            m_memoryPtr->set(m_registers.getHL(), value);
+        else
+            m_registers.set8(prefixedOperandRegisters[operandI], value);
     }
 
-    // Z000
-    inline int swapRegisterNibblesF(r8 reg)
+    // Z00C, all the shifts and rotates set the flags the same way
+    template <int operationI>
+    inline uint8_t shiftOrRotateF(uint8_t value)
     {
-        auto origVal{m_registers->get8(reg)};
-
-        m_registers->set8(reg, (origVal << 4) | (origVal >> 4));
-        m_registers->setZeroFlag(origVal == 0);
-        m_registers->unsetNegativeFlag();
-        m_registers->unsetHalfCarryFlag();
-        m_registers->unsetCarryFlag();
+        uint8_t result{};
+        bool carry{};
+        if constexpr (operationI == 0) // RLC
+        {
+            result = value << 1 | value >> 7;
+            carry = value >> 7;
+        }
+        else if constexpr (operationI == 1) // RRC
+        {
+            result = value >> 1 | value << 7;
+            carry = value & 1;
+        }
+        else if constexpr (operationI == 2) // RL
+        {
+            result = value << 1 | m_registers.getCarryFlag();
+            carry = value >> 7;
+        }
+        else if constexpr (operationI == 3) // RR
+        {
+            result = value >> 1 | m_registers.getCarryFlag() << 7;
+            carry = value & 1;
+        }
+        else if constexpr (operationI == 4) // SLA
+        {
+            result = value << 1;
+            carry = value >> 7;
+        }
+        else if constexpr (operationI == 5) // SRA, the MSB remains unchanged
+        {
+            result = value >> 1 | (value & (1 << 7));
+            carry = value & 1;
+        }
+        else if constexpr (operationI == 6) // SWAP
+        {
+            result = value << 4 | value >> 4;
+        }
+        else // SRL
+        {
+            result = value >> 1;
+            carry = value & 1;
+        }
 
-        return 2;
+        m_registers.setF((result == 0 ? CPU_FLAG_BIT_ZERO : 0) | (carry ? CPU_FLAG_BIT_CARRY : 0));
+        return result;
     }
 
-    // Z00C
-    inline int shiftRightLogicRegisterF(r8 reg)
+    template <uint8_t opcode>
+    void executePrefixedOpcode()
     {
-        auto origVal{m_registers->get8(reg)};
-
-        m_registers->set8(reg, origVal >> 1);
-        m_registers->setZeroFlag(m_registers->get8(reg) == 0);
-        m_registers->unsetNegativeFlag();
-        m_registers->unsetHalfCarryFlag();
-        m_registers->setCarryFlag(origVal & 1);
+        constexpr int group{opcode >> 6};
+        constexpr int index{(opcode >> 3) & 7};
+        constexpr int operandI{opcode & 7};
 
-        return 2;
+        const uint8_t value{getPrefixedOperand<operandI>()};
+        if constexpr (group == 0)
+        {
+            setPrefixedOperand<operandI>(shiftOrRotateF<index>(value));
+        }
+        else if constexpr (group == 1) // BIT, Z01-
+        {
+            m_registers.setF((m_registers.getF() & CPU_FLAG_BIT_CARRY) | CPU_FLAG_BIT_HCARRY
+                    | ((value & (1 << index)) == 0 ? CPU_FLAG_BIT_ZERO : 0));
+        }
+        else if constexpr (group == 2) // RES
+        {
+            setPrefixedOperand<operandI>(value & ~(1 << index));
+        }
+        else // SET
+        {
+            setPrefixedOperand<operandI>(value | (1 << index));
+        }
     }
 
-    // Z01-
-    inline int checkBitOfRegisterF(u3 bit, r8 reg)
-    {
-        // Is bit unset?
-        m_registers->setZeroFlag((m_registers->get8(reg) & (1 << bit)) == 0);
-        m_registers->unsetNegativeFlag();
-        m_registers->setHalfCarryFlag();
-
-        return 2;
-    }
+    using PrefixedOpcodeHandler = void (CPU::*)();
 
-    // ----
-    inline int resetBitOfRegister(u3 bit, r8 reg)
+    template <size_t... opcodes>
+    static constexpr std::array<PrefixedOpcodeHandler, 256> makePrefixedOpcodeHandlers(std::index_sequence<opcodes...>)
     {
-        m_registers->set8(reg, m_registers->get8(reg) & ~(1 << bit));
-
-        return 2;
+        return {{&CPU::executePrefixedOpcode<opcodes>...}};
     }
 
-    // ----
-    inline int setBitOfRegister(u3 bit, r8 reg)
-    {
-        m_registers->set8(reg, m_registers->get8(reg) | (1 << bit));
-
-        return 2;
-    }
+    // (HL) is not a register, it is handled separately
+    static constexpr r8 prefixedOperandRegisters[8]{r8::B, r8::C, r8::D, r8::E, r8::H, r8::L, r8::A, r8::A};
+    // The handlers indexed by the opcode
+    static const std::array<PrefixedOpcodeHandler, 256> prefixedOpcodeHandlers;
 
     // 00HC
-    inline int setHlToValInMemRelToSp(i8 offs)
+    inline void setHlToValInMemRelToSp(i8 offs)
     {
-        setRegister16(r16::HL, m_registers->getSP()+offs);
-        m_registers->unsetZeroFlag();
-        m_registers->unsetNegativeFlag();
-        if (wouldAddCarry16(m_registers->getSP(), offs))
-            m_registers->setCarryFlag();
+        setRegister16(r16::HL, m_registers.getSP()+offs);
+        m_registers.unsetZeroFlag();
+        m_registers.unsetNegativeFlag();
+        if (wouldAddCarry16(m_registers.getSP(), offs))
+            m_registers.setCarryFlag();
         else
-            m_registers->unsetCarryFlag();
-        if (wouldAddHalfCarry16(m_registers->getSP(), offs))
-            m_registers->setHalfCarryFlag();
+            m_registers.unsetCarryFlag();
+        if (wouldAddHalfCarry16(m_registers.getSP(), offs))
+            m_registers.setHalfCarryFlag();
         else
-            m_registers->unsetHalfCarryFlag();
-        return 3;
+            m_registers.unsetHalfCarryFlag();
     }
     
     inline void ILLEGAL_INSTRUCTION(opcode_t opcode)
     {
         // The Z80-like processors do not crash the system when
         // encountering an illegal instruction, so just report it.
-        Logger::warning("Illegal instruction: " + toHexStr(opcode));
-
+        // This is only logged, as the CPU can run without a user interface.
         std::string message{
-                "Invalid opcode: " + toHexStr(opcode) + "\n" +
-                "PC: " + toHexStr(m_registers->getPC()) + "\n" +
-                "SP: " + toHexStr(m_registers->getSP()) + "\n" +
+                "Illegal instruction: " + toHexStr(opcode) + "\n" +
+                "PC: " + toHexStr(m_currentOpcodeAddr) + "\n" +
+                "SP: " + toHexStr(m_registers.getSP()) + "\n" +
                 "\n"};
 
         for (int i{-8}; i <= 8; ++i)
         {
             if (i == 0) message += ">";
-            message += toHexStr(m_memoryPtr->get(m_registers->getPC() + i), 2, false);
+            message += toHexStr(m_memoryPtr->get(m_currentOpcodeAddr + i), 2, false);
             if (i == 0) message += "<";
             if (i != 8) message += " ";
         }
@@ -873,529 +832,266 @@ private:
                 std::string("\n") +
                 "\nThis is probably a bug in the ROM or in the emulator";
 
-        SDL_ShowSimpleMessageBox(
-                SDL_MESSAGEBOX_WARNING,
-                "Invalid Opcode",
-                message.c_str(), nullptr);
+        Logger::warning(message);
     }
 
     //=========================================================================
 
-    inline int i_0x00()        { return 1; }
-    inline int i_0x01(u16 x)   { return setRegister16(r16::BC, x); }
-    inline int i_0x02()        { return setValueAtAddressInRegister16ToRegister8(r16::BC, r8::A); }
-    inline int i_0x03()        { return incrementRegister16(r16::BC); }
-    inline int i_0x04()        { return incrementRegister8F(r8::B); }
-    inline int i_0x05()        { return decrementRegister8F(r8::B); }
-    inline int i_0x06(u8 x)    { return setRegister8(r8::B, x); }
-    inline int i_0x07()        { return rotateARegBitsLeftF(); }
-    inline int i_0x08(u16 x)   { m_memoryPtr->set16(x, m_registers->getSP()); return 5; }
-    inline int i_0x09()        { return addRegister16ToHLRegF(r16::BC); }
-    inline int i_0x0a()        { return setRegister8ToValueAtAddressInRegister16(r8::A, r16::BC); }
-    inline int i_0x0b()        { return decrementRegister16(r16::BC); }
-    inline int i_0x0c()        { return incrementRegister8F(r8::C); }
-    inline int i_0x0d()        { return decrementRegister8F(r8::C); }
-    inline int i_0x0e(u8 x)    { return setRegister8(r8::C, x); }
-    inline int i_0x0f()        { return rotateARegBitsRightF(); }
-    inline int i_0x10()        { UNIMPLEMENTED(); return 1; }
-    inline int i_0x11(u16 x)   { return setRegister16(r16::DE, x); }
-    inline int i_0x12()        { return setValueAtAddressInRegister16ToRegister8(r16::DE, r8::A); }
-    inline int i_0x13()        { return incrementRegister16(r16::DE); }
-    inline int i_0x14()        { return incrementRegister8F(r8::D); }
-    inline int i_0x15()        { return decrementRegister8F(r8::D); }
-    inline int i_0x16(u8 x)    { return setRegister8(r8::D, x); }
-    inline int i_0x17()        { return rotateARegBitsLeftThroughCarryFlagF(); }
-    inline int i_0x18(i8 x)    { return relativeJump(x); }
-    inline int i_0x19()        { return addRegister16ToHLRegF(r16::DE); }
-    inline int i_0x1a()        { return setRegister8ToValueAtAddressInRegister16(r8::A, r16::DE); }
-    inline int i_0x1b()        { return decrementRegister16(r16::DE); }
-    inline int i_0x1c()        { return incrementRegister8F(r8::E); }
-    inline int i_0x1d()        { return decrementRegister8F(r8::E); }
-    inline int i_0x1e(u8 x)    { return setRegister8(r8::E, x); }
-    inline int i_0x1f()        { return rotateARegBitsRightThroughCarryFlagF(); }
-    inline int i_0x20(i8 x)    { return relativeJumpIf(cc::NZ, x); }
-    inline int i_0x21(u16 x)   { return setRegister16(r16::HL, x); }
-    inline int i_0x22()        { setValueAtAddressInHLReg(m_registers->getA()); incrementRegister16(r16::HL); return 2; }
-    inline int i_0x23()        { return incrementRegister16(r16::HL); }
-    inline int i_0x24()        { return incrementRegister8F(r8::H); }
-    inline int i_0x25()        { return decrementRegister8F(r8::H); }
-    inline int i_0x26(u8 x)    { return setRegister8(r8::H, x); }
-    inline int i_0x27()        { return decimalAdjustAccumulator(); }
-    inline int i_0x28(i8 x)    { return relativeJumpIf(cc::Z, x); }
-    inline int i_0x29()        { return addRegister16ToHLRegF(r16::HL); }
-    inline int i_0x2a()        { setRegister8ToValueAtAddressInRegister16(r8::A, r16::HL); incrementRegister16(r16::HL); return 2; }
-    inline int i_0x2b()        { return decrementRegister16(r16::HL); }
-    inline int i_0x2c()        { return incrementRegister8F(r8::L); }
-    inline int i_0x2d()        { return decrementRegister8F(r8::L); }
-    inline int i_0x2e(u8 x)    { return setRegister8(r8::L, x); }
-    inline int i_0x2f()        { return complementARegF(); }
-    inline int i_0x30(i8 x)    { return relativeJumpIf(cc::NC, x); }
-    inline int i_0x31(u16 x)   { return setRegister16(r16::SP, x); }
-    inline int i_0x32()        { setValueAtAddressInRegister16ToRegister8(r16::HL, r8::A); decrementRegister16(r16::HL); return 2; }
-    inline int i_0x33()        { return incrementRegister16(r16::SP); }
-    inline int i_0x34()        { return incrementValueAtAddressInHLReg(); }
-    inline int i_0x35()        { return decrementValueAtAddressInHLReg(); }
-    inline int i_0x36(u8 x)    { return setValueAtAddressInHLReg(x); }
-    inline int i_0x37()        { m_registers->unsetNegativeFlag(); m_registers->unsetHalfCarryFlag(); m_registers->setCarryFlag(); return 1; }
-    inline int i_0x38(i8 x)    { return relativeJumpIf(cc::C, x); }
-    inline int i_0x39()        { return addRegister16ToHLRegF(r16::SP); }
-    inline int i_0x3a()        { setRegister8ToValueAtAddressInRegister16(r8::A, r16::HL); decrementRegister16(r16::HL); return 2; }
-    inline int i_0x3b()        { return decrementRegister16(r16::SP); }
-    inline int i_0x3c()        { return incrementRegister8F(r8::A); }
-    inline int i_0x3d()        { return decrementRegister8F(r8::A); }
-    inline int i_0x3e(u8 x)    { return setRegister8(r8::A, x); }
-    inline int i_0x3f()        { m_registers->unsetNegativeFlag(); m_registers->unsetHalfCarryFlag(); m_registers->setCarryFlag(!m_registers->getCarryFlag()); return 1; }
-    inline int i_0x40()        { return setRegister8ToRegister8(r8::B, r8::B); }
-    inline int i_0x41()        { return setRegister8ToRegister8(r8::B, r8::C); }
-    inline int i_0x42()        { return setRegister8ToRegister8(r8::B, r8::D); }
-    inline int i_0x43()        { return setRegister8ToRegister8(r8::B, r8::E); }
-    inline int i_0x44()        { return setRegister8ToRegister8(r8::B, r8::H); }
-    inline int i_0x45()        { return setRegister8ToRegister8(r8::B, r8::L); }
-    inline int i_0x46()        { return setRegister8ToValueAtAddressInRegister16(r8::B, r16::HL); }
-    inline int i_0x47()        { return setRegister8ToRegister8(r8::B, r8::A); }
-    inline int i_0x48()        { return setRegister8ToRegister8(r8::C, r8::B); }
-    inline int i_0x49()        { return setRegister8ToRegister8(r8::C, r8::C); }
-    inline int i_0x4a()        { return setRegister8ToRegister8(r8::C, r8::D); }
-    inline int i_0x4b()        { return setRegister8ToRegister8(r8::C, r8::E); }
-    inline int i_0x4c()        { return setRegister8ToRegister8(r8::C, r8::H); }
-    inline int i_0x4d()        { return setRegister8ToRegister8(r8::C, r8::L); }
-    inline int i_0x4e()        { return setRegister8ToValueAtAddressInRegister16(r8::C, r16::HL); }
-    inline int i_0x4f()        { return setRegister8ToRegister8(r8::C, r8::A); }
-    inline int i_0x50()        { return setRegister8ToRegister8(r8::D, r8::B); }
-    inline int i_0x51()        { return setRegister8ToRegister8(r8::D, r8::C); }
-    inline int i_0x52()        { return setRegister8ToRegister8(r8::D, r8::D); }
-    inline int i_0x53()        { return setRegister8ToRegister8(r8::D, r8::E); }
-    inline int i_0x54()        { return setRegister8ToRegister8(r8::D, r8::H); }
-    inline int i_0x55()        { return setRegister8ToRegister8(r8::D, r8::L); }
-    inline int i_0x56()        { return setRegister8ToValueAtAddressInRegister16(r8::D, r16::HL); }
-    inline int i_0x57()        { return setRegister8ToRegister8(r8::D, r8::A); }
-    inline int i_0x58()        { return setRegister8ToRegister8(r8::E, r8::B); }
-    inline int i_0x59()        { return setRegister8ToRegister8(r8::E, r8::C); }
-    inline int i_0x5a()        { return setRegister8ToRegister8(r8::E, r8::D); }
-    inline int i_0x5b()        { return setRegister8ToRegister8(r8::E, r8::E); }
-    inline int i_0x5c()        { return setRegister8ToRegister8(r8::E, r8::H); }
-    inline int i_0x5d()        { return setRegister8ToRegister8(r8::E, r8::L); }
-    inline int i_0x5e()        { return setRegister8ToValueAtAddressInRegister16(r8::E, r16::HL); }
-    inline int i_0x5f()        { return setRegister8ToRegister8(r8::E, r8::A); }
-    inline int i_0x60()        { return setRegister8ToRegister8(r8::H, r8::B); }
-    inline int i_0x61()        { return setRegister8ToRegister8(r8::H, r8::C); }
-    inline int i_0x62()        { return setRegister8ToRegister8(r8::H, r8::D); }
-    inline int i_0x63()        { return setRegister8ToRegister8(r8::H, r8::E); }
-    inline int i_0x64()        { return setRegister8ToRegister8(r8::H, r8::H); }
-    inline int i_0x65()        { return setRegister8ToRegister8(r8::H, r8::L); }
-    inline int i_0x66()        { return setRegister8ToValueAtAddressInRegister16(r8::H, r16::HL); }
-    inline int i_0x67()        { return setRegister8ToRegister8(r8::H, r8::A); }
-    inline int i_0x68()        { return setRegister8ToRegister8(r8::L, r8::B); }
-    inline int i_0x69()        { return setRegister8ToRegister8(r8::L, r8::C); }
-    inline int i_0x6a()        { return setRegister8ToRegister8(r8::L, r8::D); }
-    inline int i_0x6b()        { return setRegister8ToRegister8(r8::L, r8::E); }
-    inline int i_0x6c()        { return setRegister8ToRegister8(r8::L, r8::H); }
-    inline int i_0x6d()        { return setRegister8ToRegister8(r8::L, r8::L); }
-    inline int i_0x6e()        { return setRegister8ToValueAtAddressInRegister16(r8::L, r16::HL); }
-    inline int i_0x6f()        { return setRegister8ToRegister8(r8::L, r8::A); }
-    inline int i_0x70()        { return setValueAtAddressInRegister16ToRegister8(r16::HL, r8::B); }
-    inline int i_0x71()        { return setValueAtAddressInRegister16ToRegister8(r16::HL, r8::C); }
-    inline int i_0x72()        { return setValueAtAddressInRegister16ToRegister8(r16::HL, r8::D); }
-    inline int i_0x73()        { return setValueAtAddressInRegister16ToRegister8(r16::HL, r8::E); }
-    inline int i_0x74()        { return setValueAtAddressInRegister16ToRegister8(r16::HL, r8::H); }
-    inline int i_0x75()        { return setValueAtAddressInRegister16ToRegister8(r16::HL, r8::L); }
-    inline int i_0x76()        { UNIMPLEMENTED(); return 1; }
-    inline int i_0x77()        { return setValueAtAddressInRegister16ToRegister8(r16::HL, r8::A); }
-    inline int i_0x78()        { return setRegister8ToRegister8(r8::A, r8::B); }
-    inline int i_0x79()        { return setRegister8ToRegister8(r8::A, r8::C); }
-    inline int i_0x7a()        { return setRegister8ToRegister8(r8::A, r8::D); }
-    inline int i_0x7b()        { return setRegister8ToRegister8(r8::A, r8::E); }
-    inline int i_0x7c()        { return setRegister8ToRegister8(r8::A, r8::H); }
-    inline int i_0x7d()        { return setRegister8ToRegister8(r8::A, r8::L); }
-    inline int i_0x7e()        { return setRegister8ToValueAtAddressInRegister16(r8::A, r16::HL); }
-    inline int i_0x7f()        { return setRegister8ToRegister8(r8::A, r8::A); }
-    inline int i_0x80()        { return addRegister8ToARegF(r8::B); }
-    inline int i_0x81()        { return addRegister8ToARegF(r8::C); }
-    inline int i_0x82()        { return addRegister8ToARegF(r8::D); }
-    inline int i_0x83()        { return addRegister8ToARegF(r8::E); }
-    inline int i_0x84()        { return addRegister8ToARegF(r8::H); }
-    inline int i_0x85()        { return addRegister8ToARegF(r8::L); }
-    inline int i_0x86()        { return addValueAtAddressInHLRegToARegF(); }
-    inline int i_0x87()        { return addRegister8ToARegF(r8::A); }
-    inline int i_0x88()        { return addRegister8AndCarryFlagToARegF(r8::B); }
-    inline int i_0x89()        { return addRegister8AndCarryFlagToARegF(r8::C); }
-    inline int i_0x8a()        { return addRegister8AndCarryFlagToARegF(r8::D); }
-    inline int i_0x8b()        { return addRegister8AndCarryFlagToARegF(r8::E); }
-    inline int i_0x8c()        { return addRegister8AndCarryFlagToARegF(r8::H); }
-    inline int i_0x8d()        { return addRegister8AndCarryFlagToARegF(r8::L); }
-    inline int i_0x8e()        { return addValueAndCarryFlagToARegF(m_memoryPtr->get(m_registers->getHL())); }
-    inline int i_0x8f()        { return addRegister8AndCarryFlagToARegF(r8::A); }
-    inline int i_0x90()        { return subRegister8FromARegF(r8::B); }
-    inline int i_0x91()        { return subRegister8FromARegF(r8::C); }
-    inline int i_0x92()        { return subRegister8FromARegF(r8::D); }
-    inline int i_0x93()        { return subRegister8FromARegF(r8::E); }
-    inline int i_0x94()        { return subRegister8FromARegF(r8::H); }
-    inline int i_0x95()        { return subRegister8FromARegF(r8::L); }
-    inline int i_0x96()        { return subFromARegF(m_memoryPtr->get(m_registers->getHL())); }
-    inline int i_0x97()        { return subRegister8FromARegF(r8::A); }
-    inline int i_0x98()        { return subRegister8AndCarryFlagFromARegF(r8::B); }
-    inline int i_0x99()        { return subRegister8AndCarryFlagFromARegF(r8::C); }
-    inline int i_0x9a()        { return subRegister8AndCarryFlagFromARegF(r8::D); }
-    inline int i_0x9b()        { return subRegister8AndCarryFlagFromARegF(r8::E); }
-    inline int i_0x9c()        { return subRegister8AndCarryFlagFromARegF(r8::H); }
-    inline int i_0x9d()        { return subRegister8AndCarryFlagFromARegF(r8::L); }
-    inline int i_0x9e()        { return subValueAndCarryFlagFromARegF(m_memoryPtr->get(m_registers->getHL())); }
-    inline int i_0x9f()        { return subRegister8AndCarryFlagFromARegF(r8::A); }
-    inline int i_0xa0()        { return andRegister8AndARegF(r8::B); }
-    inline int i_0xa1()        { return andRegister8AndARegF(r8::C); }
-    inline int i_0xa2()        { return andRegister8AndARegF(r8::D); }
-    inline int i_0xa3()        { return andRegister8AndARegF(r8::E); }
-    inline int i_0xa4()        { return andRegister8AndARegF(r8::H); }
-    inline int i_0xa5()        { return andRegister8AndARegF(r8::L); }
-    inline int i_0xa6()        { return andValueAndARegF(m_memoryPtr->get(m_registers->getHL())); }
-    inline int i_0xa7()        { return andRegister8AndARegF(r8::A); }
-    inline int i_0xa8()        { return xorRegister8AndARegF(r8::B); }
-    inline int i_0xa9()        { return xorRegister8AndARegF(r8::C); }
-    inline int i_0xaa()        { return xorRegister8AndARegF(r8::D); }
-    inline int i_0xab()        { return xorRegister8AndARegF(r8::E); }
-    inline int i_0xac()        { return xorRegister8AndARegF(r8::H); }
-    inline int i_0xad()        { return xorRegister8AndARegF(r8::L); }
-    inline int i_0xae()        { return xorValueAndARegF(m_memoryPtr->get(m_registers->getHL())); }
-    inline int i_0xaf()        { return xorRegister8AndARegF(r8::A); }
-    inline int i_0xb0()        { return orRegister8AndARegF(r8::B); }
-    inline int i_0xb1()        { return orRegister8AndARegF(r8::C); }
-    inline int i_0xb2()        { return orRegister8AndARegF(r8::D); }
-    inline int i_0xb3()        { return orRegister8AndARegF(r8::E); }
-    inline int i_0xb4()        { return orRegister8AndARegF(r8::H); }
-    inline int i_0xb5()        { return orRegister8AndARegF(r8::L); }
-    inline int i_0xb6()        { return orValueAndARegF(m_memoryPtr->get(m_registers->getHL()));}
-    inline int i_0xb7()        { return orRegister8AndARegF(r8::A); }
-    inline int i_0xb8()        { return cpARegAndRegister8F(r8::B); }
-    inline int i_0xb9()        { return cpARegAndRegister8F(r8::C); }
-    inline int i_0xba()        { return cpARegAndRegister8F(r8::D); }
-    inline int i_0xbb()        { return cpARegAndRegister8F(r8::E); }
-    inline int i_0xbc()        { return cpARegAndRegister8F(r8::H); }
-    inline int i_0xbd()        { return cpARegAndRegister8F(r8::L); }
-    inline int i_0xbe()        { return cpARegAndValue(m_memoryPtr->get(m_registers->getHL())); }
-    inline int i_0xbf()        { return cpARegAndRegister8F(r8::A); }
-    inline int i_0xc0()        { return retIf(cc::NZ); }
-    inline int i_0xc1()        { return popIntoReg16(r16::BC); }
-    inline int i_0xc2(u16 x)   { return jpIf(cc::NZ, x); }
-    inline int i_0xc3(u16 x)   { return jpToAddress(x); }
-    inline int i_0xc4(u16 x)   { return callIf(cc::NZ, x); }
-    inline int i_0xc5()        { return pushRegister16(r16::BC); }
-    inline int i_0xc6(u8 x)    { return addToARegF(x); }
-    inline int i_0xc7()        { return callVector(JUMP_VECTOR_00); }
-    inline int i_0xc8()        { return retIf(cc::Z); }
-    inline int i_0xc9()        { return ret(); }
-    inline int i_0xca(u16 x)   { return jpIf(cc::Z, x); }
-    inline int i_0xcb()        { return handlePrefix(); }
-    inline int i_0xcc(u16 x)   { return callIf(cc::Z, x); }
-    inline int i_0xcd(u16 x)   { return call(x); }
-    inline int i_0xce(u8 x)    { return addValueAndCarryFlagToARegF(x); }
-    inline int i_0xcf()        { return callVector(JUMP_VECTOR_08); }
-    inline int i_0xd0()        { return retIf(cc::NC); }
-    inline int i_0xd1()        { return popIntoReg16(r16::DE); }
-    inline int i_0xd2(u16 x)   { return jpIf(cc::NC, x); }
-    inline int i_0xd3()        { ILLEGAL_INSTRUCTION(0xd3); return 0; }
-    inline int i_0xd4(u16 x)   { return callIf(cc::NC, x); }
-    inline int i_0xd5()        { return pushRegister16(r16::DE); }
-    inline int i_0xd6(u8 x)    { return subFromARegF(x); }
-    inline int i_0xd7()        { return callVector(JUMP_VECTOR_10); }
-    inline int i_0xd8()        { return retIf(cc::C); }
-    inline int i_0xd9()        { enableInterrupts(); ret(); return 4; }
-    inline int i_0xda(u16 x)   { return jpIf(cc::C, x); }
-    inline int i_0xdb()        { ILLEGAL_INSTRUCTION(0xdb); return 0; }
-    inline int i_0xdc(u16 x)   { return callIf(cc::C, x); }
-    inline int i_0xdd()        { ILLEGAL_INSTRUCTION(0xdd); return 0; }
-    inline int i_0xde(u8 x)    { return subValueAndCarryFlagFromARegF(x); }
-    inline int i_0xdf()        { return callVector(JUMP_VECTOR_18); }
-    inline int i_0xe0(u8 x)    { setValueAtAddressToAReg(0xff00+x); return 3; }
-    inline int i_0xe1()        { return popIntoReg16(r16::HL); }
-    inline int i_0xe2()        { setValueAtAddressToAReg(0xff00+m_registers->getC()); return 2; }
-    inline int i_0xe3()        { ILLEGAL_INSTRUCTION(0xe3); return 0; }
-    inline int i_0xe4()        { ILLEGAL_INSTRUCTION(0xe4); return 0;}
-    inline int i_0xe5()        { return pushRegister16(r16::HL); }
-    inline int i_0xe6(u8 x)    { return andValueAndARegF(x); }
-    inline int i_0xe7()        { return callVector(JUMP_VECTOR_20); }
-    inline int i_0xe8(i8 x)    { m_registers->incrementSP(x); return 4; }
-    inline int i_0xe9()        { return jpToAddressInHLReg(); }
-    inline int i_0xea(u8 x)    { return setValueAtAddressToAReg(x); }
-    inline int i_0xeb()        { ILLEGAL_INSTRUCTION(0xeb); return 0; }
-    inline int i_0xec()        { ILLEGAL_INSTRUCTION(0xec); return 0; }
-    inline int i_0xed()        { ILLEGAL_INSTRUCTION(0xed); return 0;}
-    inline int i_0xee(u8 x)    { return xorValueAndARegF(x); }
-    inline int i_0xef()        { return callVector(JUMP_VECTOR_28); }
-    inline int i_0xf0(u8 x)    { setRegister8(r8::A, m_memoryPtr->get(0xff00+x)); return 3; }
-    inline int i_0xf1()        { return popIntoReg16(r16::AF); }
-    inline int i_0xf2()        { setRegister8(r8::A, m_memoryPtr->get(0xff00+m_registers->getC())); return 2; }
-    inline int i_0xf3()        { return disableInterrupts(); }
-    inline int i_0xf4()        { ILLEGAL_INSTRUCTION(0xf4); return 0; }
-    inline int i_0xf5()        { return pushRegister16(r16::AF); }
-    inline int i_0xf6(u8 x)    { return orValueAndARegF(x); }
-    inline int i_0xf7()        { return callVector(JUMP_VECTOR_30); }
-    inline int i_0xf8(i8 x)    { return setHlToValInMemRelToSp(x); }
-    inline int i_0xf9()        { m_registers->setSP(m_registers->getHL()); return 2; }
-    inline int i_0xfa(u8 x)    { return setRegister8(r8::A, x); }
-    inline int i_0xfb()        { m_wasEiInstruction = true; return 1; }
-    inline int i_0xfc()        { ILLEGAL_INSTRUCTION(0xfc); return 0; }
-    inline int i_0xfd()        { ILLEGAL_INSTRUCTION(0xfd); return 0; }
-    inline int i_0xfe(u8 x)    { return cpARegAndValue(x); }
-    inline int i_0xff()        { return callVector(JUMP_VECTOR_38); }
-
-    // -----------------------  PREFIXED OPCODES -------------------------------
-
-    int i_pref_0x00() { return rotateRegisterBitsLeftF(r8::B); }
-    int i_pref_0x01() { return rotateRegisterBitsLeftF(r8::C); }
-    int i_pref_0x02() { return rotateRegisterBitsLeftF(r8::D); }
-    int i_pref_0x03() { return rotateRegisterBitsLeftF(r8::E); }
-    int i_pref_0x04() { return rotateRegisterBitsLeftF(r8::H); }
-    int i_pref_0x05() { return rotateRegisterBitsLeftF(r8::L); }
-    int i_pref_0x06() { UNIMPLEMENTED(); return -1; }
-    int i_pref_0x07() { return rotateRegisterBitsLeftF(r8::A); }
-    int i_pref_0x08() { return rotateRegisterBitsRightF(r8::B); }
-    int i_pref_0x09() { return rotateRegisterBitsRightF(r8::C); }
-    int i_pref_0x0a() { return rotateRegisterBitsRightF(r8::D); }
-    int i_pref_0x0b() { return rotateRegisterBitsRightF(r8::E); }
-    int i_pref_0x0c() { return rotateRegisterBitsRightF(r8::H); }
-    int i_pref_0x0d() { return rotateRegisterBitsRightF(r8::L); }
-    int i_pref_0x0e() { UNIMPLEMENTED(); return -1; }
-    int i_pref_0x0f() { return rotateRegisterBitsRightF(r8::L); }
-    int i_pref_0x10() { return rotateRegisterBitsLeftThroughCarryF(r8::B); }
-    int i_pref_0x11() { return rotateRegisterBitsLeftThroughCarryF(r8::C); }
-    int i_pref_0x12() { return rotateRegisterBitsLeftThroughCarryF(r8::D); }
-    int i_pref_0x13() { return rotateRegisterBitsLeftThroughCarryF(r8::E); }
-    int i_pref_0x14() { return rotateRegisterBitsLeftThroughCarryF(r8::H); }
-    int i_pref_0x15() { return rotateRegisterBitsLeftThroughCarryF(r8::L); }
-    int i_pref_0x16() { UNIMPLEMENTED(); return -1; }
-    int i_pref_0x17() { return rotateRegisterBitsLeftThroughCarryF(r8::A); }
-    int i_pref_0x18() { return rotateRegisterBitsRightThroughCarryF(r8::B); }
-    int i_pref_0x19() { return rotateRegisterBitsRightThroughCarryF(r8::C); }
-    int i_pref_0x1a() { return rotateRegisterBitsRightThroughCarryF(r8::D); }
-    int i_pref_0x1b() { return rotateRegisterBitsRightThroughCarryF(r8::E); }
-    int i_pref_0x1c() { return rotateRegisterBitsRightThroughCarryF(r8::H); }
-    int i_pref_0x1d() { return rotateRegisterBitsRightThroughCarryF(r8::L); }
-    int i_pref_0x1e() { UNIMPLEMENTED(); return -1; }
-    int i_pref_0x1f() { return rotateRegisterBitsRightThroughCarryF(r8::A); }
-    int i_pref_0x20() { return shiftRegisterBitsLeftToCarryF(r8::B); }
-    int i_pref_0x21() { return shiftRegisterBitsLeftToCarryF(r8::C); }
-    int i_pref_0x22() { return shiftRegisterBitsLeftToCarryF(r8::D); }
-    int i_pref_0x23() { return shiftRegisterBitsLeftToCarryF(r8::E); }
-    int i_pref_0x24() { return shiftRegisterBitsLeftToCarryF(r8::H); }
-    int i_pref_0x25() { return shiftRegisterBitsLeftToCarryF(r8::L); }
-    int i_pref_0x26() { UNIMPLEMENTED(); return -1; }
-    int i_pref_0x27() { return shiftRegisterBitsLeftToCarryF(r8::A); }
-    int i_pref_0x28() { return shiftRegisterBitsRightToCarryF(r8::B); }
-    int i_pref_0x29() { return shiftRegisterBitsRightToCarryF(r8::C); }
-    int i_pref_0x2a() { return shiftRegisterBitsRightToCarryF(r8::D); }
-    int i_pref_0x2b() { return shiftRegisterBitsRightToCarryF(r8::E); }
-    int i_pref_0x2c() { return shiftRegisterBitsRightToCarryF(r8::H); }
-    int i_pref_0x2d() { return shiftRegisterBitsRightToCarryF(r8::L); }
-    int i_pref_0x2e() { UNIMPLEMENTED(); return -1; }
-    int i_pref_0x2f() { return shiftRegisterBitsRightToCarryF(r8::A); }
-    int i_pref_0x30() { return swapRegisterNibblesF(r8::B); }
-    int i_pref_0x31() { return swapRegisterNibblesF(r8::C); }
-    int i_pref_0x32() { return swapRegisterNibblesF(r8::D); }
-    int i_pref_0x33() { return swapRegisterNibblesF(r8::E); }
-    int i_pref_0x34() { return swapRegisterNibblesF(r8::H); }
-    int i_pref_0x35() { return swapRegisterNibblesF(r8::L); }
-    int i_pref_0x36() { UNIMPLEMENTED(); return -1; }
-    int i_pref_0x37() { return swapRegisterNibblesF(r8::A); }
-    int i_pref_0x38() { return shiftRightLogicRegisterF(r8::B); }
-    int i_pref_0x39() { return shiftRightLogicRegisterF(r8::C); }
-    int i_pref_0x3a() { return shiftRightLogicRegisterF(r8::D); }
-    int i_pref_0x3b() { return shiftRightLogicRegisterF(r8::E); }
-    int i_pref_0x3c() { return shiftRightLogicRegisterF(r8::H); }
-    int i_pref_0x3d() { return shiftRightLogicRegisterF(r8::L); }
-    int i_pref_0x3e() { UNIMPLEMENTED(); return -1; }
-    int i_pref_0x3f() { return shiftRightLogicRegisterF(r8::A); }
-    int i_pref_0x40() { return checkBitOfRegisterF(0, r8::B); }
-    int i_pref_0x41() { return checkBitOfRegisterF(0, r8::C); }
-    int i_pref_0x42() { return checkBitOfRegisterF(0, r8::D); }
-    int i_pref_0x43() { return checkBitOfRegisterF(0, r8::E); }
-    int i_pref_0x44() { return checkBitOfRegisterF(0, r8::H); }
-    int i_pref_0x45() { return checkBitOfRegisterF(0, r8::L); }
-    int i_pref_0x46() { UNIMPLEMENTED(); return -1; }
-    int i_pref_0x47() { return checkBitOfRegisterF(0, r8::A); }
-    int i_pref_0x48() { return checkBitOfRegisterF(1, r8::B); }
-    int i_pref_0x49() { return checkBitOfRegisterF(1, r8::C); }
-    int i_pref_0x4a() { return checkBitOfRegisterF(1, r8::D); }
-    int i_pref_0x4b() { return checkBitOfRegisterF(1, r8::E); }
-    int i_pref_0x4c() { return checkBitOfRegisterF(1, r8::H); }
-    int i_pref_0x4d() { return checkBitOfRegisterF(1, r8::L); }
-    int i_pref_0x4e() { UNIMPLEMENTED(); return -1; }
-    int i_pref_0x4f() { return checkBitOfRegisterF(1, r8::A); }
-    int i_pref_0x50() { return checkBitOfRegisterF(2, r8::B); }
-    int i_pref_0x51() { return checkBitOfRegisterF(2, r8::C); }
-    int i_pref_0x52() { return checkBitOfRegisterF(2, r8::D); }
-    int i_pref_0x53() { return checkBitOfRegisterF(2, r8::E); }
-    int i_pref_0x54() { return checkBitOfRegisterF(2, r8::H); }
-    int i_pref_0x55() { return checkBitOfRegisterF(2, r8::L); }
-    int i_pref_0x56() { UNIMPLEMENTED(); return -1; }
-    int i_pref_0x57() { return checkBitOfRegisterF(2, r8::A); }
-    int i_pref_0x58() { return checkBitOfRegisterF(3, r8::B); }
-    int i_pref_0x59() { return checkBitOfRegisterF(3, r8::C); }
-    int i_pref_0x5a() { return checkBitOfRegisterF(3, r8::D); }
-    int i_pref_0x5b() { return checkBitOfRegisterF(3, r8::E); }
-    int i_pref_0x5c() { return checkBitOfRegisterF(3, r8::H); }
-    int i_pref_0x5d() { return checkBitOfRegisterF(3, r8::L); }
-    int i_pref_0x5e() { UNIMPLEMENTED(); return -1; }
-    int i_pref_0x5f() { return checkBitOfRegisterF(3, r8::A); }
-    int i_pref_0x60() { return checkBitOfRegisterF(4, r8::B); }
-    int i_pref_0x61() { return checkBitOfRegisterF(4, r8::C); }
-    int i_pref_0x62() { return checkBitOfRegisterF(4, r8::D); }
-    int i_pref_0x63() { return checkBitOfRegisterF(4, r8::E); }
-    int i_pref_0x64() { return checkBitOfRegisterF(4, r8::H); }
-    int i_pref_0x65() { return checkBitOfRegisterF(4, r8::L); }
-    int i_pref_0x66() { UNIMPLEMENTED(); return -1; }
-    int i_pref_0x67() { return checkBitOfRegisterF(4, r8::A); }
-    int i_pref_0x68() { return checkBitOfRegisterF(5, r8::B); }
-    int i_pref_0x69() { return checkBitOfRegisterF(5, r8::C); }
-    int i_pref_0x6a() { return checkBitOfRegisterF(5, r8::D); }
-    int i_pref_0x6b() { return checkBitOfRegisterF(5, r8::E); }
-    int i_pref_0x6c() { return checkBitOfRegisterF(5, r8::H); }
-    int i_pref_0x6d() { return checkBitOfRegisterF(5, r8::L); }
-    int i_pref_0x6e() { UNIMPLEMENTED(); return -1; }
-    int i_pref_0x6f() { return checkBitOfRegisterF(5, r8::A); }
-    int i_pref_0x70() { return checkBitOfRegisterF(6, r8::B); }
-    int i_pref_0x71() { return checkBitOfRegisterF(6, r8::C); }
-    int i_pref_0x72() { return checkBitOfRegisterF(6, r8::D); }
-    int i_pref_0x73() { return checkBitOfRegisterF(6, r8::E); }
-    int i_pref_0x74() { return checkBitOfRegisterF(6, r8::H); }
-    int i_pref_0x75() { return checkBitOfRegisterF(6, r8::L); }
-    int i_pref_0x76() { UNIMPLEMENTED(); return -1; }
-    int i_pref_0x77() { return checkBitOfRegisterF(6, r8::A); }
-    int i_pref_0x78() { return checkBitOfRegisterF(7, r8::B); }
-    int i_pref_0x79() { return checkBitOfRegisterF(7, r8::C); }
-    int i_pref_0x7a() { return checkBitOfRegisterF(7, r8::D); }
-    int i_pref_0x7b() { return checkBitOfRegisterF(7, r8::E); }
-    int i_pref_0x7c() { return checkBitOfRegisterF(7, r8::H); }
-    int i_pref_0x7d() { return checkBitOfRegisterF(7, r8::L); }
-    int i_pref_0x7e() { UNIMPLEMENTED(); return -1; }
-    int i_pref_0x7f() { return checkBitOfRegisterF(7, r8::A); }
-    int i_pref_0x80() { return resetBitOfRegister(0, r8::B); }
-    int i_pref_0x81() { return resetBitOfRegister(0, r8::C); }
-    int i_pref_0x82() { return resetBitOfRegister(0, r8::D); }
-    int i_pref_0x83() { return resetBitOfRegister(0, r8::E); }
-    int i_pref_0x84() { return resetBitOfRegister(0, r8::H); }
-    int i_pref_0x85() { return resetBitOfRegister(0, r8::L); }
-    int i_pref_0x86() { UNIMPLEMENTED(); return -1; }
-    int i_pref_0x87() { return resetBitOfRegister(0, r8::A); }
-    int i_pref_0x88() { return resetBitOfRegister(1, r8::B); }
-    int i_pref_0x89() { return resetBitOfRegister(1, r8::C); }
-    int i_pref_0x8a() { return resetBitOfRegister(1, r8::D); }
-    int i_pref_0x8b() { return resetBitOfRegister(1, r8::E); }
-    int i_pref_0x8c() { return resetBitOfRegister(1, r8::H); }
-    int i_pref_0x8d() { return resetBitOfRegister(1, r8::L); }
-    int i_pref_0x8e() { UNIMPLEMENTED(); return -1; }
-    int i_pref_0x8f() { return resetBitOfRegister(1, r8::A); }
-    int i_pref_0x90() { return resetBitOfRegister(2, r8::B); }
-    int i_pref_0x91() { return resetBitOfRegister(2, r8::C); }
-    int i_pref_0x92() { return resetBitOfRegister(2, r8::D); }
-    int i_pref_0x93() { return resetBitOfRegister(2, r8::E); }
-    int i_pref_0x94() { return resetBitOfRegister(2, r8::H); }
-    int i_pref_0x95() { return resetBitOfRegister(2, r8::L); }
-    int i_pref_0x96() { UNIMPLEMENTED(); return -1; }
-    int i_pref_0x97() { return resetBitOfRegister(2, r8::A); }
-    int i_pref_0x98() { return resetBitOfRegister(3, r8::B); }
-    int i_pref_0x99() { return resetBitOfRegister(3, r8::C); }
-    int i_pref_0x9a() { return resetBitOfRegister(3, r8::D); }
-    int i_pref_0x9b() { return resetBitOfRegister(3, r8::E); }
-    int i_pref_0x9c() { return resetBitOfRegister(3, r8::H); }
-    int i_pref_0x9d() { return resetBitOfRegister(3, r8::L); }
-    int i_pref_0x9e() { UNIMPLEMENTED(); return -1; }
-    int i_pref_0x9f() { return resetBitOfRegister(3, r8::A); }
-    int i_pref_0xa0() { return resetBitOfRegister(4, r8::B); }
-    int i_pref_0xa1() { return resetBitOfRegister(4, r8::C); }
-    int i_pref_0xa2() { return resetBitOfRegister(4, r8::D); }
-    int i_pref_0xa3() { return resetBitOfRegister(4, r8::E); }
-    int i_pref_0xa4() { return resetBitOfRegister(4, r8::H); }
-    int i_pref_0xa5() { return resetBitOfRegister(4, r8::L); }
-    int i_pref_0xa6() { UNIMPLEMENTED(); return -1; }
-    int i_pref_0xa7() { return resetBitOfRegister(4, r8::A); }
-    int i_pref_0xa8() { return resetBitOfRegister(5, r8::B); }
-    int i_pref_0xa9() { return resetBitOfRegister(5, r8::C); }
-    int i_pref_0xaa() { return resetBitOfRegister(5, r8::D); }
-    int i_pref_0xab() { return resetBitOfRegister(5, r8::E); }
-    int i_pref_0xac() { return resetBitOfRegister(5, r8::H); }
-    int i_pref_0xad() { return resetBitOfRegister(5, r8::L); }
-    int i_pref_0xae() { UNIMPLEMENTED(); return -1; }
-    int i_pref_0xaf() { return resetBitOfRegister(5, r8::A); }
-    int i_pref_0xb0() { return resetBitOfRegister(6, r8::B); }
-    int i_pref_0xb1() { return resetBitOfRegister(6, r8::C); }
-    int i_pref_0xb2() { return resetBitOfRegister(6, r8::D); }
-    int i_pref_0xb3() { return resetBitOfRegister(6, r8::E); }
-    int i_pref_0xb4() { return resetBitOfRegister(6, r8::H); }
-    int i_pref_0xb5() { return resetBitOfRegister(6, r8::L); }
-    int i_pref_0xb6() { UNIMPLEMENTED(); return -1; }
-    int i_pref_0xb7() { return resetBitOfRegister(6, r8::A); }
-    int i_pref_0xb8() { return resetBitOfRegister(7, r8::B); }
-    int i_pref_0xb9() { return resetBitOfRegister(7, r8::C); }
-    int i_pref_0xba() { return resetBitOfRegister(7, r8::D); }
-    int i_pref_0xbb() { return resetBitOfRegister(7, r8::E); }
-    int i_pref_0xbc() { return resetBitOfRegister(7, r8::H); }
-    int i_pref_0xbd() { return resetBitOfRegister(7, r8::L); }
-    int i_pref_0xbe() { UNIMPLEMENTED(); return -1; }
-    int i_pref_0xbf() { return resetBitOfRegister(7, r8::A); }
-    int i_pref_0xc0() { return setBitOfRegister(0, r8::B); }
-    int i_pref_0xc1() { return setBitOfRegister(0, r8::C); }
-    int i_pref_0xc2() { return setBitOfRegister(0, r8::D); }
-    int i_pref_0xc3() { return setBitOfRegister(0, r8::E); }
-    int i_pref_0xc4() { return setBitOfRegister(0, r8::H); }
-    int i_pref_0xc5() { return setBitOfRegister(0, r8::L); }
-    int i_pref_0xc6() { UNIMPLEMENTED(); return -1; }
-    int i_pref_0xc7() { return setBitOfRegister(0, r8::A); }
-    int i_pref_0xc8() { return setBitOfRegister(1, r8::B); }
-    int i_pref_0xc9() { return setBitOfRegister(1, r8::C); }
-    int i_pref_0xca() { return setBitOfRegister(1, r8::D); }
-    int i_pref_0xcb() { return setBitOfRegister(1, r8::E); }
-    int i_pref_0xcc() { return setBitOfRegister(1, r8::H); }
-    int i_pref_0xcd() { return setBitOfRegister(1, r8::L); }
-    int i_pref_0xce() { UNIMPLEMENTED(); return -1; }
-    int i_pref_0xcf() { return setBitOfRegister(1, r8::A); }
-    int i_pref_0xd0() { return setBitOfRegister(2, r8::B); }
-    int i_pref_0xd1() { return setBitOfRegister(2, r8::C); }
-    int i_pref_0xd2() { return setBitOfRegister(2, r8::D); }
-    int i_pref_0xd3() { return setBitOfRegister(2, r8::E); }
-    int i_pref_0xd4() { return setBitOfRegister(2, r8::H); }
-    int i_pref_0xd5() { return setBitOfRegister(2, r8::L); }
-    int i_pref_0xd6() { UNIMPLEMENTED(); return -1; }
-    int i_pref_0xd7() { return setBitOfRegister(2, r8::A); }
-    int i_pref_0xd8() { return setBitOfRegister(3, r8::B); }
-    int i_pref_0xd9() { return setBitOfRegister(3, r8::C); }
-    int i_pref_0xda() { return setBitOfRegister(3, r8::D); }
-    int i_pref_0xdb() { return setBitOfRegister(3, r8::E); }
-    int i_pref_0xdc() { return setBitOfRegister(3, r8::H); }
-    int i_pref_0xdd() { return setBitOfRegister(3, r8::L); }
-    int i_pref_0xde() { UNIMPLEMENTED(); return -1; }
-    int i_pref_0xdf() { return setBitOfRegister(3, r8::A); }
-    int i_pref_0xe0() { return setBitOfRegister(4, r8::B); }
-    int i_pref_0xe1() { return setBitOfRegister(4, r8::C); }
-    int i_pref_0xe2() { return setBitOfRegister(4, r8::D); }
-    int i_pref_0xe3() { return setBitOfRegister(4, r8::E); }
-    int i_pref_0xe4() { return setBitOfRegister(4, r8::H); }
-    int i_pref_0xe5() { return setBitOfRegister(4, r8::L); }
-    int i_pref_0xe6() { UNIMPLEMENTED(); return -1; }
-    int i_pref_0xe7() { return setBitOfRegister(4, r8::A); }
-    int i_pref_0xe8() { return setBitOfRegister(5, r8::B); }
-    int i_pref_0xe9() { return setBitOfRegister(5, r8::C); }
-    int i_pref_0xea() { return setBitOfRegister(5, r8::D); }
-    int i_pref_0xeb() { return setBitOfRegister(5, r8::E); }
-    int i_pref_0xec() { return setBitOfRegister(5, r8::H); }
-    int i_pref_0xed() { return setBitOfRegister(5, r8::L); }
-    int i_pref_0xee() { UNIMPLEMENTED(); return -1; }
-    int i_pref_0xef() { return setBitOfRegister(5, r8::A); }
-    int i_pref_0xf0() { return setBitOfRegister(6, r8::B); }
-    int i_pref_0xf1() { return setBitOfRegister(6, r8::C); }
-    int i_pref_0xf2() { return setBitOfRegister(6, r8::D); }
-    int i_pref_0xf3() { return setBitOfRegister(6, r8::E); }
-    int i_pref_0xf4() { return setBitOfRegister(6, r8::H); }
-    int i_pref_0xf5() { return setBitOfRegister(6, r8::L); }
-    int i_pref_0xf6() { UNIMPLEMENTED(); return -1; }
-    int i_pref_0xf7() { return setBitOfRegister(6, r8::A); }
-    int i_pref_0xf8() { return setBitOfRegister(7, r8::B); }
-    int i_pref_0xf9() { return setBitOfRegister(7, r8::C); }
-    int i_pref_0xfa() { return setBitOfRegister(7, r8::D); }
-    int i_pref_0xfb() { return setBitOfRegister(7, r8::E); }
-    int i_pref_0xfc() { return setBitOfRegister(7, r8::H); }
-    int i_pref_0xfd() { return setBitOfRegister(7, r8::L); }
-    int i_pref_0xfe() { UNIMPLEMENTED(); return -1; }
-    int i_pref_0xff() { return setBitOfRegister(7, r8::A); }
+    inline void i_0x00()        { }
+    inline void i_0x01(u16 x)   { setRegister16(r16::BC, x); }
+    inline void i_0x02()        { setValueAtAddressInRegister16ToRegister8(r16::BC, r8::A); }
+    inline void i_0x03()        { incrementRegister16(r16::BC); }
+    inline void i_0x04()        { incrementRegister8F(r8::B); }
+    inline void i_0x05()        { decrementRegister8F(r8::B); }
+    inline void i_0x06(u8 x)    { setRegister8(r8::B, x); }
+    inline void i_0x07()        { rotateARegBitsLeftF(); }
+    inline void i_0x08(u16 x)   { m_memoryPtr->set16(x, m_registers.getSP()); }
+    inline void i_0x09()        { addRegister16ToHLRegF(r16::BC); }
+    inline void i_0x0a()        { setRegister8ToValueAtAddressInRegister16(r8::A, r16::BC); }
+    inline void i_0x0b()        { decrementRegister16(r16::BC); }
+    inline void i_0x0c()        { incrementRegister8F(r8::C); }
+    inline void i_0x0d()        { decrementRegister8F(r8::C); }
+    inline void i_0x0e(u8 x)    { setRegister8(r8::C, x); }
+    inline void i_0x0f()        { rotateARegBitsRightF(); }
+    inline void i_0x10()        { stop(); }
+    inline void i_0x11(u16 x)   { setRegister16(r16::DE, x); }
+    inline void i_0x12()        { setValueAtAddressInRegister16ToRegister8(r16::DE, r8::A); }
+    inline void i_0x13()        { incrementRegister16(r16::DE); }
+    inline void i_0x14()        { incrementRegister8F(r8::D); }
+    inline void i_0x15()        { decrementRegister8F(r8::D); }
+    inline void i_0x16(u8 x)    { setRegister8(r8::D, x); }
+    inline void i_0x17()        { rotateARegBitsLeftThroughCarryFlagF(); }
+    inline void i_0x18(i8 x)    { relativeJump(x); }
+    inline void i_0x19()        { addRegister16ToHLRegF(r16::DE); }
+    inline void i_0x1a()        { setRegister8ToValueAtAddressInRegister16(r8::A, r16::DE); }
+    inline void i_0x1b()        { decrementRegister16(r16::DE); }
+    inline void i_0x1c()        { incrementRegister8F(r8::E); }
+    inline void i_0x1d()        { decrementRegister8F(r8::E); }
+    inline void i_0x1e(u8 x)    { setRegister8(r8::E, x); }
+    inline void i_0x1f()        { rotateARegBitsRightThroughCarryFlagF(); }
+    inline void i_0x20(i8 x)    { relativeJumpIf(cc::NZ, x); }
+    inline void i_0x21(u16 x)   { setRegister16(r16::HL, x); }
+    inline void i_0x22()        { setValueAtAddressInHLReg(m_registers.getA()); incrementRegister16(r16::HL); }
+    inline void i_0x23()        { incrementRegister16(r16::HL); }
+    inline void i_0x24()        { incrementRegister8F(r8::H); }
+    inline void i_0x25()        { decrementRegister8F(r8::H); }
+    inline void i_0x26(u8 x)    { setRegister8(r8::H, x); }
+    inline void i_0x27()        { decimalAdjustAccumulator(); }
+    inline void i_0x28(i8 x)    { relativeJumpIf(cc::Z, x); }
+    inline void i_0x29()        { addRegister16ToHLRegF(r16::HL); }
+    inline void i_0x2a()        { setRegister8ToValueAtAddressInRegister16(r8::A, r16::HL); incrementRegister16(r16::HL); }
+    inline void i_0x2b()        { decrementRegister16(r16::HL); }
+    inline void i_0x2c()        { incrementRegister8F(r8::L); }
+    inline void i_0x2d()        { decrementRegister8F(r8::L); }
+    inline void i_0x2e(u8 x)    { setRegister8(r8::L, x); }
+    inline void i_0x2f()        { complementARegF(); }
+    inline void i_0x30(i8 x)    { relativeJumpIf(cc::NC, x); }
+    inline void i_0x31(u16 x)   { setRegister16(r16::SP, x); }
+    inline void i_0x32()        { setValueAtAddressInRegister16ToRegister8(r16::HL, r8::A); decrementRegister16(r16::HL); }
+    inline void i_0x33()        { incrementRegister16(r16::SP); }
+    inline void i_0x34()        { incrementValueAtAddressInHLReg(); }
+    inline void i_0x35()        { decrementValueAtAddressInHLReg(); }
+    inline void i_0x36(u8 x)    { setValueAtAddressInHLReg(x); }
+    inline void i_0x37()        { m_registers.unsetNegativeFlag(); m_registers.unsetHalfCarryFlag(); m_registers.setCarryFlag(); }
+    inline void i_0x38(i8 x)    { relativeJumpIf(cc::C, x); }
+    inline void i_0x39()        { addRegister16ToHLRegF(r16::SP); }
+    inline void i_0x3a()        { setRegister8ToValueAtAddressInRegister16(r8::A, r16::HL); decrementRegister16(r16::HL); }
+    inline void i_0x3b()        { decrementRegister16(r16::SP); }
+    inline void i_0x3c()        { incrementRegister8F(r8::A); }
+    inline void i_0x3d()        { decrementRegister8F(r8::A); }
+    inline void i_0x3e(u8 x)    { setRegister8(r8::A, x); }
+    inline void i_0x3f()        { m_registers.unsetNegativeFlag(); m_registers.unsetHalfCarryFlag(); m_registers.setCarryFlag(!m_registers.getCarryFlag()); }
+    inline void i_0x40()        { setRegister8ToRegister8(r8::B, r8::B); }
+    inline void i_0x41()        { setRegister8ToRegister8(r8::B, r8::C); }
+    inline void i_0x42()        { setRegister8ToRegister8(r8::B, r8::D); }
+    inline void i_0x43()        { setRegister8ToRegister8(r8::B, r8::E); }
+    inline void i_0x44()        { setRegister8ToRegister8(r8::B, r8::H); }
+    inline void i_0x45()        { setRegister8ToRegister8(r8::B, r8::L); }
+    inline void i_0x46()        { setRegister8ToValueAtAddressInRegister16(r8::B, r16::HL); }
+    inline void i_0x47()        { setRegister8ToRegister8(r8::B, r8::A); }
+    inline void i_0x48()        { setRegister8ToRegister8(r8::C, r8::B); }
+    inline void i_0x49()        { setRegister8ToRegister8(r8::C, r8::C); }
+    inline void i_0x4a()        { setRegister8ToRegister8(r8::C, r8::D); }
+    inline void i_0x4b()        { setRegister8ToRegister8(r8::C, r8::E); }
+    inline void i_0x4c()        { setRegister8ToRegister8(r8::C, r8::H); }
+    inline void i_0x4d()        { setRegister8ToRegister8(r8::C, r8::L); }
+    inline void i_0x4e()        { setRegister8ToValueAtAddressInRegister16(r8::C, r16::HL); }
+    inline void i_0x4f()        { setRegister8ToRegister8(r8::C, r8::A); }
+    inline void i_0x50()        { setRegister8ToRegister8(r8::D, r8::B); }
+    inline void i_0x51()        { setRegister8ToRegister8(r8::D, r8::C); }
+    inline void i_0x52()        { setRegister8ToRegister8(r8::D, r8::D); }
+    inline void i_0x53()        { setRegister8ToRegister8(r8::D, r8::E); }
+    inline void i_0x54()        { setRegister8ToRegister8(r8::D, r8::H); }
+    inline void i_0x55()        { setRegister8ToRegister8(r8::D, r8::L); }
+    inline void i_0x56()        { setRegister8ToValueAtAddressInRegister16(r8::D, r16::HL); }
+    inline void i_0x57()        { setRegister8ToRegister8(r8::D, r8::A); }
+    inline void i_0x58()        { setRegister8ToRegister8(r8::E, r8::B); }
+    inline void i_0x59()        { setRegister8ToRegister8(r8::E, r8::C); }
+    inline void i_0x5a()        { setRegister8ToRegister8(r8::E, r8::D); }
+    inline void i_0x5b()        { setRegister8ToRegister8(r8::E, r8::E); }
+    inline void i_0x5c()        { setRegister8ToRegister8(r8::E, r8::H); }
+    inline void i_0x5d()        { setRegister8ToRegister8(r8::E, r8::L); }
+    inline void i_0x5e()        { setRegister8ToValueAtAddressInRegister16(r8::E, r16::HL); }
+    inline void i_0x5f()        { setRegister8ToRegister8(r8::E, r8::A); }
+    inline void i_0x60()        { setRegister8ToRegister8(r8::H, r8::B); }
+    inline void i_0x61()        { setRegister8ToRegister8(r8::H, r8::C); }
+    inline void i_0x62()        { setRegister8ToRegister8(r8::H, r8::D); }
+    inline void i_0x63()        { setRegister8ToRegister8(r8::H, r8::E); }
+    inline void i_0x64()        { setRegister8ToRegister8(r8::H, r8::H); }
+    inline void i_0x65()        { setRegister8ToRegister8(r8::H, r8::L); }
+    inline void i_0x66()        { setRegister8ToValueAtAddressInRegister16(r8::H, r16::HL); }
+    inline void i_0x67()        { setRegister8ToRegister8(r8::H, r8::A); }
+    inline void i_0x68()        { setRegister8ToRegister8(r8::L, r8::B); }
+    inline void i_0x69()        { setRegister8ToRegister8(r8::L, r8::C); }
+    inline void i_0x6a()        { setRegister8ToRegister8(r8::L, r8::D); }
+    inline void i_0x6b()        { setRegister8ToRegister8(r8::L, r8::E); }
+    inline void i_0x6c()        { setRegister8ToRegister8(r8::L, r8::H); }
+    inline void i_0x6d()        { setRegister8ToRegister8(r8::L, r8::L); }
+    inline void i_0x6e()        { setRegister8ToValueAtAddressInRegister16(r8::L, r16::HL); }
+    inline void i_0x6f()        { setRegister8ToRegister8(r8::L, r8::A); }
+    inline void i_0x70()        { setValueAtAddressInRegister16ToRegister8(r16::HL, r8::B); }
+    inline void i_0x71()        { setValueAtAddressInRegister16ToRegister8(r16::HL, r8::C); }
+    inline void i_0x72()        { setValueAtAddressInRegister16ToRegister8(r16::HL, r8::D); }
+    inline void i_0x73()        { setValueAtAddressInRegister16ToRegister8(r16::HL, r8::E); }
+    inline void i_0x74()        { setValueAtAddressInRegister16ToRegister8(r16::HL, r8::H); }
+    inline void i_0x75()        { setValueAtAddressInRegister16ToRegister8(r16::HL, r8::L); }
+    inline void i_0x76()        { halt(); }
+    inline void i_0x77()        { setValueAtAddressInRegister16ToRegister8(r16::HL, r8::A); }
+    inline void i_0x78()        { setRegister8ToRegister8(r8::A, r8::B); }
+    inline void i_0x79()        { setRegister8ToRegister8(r8::A, r8::C); }
+    inline void i_0x7a()        { setRegister8ToRegister8(r8::A, r8::D); }
+    inline void i_0x7b()        { setRegister8ToRegister8(r8::A, r8::E); }
+    inline void i_0x7c()        { setRegister8ToRegister8(r8::A, r8::H); }
+    inline void i_0x7d()        { setRegister8ToRegister8(r8::A, r8::L); }
+    inline void i_0x7e()        { setRegister8ToValueAtAddressInRegister16(r8::A, r16::HL); }
+    inline void i_0x7f()        { setRegister8ToRegister8(r8::A, r8::A); }
+    inline void i_0x80()        { addRegister8ToARegF(r8::B); }
+    inline void i_0x81()        { addRegister8ToARegF(r8::C); }
+    inline void i_0x82()        { addRegister8ToARegF(r8::D); }
+    inline void i_0x83()        { addRegister8ToARegF(r8::E); }
+    inline void i_0x84()        { addRegister8ToARegF(r8::H); }
+    inline void i_0x85()        { addRegister8ToARegF(r8::L); }
+    inline void i_0x86()        { addValueAtAddressInHLRegToARegF(); }
+    inline void i_0x87()        { addRegister8ToARegF(r8::A); }
+    inline void i_0x88()        { addRegister8AndCarryFlagToARegF(r8::B); }
+    inline void i_0x89()        { addRegister8AndCarryFlagToARegF(r8::C); }
+    inline void i_0x8a()        { addRegister8AndCarryFlagToARegF(r8::D); }
+    inline void i_0x8b()        { addRegister8AndCarryFlagToARegF(r8::E); }
+    inline void i_0x8c()        { addRegister8AndCarryFlagToARegF(r8::H); }
+    inline void i_0x8d()        { addRegister8AndCarryFlagToARegF(r8::L); }
+    inline void i_0x8e()        { addValueAndCarryFlagToARegF(m_memoryPtr->get(m_registers.getHL())); }
+    inline void i_0x8f()        { addRegister8AndCarryFlagToARegF(r8::A); }
+    inline void i_0x90()        { subRegister8FromARegF(r8::B); }
+    inline void i_0x91()        { subRegister8FromARegF(r8::C); }
+    inline void i_0x92()        { subRegister8FromARegF(r8::D); }
+    inline void i_0x93()        { subRegister8FromARegF(r8::E); }
+    inline void i_0x94()        { subRegister8FromARegF(r8::H); }
+    inline void i_0x95()        { subRegister8FromARegF(r8::L); }
+    inline void i_0x96()        { subFromARegF(m_memoryPtr->get(m_registers.getHL())); }
+    inline void i_0x97()        { subRegister8FromARegF(r8::A); }
+    inline void i_0x98()        { subRegister8AndCarryFlagFromARegF(r8::B); }
+    inline void i_0x99()        { subRegister8AndCarryFlagFromARegF(r8::C); }
+    inline void i_0x9a()        { subRegister8AndCarryFlagFromARegF(r8::D); }
+    inline void i_0x9b()        { subRegister8AndCarryFlagFromARegF(r8::E); }
+    inline void i_0x9c()        { subRegister8AndCarryFlagFromARegF(r8::H); }
+    inline void i_0x9d()        { subRegister8AndCarryFlagFromARegF(r8::L); }
+    inline void i_0x9e()        { subValueAndCarryFlagFromARegF(m_memoryPtr->get(m_registers.getHL())); }
+    inline void i_0x9f()        { subRegister8AndCarryFlagFromARegF(r8::A); }
+    inline void i_0xa0()        { andRegister8AndARegF(r8::B); }
+    inline void i_0xa1()        { andRegister8AndARegF(r8::C); }
+    inline void i_0xa2()        { andRegister8AndARegF(r8::D); }
+    inline void i_0xa3()        { andRegister8AndARegF(r8::E); }
+    inline void i_0xa4()        { andRegister8AndARegF(r8::H); }
+    inline void i_0xa5()        { andRegister8AndARegF(r8::L); }
+    inline void i_0xa6()        { andValueAndARegF(m_memoryPtr->get(m_registers.getHL())); }
+    inline void i_0xa7()        { andRegister8AndARegF(r8::A); }
+    inline void i_0xa8()        { xorRegister8AndARegF(r8::B); }
+    inline void i_0xa9()        { xorRegister8AndARegF(r8::C); }
+    inline void i_0xaa()        { xorRegister8AndARegF(r8::D); }
+    inline void i_0xab()        { xorRegister8AndARegF(r8::E); }
+    inline void i_0xac()        { xorRegister8AndARegF(r8::H); }
+    inline void i_0xad()        { xorRegister8AndARegF(r8::L); }
+    inline void i_0xae()        { xorValueAndARegF(m_memoryPtr->get(m_registers.getHL())); }
+    inline void i_0xaf()        { xorRegister8AndARegF(r8::A); }
+    inline void i_0xb0()        { orRegister8AndARegF(r8::B); }
+    inline void i_0xb1()        { orRegister8AndARegF(r8::C); }
+    inline void i_0xb2()        { orRegister8AndARegF(r8::D); }
+    inline void i_0xb3()        { orRegister8AndARegF(r8::E); }
+    inline void i_0xb4()        { orRegister8AndARegF(r8::H); }
+    inline void i_0xb5()        { orRegister8AndARegF(r8::L); }
+    inline void i_0xb6()        { orValueAndARegF(m_memoryPtr->get(m_registers.getHL())); }
+    inline void i_0xb7()        { orRegister8AndARegF(r8::A); }
+    inline void i_0xb8()        { cpARegAndRegister8F(r8::B); }
+    inline void i_0xb9()        { cpARegAndRegister8F(r8::C); }
+    inline void i_0xba()        { cpARegAndRegister8F(r8::D); }
+    inline void i_0xbb()        { cpARegAndRegister8F(r8::E); }
+    inline void i_0xbc()        { cpARegAndRegister8F(r8::H); }
+    inline void i_0xbd()        { cpARegAndRegister8F(r8::L); }
+    inline void i_0xbe()        { cpARegAndValue(m_memoryPtr->get(m_registers.getHL())); }
+    inline void i_0xbf()        { cpARegAndRegister8F(r8::A); }
+    inline void i_0xc0()        { retIf(cc::NZ); }
+    inline void i_0xc1()        { popIntoReg16(r16::BC); }
+    inline void i_0xc2(u16 x)   { jpIf(cc::NZ, x); }
+    inline void i_0xc3(u16 x)   { jpToAddress(x); }
+    inline void i_0xc4(u16 x)   { callIf(cc::NZ, x); }
+    inline void i_0xc5()        { pushRegister16(r16::BC); }
+    inline void i_0xc6(u8 x)    { addToARegF(x); }
+    inline void i_0xc7()        { callVector(JUMP_VECTOR_00); }
+    inline void i_0xc8()        { retIf(cc::Z); }
+    inline void i_0xc9()        { ret(); }
+    inline void i_0xca(u16 x)   { jpIf(cc::Z, x); }
+    inline void i_0xcc(u16 x)   { callIf(cc::Z, x); }
+    inline void i_0xcd(u16 x)   { call(x); }
+    inline void i_0xce(u8 x)    { addValueAndCarryFlagToARegF(x); }
+    inline void i_0xcf()        { callVector(JUMP_VECTOR_08); }
+    inline void i_0xd0()        { retIf(cc::NC); }
+    inline void i_0xd1()        { popIntoReg16(r16::DE); }
+    inline void i_0xd2(u16 x)   { jpIf(cc::NC, x); }
+    inline void i_0xd3()        { ILLEGAL_INSTRUCTION(0xd3); }
+    inline void i_0xd4(u16 x)   { callIf(cc::NC, x); }
+    inline void i_0xd5()        { pushRegister16(r16::DE); }
+    inline void i_0xd6(u8 x)    { subFromARegF(x); }
+    inline void i_0xd7()        { callVector(JUMP_VECTOR_10); }
+    inline void i_0xd8()        { retIf(cc::C); }
+    inline void i_0xd9()        { enableInterrupts(); ret(); }
+    inline void i_0xda(u16 x)   { jpIf(cc::C, x); }
+    inline void i_0xdb()        { ILLEGAL_INSTRUCTION(0xdb); }
+    inline void i_0xdc(u16 x)   { callIf(cc::C, x); }
+    inline void i_0xdd()        { ILLEGAL_INSTRUCTION(0xdd); }
+    inline void i_0xde(u8 x)    { subValueAndCarryFlagFromARegF(x); }
+    inline void i_0xdf()        { callVector(JUMP_VECTOR_18); }
+    inline void i_0xe0(u8 x)    { setValueAtAddressToAReg(0xff00+x); }
+    inline void i_0xe1()        { popIntoReg16(r16::HL); }
+    inline void i_0xe2()        { setValueAtAddressToAReg(0xff00+m_registers.getC()); }
+    inline void i_0xe3()        { ILLEGAL_INSTRUCTION(0xe3); }
+    inline void i_0xe4()        { ILLEGAL_INSTRUCTION(0xe4); }
+    inline void i_0xe5()        { pushRegister16(r16::HL); }
+    inline void i_0xe6(u8 x)    { andValueAndARegF(x); }
+    inline void i_0xe7()        { callVector(JUMP_VECTOR_20); }
+    inline void i_0xe8(i8 x)    { m_registers.incrementSP(x); }
+    inline void i_0xe9()        { jpToAddressInHLReg(); }
+    inline void i_0xea(u16 x)   { setValueAtAddressToAReg(x); }
+    inline void i_0xeb()        { ILLEGAL_INSTRUCTION(0xeb); }
+    inline void i_0xec()        { ILLEGAL_INSTRUCTION(0xec); }
+    inline void i_0xed()        { ILLEGAL_INSTRUCTION(0xed); }
+    inline void i_0xee(u8 x)    { xorValueAndARegF(x); }
+    inline void i_0xef()        { callVector(JUMP_VECTOR_28); }
+    inline void i_0xf0(u8 x)    { setRegister8(r8::A, m_memoryPtr->get(0xff00+x)); }
+    inline void i_0xf1()        { popIntoReg16(r16::AF); }
+    inline void i_0xf2()        { setRegister8(r8::A, m_memoryPtr->get(0xff00+m_registers.getC())); }
+    inline void i_0xf3()        { disableInterrupts(); }
+    inline void i_0xf4()        { ILLEGAL_INSTRUCTION(0xf4); }
+    inline void i_0xf5()        { pushRegister16(r16::AF); }
+    inline void i_0xf6(u8 x)    { orValueAndARegF(x); }
+    inline void i_0xf7()        { callVector(JUMP_VECTOR_30); }
+    inline void i_0xf8(i8 x)    { setHlToValInMemRelToSp(x); }
+    inline void i_0xf9()        { m_registers.setSP(m_registers.getHL()); }
+    inline void i_0xfa(u16 x)   { setRegister8(r8::A, m_memoryPtr->get(x)); }
+    inline void i_0xfb()        { m_wasEiInstruction = true; }
+    inline void i_0xfc()        { ILLEGAL_INSTRUCTION(0xfc); }
+    inline void i_0xfd()        { ILLEGAL_INSTRUCTION(0xfd); }
+    inline void i_0xfe(u8 x)    { cpARegAndValue(x); }
+    inline void i_0xff()        { callVector(JUMP_VECTOR_38); }
 };
 
 
@@ -3,6 +3,7 @@
 #include <iomanip>
 #include <iostream>
 #include <cstring>
+#include <iterator>
 #include "string_formatting.h"
 
 //#define CARTRIDGE_READER_NO_COPY_CHECK
@@ -10,38 +11,43 @@
 CartridgeReader::CartridgeReader(const std::string &filename)
     : m_filename{filename}
 {
-    m_romFile.open(m_filename, std::ios::binary);
+    std::ifstream romFile{m_filename, std::ios::binary};
 
-    if (m_romFile.fail() || !m_romFile.is_open())
+    if (romFile.fail() || !romFile.is_open())
         Logger::fatal("Failed to open ROM file: " + m_filename + "\nReason: " + std::strerror(errno));
     else
         Logger::info("Opened ROM file");
 
+    m_romData.assign(std::istreambuf_iterator<char>{romFile}, std::istreambuf_iterator<char>{});
+
+    initCartridgeInfo();
+}
+
+CartridgeReader::CartridgeReader(const uint8_t *romData, size_t romSize)
+    : m_filename{"<memory>"}, m_romData{romData, romData+romSize}
+{
     initCartridgeInfo();
 }
 
 void CartridgeReader::initCartridgeInfo()
 {
-    if (!m_romFile.is_open())
-        Logger::fatal("Cartridge is not opened!");
+    // The header ends at 0x014f
+    if (m_romData.size() < 0x0150)
+        Logger::fatal("ROM is too small: " + m_filename);
 
     Logger::info("Reading cartridge info");
 
 
     // Read the title
-    m_romFile.seekg(0x0134, std::ios::beg);
-    m_romFile.read(m_cartridgeInfo.title, 16);
+    std::memcpy(m_cartridgeInfo.title, m_romData.data()+0x0134, 16);
 
 
     // Read the cartridge type
-    m_romFile.seekg(0x0147, std::ios::beg);
-    m_romFile.read(reinterpret_cast<char*>(&m_cartridgeInfo.MBCType), 1);
+    m_cartridgeInfo.MBCType = m_romData[0x0147];
 
 
     // Read the ROM size
-    m_romFile.seekg(0x0148, std::ios::beg);
-    uint8_t romSizeCode{};
-    m_romFile.read(reinterpret_cast<char*>(&romSizeCode), 1);
+    const uint8_t romSizeCode{m_romData[0x0148]};
     Logger::info("ROM size code: " + toHexStr(romSizeCode));
     switch (romSizeCode)
     {
@@ -66,9 +72,7 @@ void CartridgeReader::initCartridgeInfo()
 
 
     // Read the RAM size
-    m_romFile.seekg(0x0149, std::ios::beg);
-    uint8_t ramSizeCode{};
-    m_romFile.read(reinterpret_cast<char*>(&ramSizeCode), 1);
+    const uint8_t ramSizeCode{m_romData[0x0149]};
     Logger::info("RAM size code: " +  toHexStr(ramSizeCode));
     switch (ramSizeCode)
     {
@@ -96,64 +100,89 @@ void CartridgeReader::initCartridgeInfo()
 
 
     // Get whether Super Game Boy is supported
-    m_romFile.seekg(0x0146, std::ios::beg);
-    uint8_t isSuperGameBoySupportedFlag{};
-    m_romFile.read(reinterpret_cast<char*>(&isSuperGameBoySupportedFlag), 1);
+    const uint8_t isSuperGameBoySupportedFlag{m_romData[0x0146]};
     m_cartridgeInfo.isSGBSupported = (isSuperGameBoySupportedFlag == 0x03);
 
 
     // Get whether Game Boy Color is supported
-    m_romFile.seekg(0x0143, std::ios::beg);
-    uint8_t isCGBOnlyFlag{};
-    m_romFile.read(reinterpret_cast<char*>(&isCGBOnlyFlag), 1);
+    const uint8_t isCGBOnlyFlag{m_romData[0x0143]};
     m_cartridgeInfo.isCGBOnly = (isCGBOnlyFlag == 0xc0);
 
 
     // Get destination
-    m_romFile.seekg(0x014a, std::ios::beg);
-    uint8_t isNonJapaneseFlag{};
-    m_romFile.read(reinterpret_cast<char*>(&isNonJapaneseFlag), 1);
+    const uint8_t isNonJapaneseFlag{m_romData[0x014a]};
     m_cartridgeInfo.isJapanese = !isNonJapaneseFlag;
 
 
     // Get version of game
-    m_romFile.seekg(0x014c, std::ios::beg);
-    m_romFile.read(reinterpret_cast<char*>(&m_cartridgeInfo.gameVersion), 1);
+    m_cartridgeInfo.gameVersion = m_romData[0x014c];
+
+
+    // Get the checksums, they identify the ROM in the saved states
+    m_cartridgeInfo.headerChecksum = m_romData[0x014d];
+    m_cartridgeInfo.globalChecksum = (m_romData[0x014e] << 8) | m_romData[0x014f];
 
 
     Logger::info("Cartridge info set");
 }
 
+bool CartridgeReader::checkHeader(const uint8_t *romData, size_t romSize, std::string *error)
+{
+    // The header ends at 0x014f
+    if (romSize < 0x0150)
+    {
+        *error = "ROM is too small";
+        return false;
+    }
+
+    const uint8_t romSizeCode{romData[0x0148]};
+    if (romSizeCode > 0x08 && (romSizeCode < 0x52 || romSizeCode > 0x54))
+    {
+        *error = "Invalid ROM size code: "+toHexStr(romSizeCode);
+        return false;
+    }
+    // The same sizes as in initCartridgeInfo(), the file has to be larger
+    const size_t headerRomSize{romSizeCode == 0x52 ? 1153433u : romSizeCode == 0x53 ? 1258291u
+        : romSizeCode == 0x54 ? 1572864u : (32767u << romSizeCode)};
+    if (romSize <= headerRomSize)
+    {
+        *error = "ROM is smaller than its header says";
+        return false;
+    }
+
+    const uint8_t ramSizeCode{romData[0x0149]};
+    if (ramSizeCode > 0x05)
+    {
+        *error = "Invalid RAM size code: "+toHexStr(ramSizeCode);
+        return false;
+    }
+
+    return true;
+}
+
 void CartridgeReader::loadRomToMemory(Memory &memory)
 {
     Logger::info("Loading ROM to memory");
 
     Logger::info("ROM size: "+toHexStr(m_cartridgeInfo.romSize));
 
-    m_romFile.seekg(0, std::ios::beg);
-
-    uint8_t  currentByteValue{};
     uint32_t currentByteIndex{};
-    while (!m_romFile.eof() && !m_romFile.fail() && currentByteIndex <= m_cartridgeInfo.romSize)
+    while (currentByteIndex < m_romData.size() && currentByteIndex <= m_cartridgeInfo.romSize)
     {
         //Logger::info("Reading byte at: "+to_hex(currentByteIndex));
 
-        m_romFile.read(reinterpret_cast<char*>(&currentByteValue), 1);
-
-        memory.set(currentByteIndex, currentByteValue, false);
+        memory.set(currentByteIndex, m_romData[currentByteIndex], false);
 
         ++currentByteIndex;
-        m_romFile.seekg(currentByteIndex, std::ios::beg);
     }
 
-    long readBytes{m_romFile.tellg()};
-
-    Logger::info("Copied " + std::to_string(readBytes) + " bytes");
+    Logger::info("Copied " + std::to_string(currentByteIndex) + " bytes");
 
-    memory.printRom0();
+    if (!Logger::isQuiet())
+        memory.printRom0();
 
 #ifndef CARTRIDGE_READER_NO_COPY_CHECK
-    if (readBytes != currentByteIndex)
+    if (currentByteIndex <= m_cartridgeInfo.romSize)
         Logger::fatal("Failed to copy ROM");
     else
         Logger::info("ROM copied");
@@ -168,7 +197,8 @@ CartridgeInfo CartridgeReader::getCartridgeInfo()
 void CartridgeReader::closeRomFile()
 {
     m_filename.clear();
-    m_romFile.close();
+    m_romData.clear();
+    m_romData.shrink_to_fit();
 
     Logger::info("Closed ROM file");
 }
@@ -9,11 +9,8 @@
 
 #include <string>
 #include <fstream>
+#include <vector>
 #include <stdint.h>
-#include <SDL2/SDL.h>
-
-extern int WINDOW_WIDTH;
-extern int WINDOW_HEIGHT;
 
 class Memory;
 
@@ -29,21 +26,35 @@ struct CartridgeInfo
     bool        isSGBSupported{};
     bool        isJapanese{};
     uint8_t     gameVersion{};
+    // Checksum of the header (0x0134-0x014c) at 0x014d
+    uint8_t     headerChecksum{};
+    // Checksum of the whole ROM at 0x014e-0x014f, big-endian
+    uint16_t    globalChecksum{};
 };
 
 class CartridgeReader final
 {
 private:
     std::string     m_filename;
-    std::ifstream   m_romFile;
+    // The whole ROM file
+    std::vector<uint8_t> m_romData;
     CartridgeInfo   m_cartridgeInfo;
 
     void            initCartridgeInfo();
 
 public:
     CartridgeReader(const std::string &filename);
+    // Reads the ROM from memory, `romData` is copied
+    CartridgeReader(const uint8_t *romData, size_t romSize);
     ~CartridgeReader();
 
+    /*
+     * Returns false if the ROM is too small or its header has a ROM or RAM size code
+     * that the reader would reject with Logger::fatal(), then `error` is set to the reason.
+     * For callers that must not exit, like the library and the test runner.
+     */
+    static bool     checkHeader(const uint8_t *romData, size_t romSize, std::string *error);
+
     CartridgeInfo   getCartridgeInfo();
     void            loadRomToMemory(Memory &memory);
 
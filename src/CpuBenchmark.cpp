@@ -0,0 +1,138 @@
+#include "CpuBenchmark.h"
+
+#include "hashing.h"
+#include "string_formatting.h"
+
+#include <chrono>
+#include <iostream>
+
+#define ROM_SIZE        0x8000
+#define ROM_ENTRY_ADDR  0x0150
+
+std::vector<uint8_t> CpuBenchmark::generateRom()
+{
+    std::vector<uint8_t> rom(ROM_SIZE);
+
+    // Header: NOP; JP 0x0150, the rest of the header can be zero
+    const uint8_t entryPoint[]{0x00, 0xc3, ROM_ENTRY_ADDR & 0xff, ROM_ENTRY_ADDR >> 8};
+    std::copy(std::begin(entryPoint), std::end(entryPoint), rom.begin()+0x0100);
+    const char title[]{"CPU BENCHMARK"};
+    std::copy(std::begin(title), std::end(title)-1, rom.begin()+0x0134);
+
+    const uint8_t program[]{
+        0xf3,               // DI
+        0x31, 0xfe, 0xff,   // LD SP,0xfffe
+        0xaf,               // XOR A
+        0xe0, 0x40,         // LDH (LCDC),A     ; LCD off
+        0x21, 0x00, 0xc0,   // LD HL,0xc000
+        0x01, 0x00, 0x00,   // LD BC,0
+        0x11, 0x00, 0x00,   // LD DE,0
+        // loop:
+        0x78,               // LD A,B
+        0x81,               // ADD A,C
+        0x8a,               // ADC A,D
+        0x93,               // SUB E
+        0x9c,               // SBC A,H
+        0xa1,               // AND C
+        0xaa,               // XOR D
+        0xb3,               // OR E
+        0xb9,               // CP C
+        0xc6, 0x37,         // ADD A,0x37
+        0xce, 0x11,         // ADC A,0x11
+        0xd6, 0x05,         // SUB 0x05
+        0xde, 0x03,         // SBC A,0x03
+        0xe6, 0xf7,         // AND 0xf7
+        0xee, 0x5a,         // XOR 0x5a
+        0xf6, 0x01,         // OR 0x01
+        0xfe, 0x80,         // CP 0x80
+        0x3c,               // INC A
+        0x0c,               // INC C
+        0x15,               // DEC D
+        0x1c,               // INC E
+        0x5f,               // LD E,A
+        0x77,               // LD (HL),A
+        0x2c,               // INC L
+        0x05,               // DEC B
+        0x20, 0xdd,         // JR NZ,loop
+        0xf5,               // PUSH AF          ; read the flags once in a while
+        0xd1,               // POP DE
+        0xe5,               // PUSH HL          ; copy 256 bytes of the results
+        0x21, 0x00, 0xc0,   // LD HL,0xc000
+        0x11, 0x00, 0xc1,   // LD DE,0xc100
+        0x01, 0x00, 0x01,   // LD BC,0x0100
+        // copy:
+        0x2a,               // LD A,(HL+)
+        0x12,               // LD (DE),A
+        0x13,               // INC DE
+        0x0b,               // DEC BC
+        0x78,               // LD A,B
+        0xb1,               // OR C
+        0x20, 0xf8,         // JR NZ,copy
+        0xe1,               // POP HL
+        0x18, 0xc6,         // JR loop
+    };
+    std::copy(std::begin(program), std::end(program), rom.begin()+ROM_ENTRY_ADDR);
+
+    return rom;
+}
+
+CpuBenchmark::CpuBenchmark(const std::vector<FusedPair> &fusedPairs)
+    : m_rom{generateRom()}, m_fusedPairs{fusedPairs}
+{
+}
+
+CpuBenchmark::Result CpuBenchmark::runMachine(
+        unsigned long frames, bool isEagerFlags, const std::vector<FusedPair> &fusedPairs) const
+{
+    namespace chr = std::chrono;
+
+    GBMachine machine{m_rom.data(), m_rom.size()};
+    machine.setEagerFlags(isEagerFlags);
+    machine.setFusedPairs(fusedPairs);
+
+    const auto startTime{chr::steady_clock::now()};
+    for (unsigned long i{}; i < frames; ++i)
+        machine.emulateFrame();
+
+    Result result;
+    result.seconds = chr::duration<double>(chr::steady_clock::now()-startTime).count();
+    result.instructions = machine.getCyclesDone();
+    result.tCycles = machine.getTCyclesDone();
+    const Memory *memory{machine.getMemory()};
+    result.wramHash = hashFnv1a64(memory->getWram().data(), memory->getWram().size());
+    return result;
+}
+
+void CpuBenchmark::printResult(const std::string &title, const Result &result)
+{
+    std::cout << std::dec
+        << title << ":\n"
+        << "  Time:            " << result.seconds << " s\n"
+        << "  Instructions/s:  " << result.instructions/result.seconds << '\n'
+        << "  T-cycles/s:      " << result.tCycles/result.seconds
+            << " (" << result.tCycles/result.seconds/DMG_CLOCK_HZ << "x real speed)\n"
+        << "  WRAM hash:       " << toHexStr(result.wramHash, 16, false) << '\n';
+}
+
+bool CpuBenchmark::run(unsigned long frames)
+{
+    const Result eager{runMachine(frames, true, {})};
+    const Result lazy{runMachine(frames, false, {})};
+    const Result fused{runMachine(frames, false, m_fusedPairs)};
+
+    std::cout << "----- CPU benchmark results -----\n"
+        << "Frames:            " << std::dec << frames << '\n';
+    printResult("Eager flags, without fused opcodes", eager);
+    printResult("Lazy flags, without fused opcodes", lazy);
+    std::cout << "Lazy flags speedup:    " << (lazy.instructions/lazy.seconds)/(eager.instructions/eager.seconds) << "x\n";
+    printResult("Lazy flags, with "+std::to_string(m_fusedPairs.size())+" fused opcode pairs", fused);
+    std::cout << "Fused opcodes speedup: " << (fused.instructions/fused.seconds)/(lazy.instructions/lazy.seconds) << "x\n";
+
+    const bool isMatching{
+           lazy.wramHash == eager.wramHash && lazy.instructions == eager.instructions
+        && fused.wramHash == eager.wramHash && fused.instructions == eager.instructions};
+    if (!isMatching)
+        std::cout << "The results differ\n";
+    std::cout.flush();
+    return isMatching;
+}
@@ -0,0 +1,50 @@
+#ifndef CPUBENCHMARK_H_
+#define CPUBENCHMARK_H_
+
+#include "config.h"
+#include "common.h"
+
+#include "GBMachine.h"
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+/*
+ * Measures the speed of the CPU emulation on a generated ROM.
+ *
+ * The ROM turns off the LCD and runs 8-bit arithmetic in a loop, storing the results to the WRAM,
+ * and copies them with a typical copy loop, so most of the time is spent executing ALU and load instructions.
+ * It is run with the flags computed after every instruction, then with the lazy flags,
+ * then with the lazy flags and the fused opcode pairs. The WRAM hash is printed too,
+ * so the runs and builds with different CPU options can be checked to compute the same.
+ */
+class CpuBenchmark final
+{
+private:
+    struct Result
+    {
+        double              seconds{};
+        unsigned long       instructions{};
+        unsigned long long  tCycles{};
+        uint64_t            wramHash{};
+    };
+
+    std::vector<uint8_t>    m_rom;
+    std::vector<FusedPair>  m_fusedPairs;
+
+    static std::vector<uint8_t> generateRom();
+    Result runMachine(unsigned long frames, bool isEagerFlags, const std::vector<FusedPair> &fusedPairs) const;
+    static void printResult(const std::string &title, const Result &result);
+
+public:
+    CpuBenchmark(const std::vector<FusedPair> &fusedPairs);
+
+    /*
+     * Emulates `frames` frames with eager flags, with lazy flags and with lazy flags and the fused opcode pairs,
+     * and prints the results. Returns false if the runs computed different results.
+     */
+    bool run(unsigned long frames);
+};
+
+#endif /* CPUBENCHMARK_H_ */
@@ -41,10 +41,14 @@ public:
         m_content.clear();
     }
 
-    void updateRegisterValues(const Registers *registers);
-    void updateOpcodeValue(const CPU *cpu);
-    // Update values in memory and memory-mapped registers
-    void updateMemoryValues(Memory *memory);
+    // The text of the window is made where the machine is, it can be another thread
+    inline void setContent(const std::string &content) { m_content = content; }
+
+    // These append the values to `content`
+    static void printRegisterValues(std::string &content, const Registers *registers);
+    static void printOpcodeValue(std::string &content, const CPU *cpu);
+    // Values in memory and memory-mapped registers
+    static void printMemoryValues(std::string &content, Memory *memory);
 
     ~DebugWindow();
 };
@@ -0,0 +1,158 @@
+#include "Farm.h"
+
+#include "Logger.h"
+
+#include <algorithm>
+#include <iomanip>
+
+// Frames per second of the DMG: 4194304 T-cycles / 70224 T-cycles per frame
+#define DMG_FPS 59.7275
+
+Farm::Farm(const std::vector<std::string> &romPaths, int instanceCount,
+        bool isIdleSkippingEnabled, const std::vector<FusedPair> &fusedPairs, int frameSkip/*=0*/)
+{
+    if (romPaths.empty() || instanceCount <= 0)
+        Logger::fatal("Farm: no ROMs or no instances");
+
+    m_instances.resize(instanceCount);
+    for (int i{}; i < instanceCount; ++i)
+    {
+        Instance &instance{m_instances[i]};
+        instance.stats.romPath = romPaths[i%romPaths.size()];
+        instance.machine = std::make_unique<GBMachine>(instance.stats.romPath);
+        if (instance.machine->getCartridgeInfo()->isCGBOnly)
+            Logger::fatal("Farm: ROM is CGB only: "+instance.stats.romPath);
+        instance.machine->setIdleSkipping(isIdleSkippingEnabled);
+        instance.machine->setFusedPairs(fusedPairs);
+        instance.machine->setFrameSkip(frameSkip);
+    }
+}
+
+void Farm::runQuantum(WorkStealingPool *pool, size_t instanceI)
+{
+    namespace chr = std::chrono;
+
+    Instance &instance{m_instances[instanceI]};
+
+    const auto startTime{chr::steady_clock::now()};
+    for (unsigned long i{}; i < m_quantumFrames && instance.stats.frames < m_targetFrames; ++i)
+    {
+        // There is no input, so a stopped machine would never wake up
+        if (!instance.machine->emulateFrame())
+        {
+            instance.stats.isStopped = true;
+            break;
+        }
+        ++instance.stats.frames;
+    }
+    const auto endTime{chr::steady_clock::now()};
+    instance.stats.renderedFrames = instance.machine->getRenderedFrames();
+    instance.stats.skippedFrames = instance.machine->getSkippedFrames();
+
+    const double seconds{chr::duration<double>(endTime-startTime).count()};
+    instance.stats.busySeconds += seconds;
+    instance.stats.quantumSeconds.push_back((float)seconds);
+
+    if (instance.stats.frames < m_targetFrames && !instance.stats.isStopped)
+        pool->submit([this, pool, instanceI](){ runQuantum(pool, instanceI); });
+    else
+        instance.stats.finishSeconds = chr::duration<double>(endTime-m_startTime).count();
+}
+
+void Farm::run(unsigned long frames, unsigned long quantumFrames, int threadCount/*=0*/, bool pinThreads/*=false*/)
+{
+    namespace chr = std::chrono;
+
+    m_targetFrames = frames;
+    m_quantumFrames = std::max(1ul, quantumFrames);
+    for (Instance &instance : m_instances)
+    {
+        instance.stats.frames = 0;
+        instance.stats.busySeconds = 0;
+        instance.stats.finishSeconds = 0;
+        instance.stats.isStopped = false;
+        instance.stats.quantumSeconds.clear();
+        instance.stats.quantumSeconds.reserve(frames/m_quantumFrames+1);
+    }
+
+    WorkStealingPool pool{threadCount, pinThreads};
+    m_threadCount = pool.getThreadCount();
+
+    m_startTime = chr::steady_clock::now();
+    for (size_t i{}; i < m_instances.size(); ++i)
+        pool.submit([this, &pool, i](){ runQuantum(&pool, i); });
+    pool.wait();
+    m_seconds = chr::duration<double>(chr::steady_clock::now()-m_startTime).count();
+}
+
+double Farm::getAggregateFps() const
+{
+    unsigned long long frames{};
+    for (const Instance &instance : m_instances)
+        frames += instance.stats.frames;
+    return m_seconds > 0 ? frames/m_seconds : 0;
+}
+
+// Returns the `percent` percentile of `values`, `values` is sorted in place
+static double percentile(std::vector<float> &values, double percent)
+{
+    if (values.empty())
+        return 0;
+    std::sort(values.begin(), values.end());
+    return values[std::min(values.size()-1, (size_t)(values.size()*percent/100))];
+}
+
+void Farm::writeReport(std::ostream &stream) const
+{
+    const double fps{getAggregateFps()};
+
+    std::vector<float> allQuantumSeconds;
+    for (const Instance &instance : m_instances)
+        allQuantumSeconds.insert(allQuantumSeconds.end(),
+                instance.stats.quantumSeconds.begin(), instance.stats.quantumSeconds.end());
+    const double p50{percentile(allQuantumSeconds, 50)};
+    const double p99{percentile(allQuantumSeconds, 99)};
+    const double maxSeconds{allQuantumSeconds.empty() ? 0 : allQuantumSeconds.back()};
+    unsigned long long renderedFrames{};
+    unsigned long long skippedFrames{};
+    for (const Instance &instance : m_instances)
+    {
+        renderedFrames += instance.stats.renderedFrames;
+        skippedFrames += instance.stats.skippedFrames;
+    }
+
+    stream << std::fixed << std::setprecision(3)
+        << "----- Farm results -----\n"
+        << "Instances:         " << m_instances.size() << '\n'
+        << "Threads:           " << m_threadCount << '\n'
+        << "Frames/instance:   " << m_targetFrames << '\n'
+        << "Quantum:           " << m_quantumFrames << " frames\n"
+        << "Time:              " << m_seconds << " s\n"
+        << "Aggregate FPS:     " << fps << " (" << fps/DMG_FPS << " real-time instances)\n"
+        << "Rendered frames:   " << renderedFrames << " (skipped: " << skippedFrames << ")\n"
+        << "Quantum latency:   p50 " << p50*1000 << " ms, p99 " << p99*1000 << " ms, max " << maxSeconds*1000 << " ms\n"
+        << "----- Instances -----\n"
+        << "#     frames  skipped FPS        mean ms  p99 ms   max ms   done s   ROM\n";
+
+    for (size_t i{}; i < m_instances.size(); ++i)
+    {
+        const InstanceStats &stats{m_instances[i].stats};
+        std::vector<float> quantumSeconds{stats.quantumSeconds};
+        const double meanSeconds{quantumSeconds.empty() ? 0 : stats.busySeconds/quantumSeconds.size()};
+        const double instanceP99{percentile(quantumSeconds, 99)};
+        const double instanceMax{quantumSeconds.empty() ? 0 : quantumSeconds.back()};
+
+        stream << std::left
+            << std::setw(6) << i
+            << std::setw(8) << stats.frames
+            << std::setw(8) << stats.skippedFrames
+            << std::setw(11) << (stats.busySeconds > 0 ? stats.frames/stats.busySeconds : 0)
+            << std::setw(9) << meanSeconds*1000
+            << std::setw(9) << instanceP99*1000
+            << std::setw(9) << instanceMax*1000
+            << std::setw(9) << stats.finishSeconds
+            << stats.romPath << (stats.isStopped ? " (stopped)" : "") << '\n';
+    }
+    stream << std::right;
+    stream.flush();
+}
@@ -0,0 +1,87 @@
+#ifndef FARM_H
+#define FARM_H
+
+#include "config.h"
+#include "common.h"
+
+#include "GBMachine.h"
+#include "WorkStealingPool.h"
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <ostream>
+#include <chrono>
+
+/*
+ * Runs many independent headless machines on a work-stealing thread pool.
+ *
+ * A task emulates one machine for a quantum of frames and then resubmits itself,
+ * so the machines are interleaved on the workers and idle workers steal the rest.
+ * The time of every quantum is recorded to report the latency of each machine.
+ * A machine in STOP mode is not resubmitted, so it uses no CPU time.
+ */
+class Farm final
+{
+public:
+    struct InstanceStats
+    {
+        std::string         romPath;
+        unsigned long       frames{};
+        // The frames drawn and skipped by the PPU, see GBMachine::setFrameSkip()
+        unsigned long       renderedFrames{};
+        unsigned long       skippedFrames{};
+        // The time spent emulating
+        double              busySeconds{};
+        // The time from the start of the run until the last frame was done
+        double              finishSeconds{};
+        // The time of each quantum
+        std::vector<float>  quantumSeconds;
+        // The machine entered STOP mode, it is parked because nothing can wake it up
+        bool                isStopped{};
+    };
+
+private:
+    struct Instance
+    {
+        std::unique_ptr<GBMachine>  machine;
+        InstanceStats               stats;
+    };
+
+    std::vector<Instance>   m_instances;
+    unsigned long           m_targetFrames{};
+    unsigned long           m_quantumFrames{1};
+    int                     m_threadCount{};
+    double                  m_seconds{};
+
+    std::chrono::steady_clock::time_point m_startTime;
+
+    void runQuantum(WorkStealingPool *pool, size_t instanceI);
+
+public:
+    /*
+     * Creates `instanceCount` machines, the ROMs of `romPaths` are assigned in turn.
+     * CGB only ROMs are rejected. The other parameters are passed to GBMachine::setIdleSkipping(),
+     * setFusedPairs() and setFrameSkip(), like in Benchmark, so the results are comparable.
+     */
+    Farm(const std::vector<std::string> &romPaths, int instanceCount,
+            bool isIdleSkippingEnabled, const std::vector<FusedPair> &fusedPairs, int frameSkip=0);
+
+    /*
+     * Emulates `frames` frames on every machine, `quantumFrames` frames at a time.
+     * If `threadCount` is 0, a thread is started for each CPU core.
+     * If `pinThreads` is true, each worker thread is pinned to a core.
+     */
+    void run(unsigned long frames, unsigned long quantumFrames, int threadCount=0, bool pinThreads=false);
+
+    inline size_t getInstanceCount() const                          { return m_instances.size(); }
+    inline GBMachine* getMachine(size_t instanceI)                  { return m_instances[instanceI].machine.get(); }
+    inline const InstanceStats& getStats(size_t instanceI) const    { return m_instances[instanceI].stats; }
+    inline double getSeconds() const                                { return m_seconds; }
+    // The frames done by all the machines per second of the last run
+    double getAggregateFps() const;
+
+    void writeReport(std::ostream &stream) const;
+};
+
+#endif // FARM_H
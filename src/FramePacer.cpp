@@ -0,0 +1,130 @@
+#include "FramePacer.h"
+
+#include "PPU.h"
+
+#include <thread>
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+// Sleeping can take this much longer than requested, so the end of the wait is a busy loop
+#define FRAME_PACER_SPIN_TIME std::chrono::milliseconds(1)
+// If the emulation is this many frames behind, it can't catch up, the deadlines start again from the current time
+#define FRAME_PACER_MAX_LAG_FRAMES 8
+// The width of a bin of the frame error histogram, the percentiles are rounded up to this
+#define FRAME_PACER_HISTOGRAM_BIN_SECONDS 0.0001
+
+FramePacer::FramePacer(double speed/*=1*/)
+    : m_speed{std::max(speed, 0.0)}
+{
+    if (m_speed > 0)
+        m_frameDuration = std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>{double(PPU_FRAME_TCYCLES)/DMG_CLOCK_HZ/m_speed});
+}
+
+bool FramePacer::waitForFrameEnd()
+{
+    const auto now{Clock::now()};
+
+    // The first frame starts the deadlines
+    if (!m_isStarted)
+    {
+        m_deadline = now;
+        m_lastFrameEnd = now;
+        m_isStarted = true;
+        return false;
+    }
+
+    if (!isThrottled())
+    {
+        addFrameError(std::chrono::duration<double>(now-m_lastFrameEnd).count());
+        m_lastFrameEnd = now;
+        return false;
+    }
+
+    m_deadline += m_frameDuration;
+    const bool isLate{now >= m_deadline};
+    if (now > m_deadline+m_frameDuration*FRAME_PACER_MAX_LAG_FRAMES)
+    {
+        m_deadline = now;
+        ++m_resyncs;
+    }
+    else if (now < m_deadline)
+    {
+        if (m_deadline-now > FRAME_PACER_SPIN_TIME)
+            std::this_thread::sleep_until(m_deadline-FRAME_PACER_SPIN_TIME);
+        while (Clock::now() < m_deadline)
+            ;
+    }
+    else
+    {
+        ++m_lateFrames;
+    }
+
+    const auto frameEnd{Clock::now()};
+    addFrameError(std::chrono::duration<double>(frameEnd-m_lastFrameEnd-m_frameDuration).count());
+    m_lastFrameEnd = frameEnd;
+    return isLate;
+}
+
+void FramePacer::addFrameError(double error)
+{
+    const double absError{std::abs(error)};
+    ++m_frames;
+    m_totalSeconds += error+std::chrono::duration<double>(m_frameDuration).count();
+    m_absErrorSum += absError;
+    m_maxAbsError = std::max(m_maxAbsError, absError);
+    const size_t bin{std::min((size_t)(absError/FRAME_PACER_HISTOGRAM_BIN_SECONDS), m_absErrorHistogram.size()-1)};
+    ++m_absErrorHistogram[bin];
+}
+
+double FramePacer::getAbsErrorPercentile(int percent) const
+{
+    // The frame at the percentile, counted like the index of a sorted list
+    const unsigned long frameI{std::min(m_frames-1, m_frames*percent/100)};
+    unsigned long frames{};
+    for (size_t i{}; i < m_absErrorHistogram.size(); ++i)
+    {
+        frames += m_absErrorHistogram[i];
+        if (frames > frameI)
+            return std::min((i+1)*FRAME_PACER_HISTOGRAM_BIN_SECONDS, m_maxAbsError);
+    }
+    return m_maxAbsError;
+}
+
+void FramePacer::writeReport(std::ostream &stream) const
+{
+    const double frameSeconds{std::chrono::duration<double>(m_frameDuration).count()};
+
+    const unsigned long frames{m_frames};
+    const double totalSeconds{m_totalSeconds};
+    const double meanError{frames ? m_absErrorSum/frames : 0};
+    const double p99Error{frames ? getAbsErrorPercentile(99) : 0};
+    const double maxError{m_maxAbsError};
+
+    stream << std::fixed << std::setprecision(3)
+        << "----- Frame pacing -----\n"
+        << "Speed:             ";
+    if (isThrottled())
+        stream << m_speed << "x\n";
+    else
+        stream << "unthrottled\n";
+    stream
+        << "Frames:            " << frames << '\n'
+        << "FPS:               " << (totalSeconds > 0 ? frames/totalSeconds : 0) << '\n';
+    if (isThrottled())
+    {
+        stream
+            << "Target FPS:        " << 1/frameSeconds << '\n'
+            << "Late frames:       " << m_lateFrames << " (resynced " << m_resyncs << " times)\n"
+            << "Jitter:            mean " << meanError*1000 << " ms, p99 " << p99Error*1000
+                << " ms, max " << maxError*1000 << " ms\n";
+    }
+    else
+    {
+        stream
+            << "Frame time:        mean " << meanError*1000 << " ms, p99 " << p99Error*1000
+                << " ms, max " << maxError*1000 << " ms\n";
+    }
+    stream.flush();
+}
@@ -0,0 +1,74 @@
+#ifndef FRAMEPACER_H
+#define FRAMEPACER_H
+
+#include "config.h"
+#include "common.h"
+
+#include <chrono>
+#include <array>
+#include <ostream>
+
+/*
+ * Keeps the emulation at a fixed frame rate on the host.
+ *
+ * The deadline of each frame is computed from the start, not from the end of the previous frame,
+ * so the sleep errors don't add up. The emulated hardware only counts cycles,
+ * so the speed changes nothing in the emulation, only how long the host waits between the frames.
+ */
+class FramePacer final
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+private:
+    // 0 if unthrottled
+    double              m_speed{};
+    Clock::duration     m_frameDuration{};
+    Clock::time_point   m_deadline;
+    // When waitForFrameEnd() last returned
+    Clock::time_point   m_lastFrameEnd;
+    bool                m_isStarted{};
+
+    /*
+     * How much the frames took more or less than m_frameDuration (the whole frame time if unthrottled).
+     * Only running statistics are kept, so a long session uses no more memory.
+     */
+    unsigned long       m_frames{};
+    double              m_totalSeconds{};
+    double              m_absErrorSum{};
+    double              m_maxAbsError{};
+    // The absolute errors in 0.1 ms bins, the last bin has everything above, for the percentiles
+    std::array<unsigned long, 1000> m_absErrorHistogram{};
+
+    // Adds the error of a frame to the statistics
+    void addFrameError(double error);
+    // The upper bound of the absolute error of `percent` percent of the frames, in seconds
+    double getAbsErrorPercentile(int percent) const;
+    // The frames that ended after their deadline
+    unsigned long       m_lateFrames{};
+    // The times the deadline was moved because the emulation was too slow to catch up
+    unsigned long       m_resyncs{};
+
+public:
+    /*
+     * `speed` is the multiple of the real speed of the DMG (59.73 frames per second),
+     * 0 disables the waiting.
+     */
+    FramePacer(double speed=1);
+
+    /*
+     * Called after each emulated frame, waits until its deadline.
+     * Returns true if the frame ended after its deadline, then the emulation is behind the real time.
+     */
+    bool waitForFrameEnd();
+    // Forgets the deadlines, for example after the emulation was paused
+    inline void reset() { m_isStarted = false; }
+
+    inline double getSpeed() const { return m_speed; }
+    inline bool isThrottled() const { return m_speed > 0; }
+
+    // Writes the number of frames and the jitter of the frame times
+    void writeReport(std::ostream &stream) const;
+};
+
+#endif // FRAMEPACER_H
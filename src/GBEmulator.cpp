@@ -1,24 +1,38 @@
 #include "GBEmulator.h"
 #include "Logger.h"
 #include "string_formatting.h"
-#include "opcode_names.h"
 
 #include <SDL2/SDL_hints.h>
 #include <SDL2/SDL_ttf.h>
+#include <chrono>
+#include <algorithm>
 
 #define FONT_NAME_OR_PATH "DejaVuSansMono"
 
 //#define DEBUG_MODE
 //#define SHOW_CARTRIDGE_INFO_MESSAGEBOX
-//#define LOG_OPCODE
 //#define USE_MAX_TEXTURE_SCALING_QUALITY
-#define DELAY_BETWEEN_CYCLES_MS 0
 
-GBEmulator::GBEmulator(const std::string &romFilename)
-    : m_romFilename{romFilename}
+// The main thread is woken by the events, this is only a safety net
+#define EVENT_WAIT_TIMEOUT_MS 100
+
+GBEmulator::GBEmulator(const std::string &romFilename, const ColorScheme &colorScheme,
+        int frameSkip, bool isAutoFrameSkipEnabled, double speed,
+        const std::string &inputScriptFilename, const std::string &inputRecordFilename)
+    : m_pacer{speed}, m_romFilename{romFilename}, m_colorScheme{colorScheme},
+    m_frameSkip{frameSkip}, m_isAutoFrameSkipEnabled{isAutoFrameSkipEnabled}
 {
     Logger::info("Starting emulator...");
 
+    if (!inputScriptFilename.empty())
+        m_inputScript = InputScript{inputScriptFilename};
+    if (!inputRecordFilename.empty())
+    {
+        m_inputRecordFile.open(inputRecordFilename);
+        if (!m_inputRecordFile.is_open())
+            Logger::fatal("Failed to open input record file: "+inputRecordFilename);
+    }
+
     initGUI();
     initDebugWindow();
     initTileWindow();
@@ -75,20 +89,41 @@ void GBEmulator::initGUI()
 
     Logger::info("Creating renderer");
 
+    // With vsync the frames are shown when the screen is refreshed, the emulation is timed by FramePacer
     m_renderer = SDL_CreateRenderer(
             m_window,
             -1,
-            SDL_RENDERER_SOFTWARE);
+            SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    if (!m_renderer)
+    {
+        Logger::warning("Failed to create accelerated renderer, using software rendering: "+std::string(SDL_GetError()));
+        m_renderer = SDL_CreateRenderer(
+                m_window,
+                -1,
+                SDL_RENDERER_SOFTWARE);
+    }
 
     if (m_renderer)
         Logger::info("Renderer created");
     else
         Logger::fatal("Failed to create renderer");
 
+    m_frameEventType = SDL_RegisterEvents(1);
+    if (m_frameEventType == (uint32_t)-1)
+        Logger::fatal("Failed to register SDL event");
+
     SDL_SetRenderDrawColor(m_renderer, 0, 0, 0, 255);
     SDL_RenderClear(m_renderer);
     SDL_RenderPresent(m_renderer);
 
+    m_texture = SDL_CreateTexture(
+            m_renderer,
+            SDL_PIXELFORMAT_RGBA32,
+            SDL_TEXTUREACCESS_STREAMING,
+            PPU_SCREEN_WIDTH, PPU_SCREEN_HEIGHT);
+    if (!m_texture)
+        Logger::fatal("Failed to create texture: " + std::string(SDL_GetError()));
+
 #ifdef USE_MAX_TEXTURE_SCALING_QUALITY
     // Set the best possible texture scaling.
     if (!SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "2"))
@@ -127,24 +162,20 @@ void GBEmulator::initSerialViewer()
 
 void GBEmulator::initHardware()
 {
-    Logger::info("Initializing virtual hardware");
-
-    m_cartridgeReader   = new CartridgeReader{m_romFilename};
-
-    if (!m_cartridgeReader)
-    {
-        SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Game Boy Emulator - Error", "No cartridge", m_window);
-
-        Logger::fatal("No cartridge (m_cartridgeReader is NULL)");
-    }
-
-    m_cartridgeInfo     = new CartridgeInfo{m_cartridgeReader->getCartridgeInfo()};
+    SDL_SetWindowTitle(m_window, ("Reading ROM: "+m_romFilename).c_str());
 
-    m_joypad            = new Joypad;
-    m_timer             = new Timer;
-    m_memory            = new Memory{m_cartridgeInfo, m_serialViewer, m_joypad, m_timer};
-    m_cpu               = new CPU{m_memory}; // the CPU needs to know about the memory to do the memory operations
-    m_ppu               = new PPU{m_renderer, m_memory};
+    // The serial output is copied to the viewer with the frames, the viewer is not touched by the emulation thread
+    m_machine = new GBMachine{m_romFilename};
+    m_machine->setColorScheme(m_colorScheme);
+    m_machine->setFrameSkip(m_frameSkip);
+    // Nothing is behind an unthrottled emulation
+    m_isAutoFrameSkipEnabled = m_isAutoFrameSkipEnabled && m_pacer.isThrottled();
+    m_inputScript.queueTCycleEvents(m_machine);
+    // Called on the emulation thread
+    m_machine->setFrameReadyCallback([this](const PPU::Frame &frame){
+        publishFrame(frame.pixels);
+    });
+    m_cartridgeInfo = m_machine->getCartridgeInfo();
 
     showCartridgeInfo();
 
@@ -159,11 +190,6 @@ void GBEmulator::initHardware()
         std::exit(1);
     }
 
-    SDL_SetWindowTitle(m_window, ("Reading ROM: "+m_romFilename).c_str());
-
-    m_cartridgeReader->loadRomToMemory(*m_memory);
-    m_cartridgeReader->closeRomFile();
-
     SDL_SetWindowTitle(m_window, (std::string("Game Boy Emulator - ")+m_cartridgeInfo->title).c_str());
 }
 
@@ -200,162 +226,221 @@ void GBEmulator::showCartridgeInfo()
 
 void GBEmulator::startLoop()
 {
+    m_emulationThread = std::thread{&GBEmulator::emulationLoop, this};
+
     while (!m_isDone)
-        emulateCycle();
+    {
+        // Sleep until there is input or a new frame
+        SDL_Event event;
+        if (SDL_WaitEventTimeout(&event, EVENT_WAIT_TIMEOUT_MS))
+            handleEvent(event);
+    }
+
+    m_emulationThread.join();
+
+    m_pacer.writeReport(std::cout);
 }
 
-void GBEmulator::emulateCycle()
+void GBEmulator::emulationLoop()
 {
-    SDL_Event event;
-    while (SDL_PollEvent(&event) && !m_isDone)
+    while (!m_isDone)
     {
-        switch (event.type)
+        // In STOP mode only a key press can change anything, so wait until the buttons change.
+        // A held button ends STOP at once.
+        if (m_machine->isStopped())
         {
-        case SDL_QUIT:
-            m_isDone = true;
-            break;
-
-        case SDL_KEYDOWN:
-            m_joypad->onKeyPress(event.key.keysym.sym);
-            switch (event.key.keysym.sym)
-            {
-            case SDLK_ESCAPE:
-                m_isDone = true;
+            std::unique_lock<std::mutex> lock{m_wakeMutex};
+            m_wakeCondition.wait(lock, [this]{
+                    return m_isDone || m_appliedButtons || m_pressedButtons.load(std::memory_order_relaxed) != m_appliedButtons; });
+            m_pacer.reset();
+            if (m_isDone)
                 break;
+        }
 
-            case SDLK_F11:
-                if (event.window.windowID == m_windowId)
-                    toggleDebugWindow();
-                return;
-
-            case SDLK_F12:
-                if (event.window.windowID == m_windowId)
-                    toggleTileWindow();
-                return;
-
-            case SDLK_F10:
-                if (event.window.windowID == m_windowId)
-                    toggleSerialViewer();
-                return;
-            }
-            break;
+        applyPressedButtons();
 
-        case SDL_KEYUP:
-            m_joypad->onKeyRelease(event.key.keysym.sym);
-            break;
+#ifdef DEBUG_MODE
+        // Wait for the space key
+        if (m_stepsAllowed == 0)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
         }
+        --m_stepsAllowed;
+
+        m_machine->emulateCycle();
+
+        // Show the state after each instruction
+        if (!m_machine->isFrameDone())
+            publishFrame(m_machine->getPpu()->getFrame().pixels);
+#else
+        m_inputScript.applyFrame(m_machine->getFramesDone(), m_machine->getJoypad());
+        m_machine->emulateFrame();
+        // The pacer is the only clock, a late frame makes the machine skip the drawing of the next one
+        if (m_pacer.waitForFrameEnd() && m_isAutoFrameSkipEnabled)
+            m_machine->requestFrameSkip();
+#endif // DEBUG_MODE
     }
+}
 
-    if (!m_isDone)
+void GBEmulator::applyPressedButtons()
+{
+    const uint8_t pressedButtons{m_pressedButtons.load(std::memory_order_relaxed)};
+    if (pressedButtons == m_appliedButtons)
+        return;
+
+    // The changes are applied at the current T-cycle, so a recording replays exactly
+    for (int i{}; i < (int)Joypad::Button::_Count; ++i)
     {
-        m_cpu->handleInterrupts();
+        const bool isPressed{bool(pressedButtons & (1 << i))};
+        if (isPressed == bool(m_appliedButtons & (1 << i)))
+            continue;
+
+        const GBMachine::InputEvent event{m_machine->getTCyclesDone(), (Joypad::Button)i, isPressed};
+        m_machine->queueInput(event);
+        if (m_inputRecordFile.is_open())
+            m_inputRecordFile << InputScript::formatEvent(event) << '\n';
+    }
+    m_appliedButtons = pressedButtons;
+}
 
-        m_cpu->fetchOpcode();
+void GBEmulator::publishFrame(const std::vector<uint32_t> &pixels)
+{
+    PresentedFrame &frame{m_frames.getWriteBuffer()};
 
-#if defined(LOG_OPCODE) || defined(DEBUG_MODE)
-        Logger::info("----- Cycle -----");
-        Logger::info("PC: "+toHexStr(m_cpu->getRegisters()->getPC()));
-        Logger::info("Opcode value: "+toHexStr(m_cpu->getCurrentOpcode()));
-        Logger::info("Opcode name:  "+OpcodeNames::get(m_cpu->getCurrentOpcode() >> 24, m_cpu->isPrefixedOpcode()));
-        Logger::info("Opcode size:  "+std::to_string(m_cpu->getCurrentOpcodeSize()));
-#endif
+    frame.pixels = pixels;
+    frame.cyclesDone = m_machine->getCyclesDone();
 
+    if (m_isDebugWindowShown)
+    {
+        frame.debugText.clear();
+        DebugWindow::printRegisterValues(frame.debugText, m_machine->getCpu()->getRegisters());
+        DebugWindow::printOpcodeValue(frame.debugText, m_machine->getCpu());
+        DebugWindow::printMemoryValues(frame.debugText, m_machine->getMemory());
+    }
 
-#ifdef DEBUG_MODE
-        waitForSpaceKey();
-#endif // DEBUG_MODE
+    if (m_isTileWindowShown)
+    {
+        const auto &vram{m_machine->getMemory()->getVram()};
+        std::copy(vram.begin(), vram.begin()+frame.tileData.size(), frame.tileData.begin());
+        frame.lcdc = m_machine->getMemory()->get(REGISTER_ADDR_LCDC, false);
+    }
 
-#if DELAY_BETWEEN_CYCLES_MS
-        SDL_Delay(DELAY_BETWEEN_CYCLES_MS);
-#endif
+    if (m_isSerialViewerShown)
+        frame.serialOutput = m_machine->getMemory()->getSerialOutput();
 
-        int elapsedMCycles{};
-        if (m_cpu->isPrefixedOpcode())
-            elapsedMCycles = m_cpu->emulateCurrentPrefixedOpcode();
-        else
-            elapsedMCycles = m_cpu->emulateCurrentOpcode();
+    m_frames.publish();
 
-        for (int i{}; i < elapsedMCycles*4; ++i)
-            m_timer->tick();
-        for (int i{}; i < elapsedMCycles; ++i)
-        {
-            m_memory->tickDma();
-        }
+    if (!m_isFrameEventPending.exchange(true))
+    {
+        SDL_Event event{};
+        event.type = m_frameEventType;
+        if (SDL_PushEvent(&event) != 1)
+            m_isFrameEventPending = false;
+    }
+}
 
-        // If the timer interrupt is requested
-        if (m_timer->isInterruptRequested())
-        {
-            // Set the bit in IF
-            m_memory->set(REGISTER_ADDR_IF, m_memory->get(REGISTER_ADDR_IF, false) | INTERRUPT_MASK_TIMER, false);
-            m_timer->resetInterrupt();
-        }
+void GBEmulator::handleEvent(const SDL_Event &event)
+{
+    if (event.type == m_frameEventType)
+    {
+        // Cleared first, so a frame published after this pushes a new event
+        m_isFrameEventPending = false;
+        if (m_frames.consume())
+            presentFrame(m_frames.getReadBuffer());
+        return;
+    }
 
-        if (m_joypad->isInterruptRequested())
-        {
-            Logger::info("Setting joypad bit in IF");
-            // Set the bit in IF
-            m_memory->set(REGISTER_ADDR_IF, m_memory->get(REGISTER_ADDR_IF, false) | INTERRUPT_MASK_JOYPAD, false);
-            m_joypad->clearInterruptRequestedFlag();
-        }
+    switch (event.type)
+    {
+    case SDL_QUIT:
+        quit();
+        break;
 
-        for (int i{}; i < elapsedMCycles*4; ++i)
+    case SDL_KEYDOWN:
+        onJoypadKey(event.key.keysym.sym, true);
+        switch (event.key.keysym.sym)
         {
-            updateGraphics();
-
-            if (m_memory->get(REGISTER_ADDR_LY) == 144 && m_ppu->isScanlineStart()) // Start of v-blank
-            {
-                SDL_SetWindowTitle(m_window, (std::string("Game Boy Emulator - ")
-                            +m_cartridgeInfo->title+" - cycle "+std::to_string(m_cyclesDone)).c_str());
-                SDL_RenderPresent(m_renderer);
-                updateTileWindow();
-                updateSerialViewer();
-            }
-        }
+        case SDLK_ESCAPE:
+            quit();
+            break;
 
-        if (m_joypad->isInterruptRequested())
-        {
-            Logger::info("Setting joypad bit in IF");
-            // Set the bit in IF
-            m_memory->set(REGISTER_ADDR_IF, m_memory->get(REGISTER_ADDR_IF, false) | INTERRUPT_MASK_JOYPAD, false);
-            m_joypad->clearInterruptRequestedFlag();
-        }
+        case SDLK_SPACE:
+            ++m_stepsAllowed;
+            break;
+
+        case SDLK_F11:
+            if (event.window.windowID == m_windowId)
+                toggleDebugWindow();
+            return;
 
-        updateDebugWindow();
+        case SDLK_F12:
+            if (event.window.windowID == m_windowId)
+                toggleTileWindow();
+            return;
 
-        m_cpu->enableImaIfNeeded();
-        m_cpu->stepPC();
+        case SDLK_F10:
+            if (event.window.windowID == m_windowId)
+                toggleSerialViewer();
+            return;
+        }
+        break;
 
-        ++m_cyclesDone;
+    case SDL_KEYUP:
+        onJoypadKey(event.key.keysym.sym, false);
+        break;
     }
 }
 
-void GBEmulator::updateGraphics()
+void GBEmulator::onJoypadKey(SDL_Keycode key, bool isPressed)
 {
-    m_ppu->updateBackground();
+    for (int i{}; i < (int)Joypad::Button::_Count; ++i)
+    {
+        if (key == m_joypadKeyCodes[i])
+        {
+            if (isPressed)
+                m_pressedButtons |= uint8_t(1 << i);
+            else
+                m_pressedButtons &= uint8_t(~(1 << i));
+            wakeEmulationThread();
+            break;
+        }
+    }
 }
 
-void GBEmulator::waitForSpaceKey()
+void GBEmulator::quit()
 {
-    SDL_Event event;
+    m_isDone = true;
+    wakeEmulationThread();
+}
 
-    while (true)
-    {
-        SDL_PollEvent(&event);
+void GBEmulator::wakeEmulationThread()
+{
+    // Notified under the lock, so the wake-up can't come between the check and the wait of the emulation thread
+    std::lock_guard<std::mutex> lock{m_wakeMutex};
+    m_wakeCondition.notify_one();
+}
 
-        if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_SPACE) break;
+void GBEmulator::presentFrame(const PresentedFrame &frame)
+{
+    SDL_SetWindowTitle(m_window, (std::string("Game Boy Emulator - ")
+                +m_cartridgeInfo->title+" - cycle "+std::to_string(frame.cyclesDone)).c_str());
 
-        SDL_Delay(16);
-    }
+    SDL_UpdateTexture(m_texture, nullptr, frame.pixels.data(), PPU_SCREEN_WIDTH*sizeof(Uint32));
+    SDL_RenderCopy(m_renderer, m_texture, nullptr, nullptr);
+    SDL_RenderPresent(m_renderer);
+
+    updateDebugWindow(frame);
+    updateTileWindow(frame);
+    updateSerialViewer(frame);
 }
 
-void GBEmulator::updateDebugWindow()
+void GBEmulator::updateDebugWindow(const PresentedFrame &frame)
 {
     if (m_isDebugWindowShown)
     {
         m_debugWindow->clearRenderer();
-        m_debugWindow->updateRegisterValues(m_cpu->getRegisters());
-        m_debugWindow->updateOpcodeValue(m_cpu);
-        m_debugWindow->updateMemoryValues(m_memory);
+        m_debugWindow->setContent(frame.debugText);
         m_debugWindow->updateRenderer();
     }
 }
@@ -367,16 +452,14 @@ void GBEmulator::toggleDebugWindow()
     if (m_isDebugWindowShown) m_debugWindow->show();
     else m_debugWindow->hide();
 
-    updateDebugWindow();
-
     SDL_RaiseWindow(m_window);
 }
 
-void GBEmulator::updateTileWindow()
+void GBEmulator::updateTileWindow(const PresentedFrame &frame)
 {
     if (m_isTileWindowShown)
     {
-        m_tileWindow->updateTiles(m_ppu, m_memory->get(REGISTER_ADDR_LCDC, false));
+        m_tileWindow->updateTiles(frame.tileData.data(), frame.lcdc);
         m_tileWindow->updateRenderer();
     }
 }
@@ -388,16 +471,15 @@ void GBEmulator::toggleTileWindow()
     if (m_isTileWindowShown) m_tileWindow->show();
     else m_tileWindow->hide();
 
-    updateTileWindow();
-
     SDL_RaiseWindow(m_window);
 }
 
-void GBEmulator::updateSerialViewer()
+void GBEmulator::updateSerialViewer(const PresentedFrame &frame)
 {
     if (m_isSerialViewerShown)
     {
         m_serialViewer->clearRenderer();
+        m_serialViewer->setText(frame.serialOutput);
         m_serialViewer->updateText();
         m_serialViewer->updateRenderer();
     }
@@ -410,8 +492,6 @@ void GBEmulator::toggleSerialViewer()
     if (m_isSerialViewerShown) m_serialViewer->show();
     else m_serialViewer->hide();
 
-    updateSerialViewer();
-
     SDL_RaiseWindow(m_window);
 }
 
@@ -420,14 +500,11 @@ void GBEmulator::deinit()
     delete m_debugWindow;
     delete m_fontLdr;
 
-    delete m_cpu;
-    delete m_ppu;
-    delete m_memory;
-    delete m_cartridgeReader;
-    delete m_cartridgeInfo;
+    delete m_machine;
 
     Logger::info("Cleaned up");
 
+    SDL_DestroyTexture(m_texture);
     SDL_DestroyRenderer(m_renderer);
     SDL_DestroyWindow(m_window);
 
@@ -439,6 +516,13 @@ void GBEmulator::deinit()
 
 GBEmulator::~GBEmulator()
 {
+    // If startLoop() did not return
+    if (m_emulationThread.joinable())
+    {
+        quit();
+        m_emulationThread.join();
+    }
+
     deinit();
 
     Logger::info("========== Emulator exited ==========");
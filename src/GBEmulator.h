@@ -5,52 +5,107 @@
 
 #include "common.h"
 
-#include "CPU.h"
-#include "PPU.h"
-#include "CartridgeReader.h"
-#include "Memory.h"
-#include "Joypad.h"
-#include "Timer.h"
+#include "GBMachine.h"
 
 #include "DebugWindow.h"
 #include "TileWindow.h"
 #include "SerialViewer.h"
+#include "TripleBuffer.h"
+#include "FramePacer.h"
+#include "InputScript.h"
 
 #include <string>
+#include <array>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <fstream>
 #include <SDL2/SDL.h>
 
+/*
+ * The emulation runs on its own thread, the windows are updated on the main thread.
+ * The emulation thread only touches the machine, and hands over a copy of each frame
+ * (with the contents of the shown debug windows) in a triple buffer,
+ * so neither thread waits for the other. The main thread sleeps in the SDL event queue,
+ * the emulation thread pushes an event into it when there is a new frame.
+ */
 class GBEmulator final
 {
 private:
-    bool            m_isDone{};
-
-    bool            m_isDebugWindowShown{};
-    bool            m_isTileWindowShown{};
-    bool            m_isSerialViewerShown{};
-
-    unsigned long   m_cyclesDone{};
+    // What the emulation thread hands over to the main thread
+    struct PresentedFrame
+    {
+        std::vector<Uint32> pixels;
+        unsigned long   cyclesDone{};
+        // These are only filled if the window is shown
+        std::string     debugText;
+        std::string     serialOutput;
+        std::array<uint8_t, 0x1800> tileData{};
+        uint8_t         lcdc{};
+    };
+
+    std::atomic<bool>   m_isDone{};
+
+    std::atomic<bool>   m_isDebugWindowShown{};
+    std::atomic<bool>   m_isTileWindowShown{};
+    std::atomic<bool>   m_isSerialViewerShown{};
+
+    // The pressed joypad buttons, a bit for each `Joypad::Button`, set by the main thread
+    std::atomic<uint8_t> m_pressedButtons{};
+    // The buttons that are queued in the machine, only used by the emulation thread
+    uint8_t             m_appliedButtons{};
+    // The emulation thread waits on this in STOP mode, until the buttons change or the emulator quits
+    std::mutex          m_wakeMutex;
+    std::condition_variable m_wakeCondition;
+    // The input to replay and the file where the input is recorded, used by the emulation thread
+    InputScript         m_inputScript;
+    std::ofstream       m_inputRecordFile;
+    // In debug mode, the number of instructions the emulation thread may execute, incremented by the space key
+    std::atomic<int>    m_stepsAllowed{};
+
+    TripleBuffer<PresentedFrame> m_frames;
+    // The type of the SDL event that tells the main thread that a frame was published
+    uint32_t            m_frameEventType{};
+    // Set while a frame event is in the event queue, so there is at most one
+    std::atomic<bool>   m_isFrameEventPending{};
+    std::thread         m_emulationThread;
+    // Used by the emulation thread
+    FramePacer          m_pacer;
 
     SDL_Window      *m_window{nullptr};
     uint32_t        m_windowId{};
     SDL_Renderer    *m_renderer{nullptr};
+    // The frames of the PPU are copied here
+    SDL_Texture     *m_texture{nullptr};
 
     FontLoader      *m_fontLdr{};
 
-    CPU             *m_cpu{nullptr}; // the registers are in the CPU
-    PPU             *m_ppu{nullptr};
-    Memory          *m_memory{nullptr};
-    CartridgeReader *m_cartridgeReader{nullptr};
-    Joypad          *m_joypad{nullptr};
-    Timer           *m_timer{nullptr};
-
+    GBMachine       *m_machine{nullptr};
 
-    CartridgeInfo   *m_cartridgeInfo{nullptr};
+    const CartridgeInfo *m_cartridgeInfo{nullptr};
 
     DebugWindow     *m_debugWindow{nullptr};
     TileWindow      *m_tileWindow{nullptr};
     SerialViewer    *m_serialViewer{nullptr};
 
     std::string     m_romFilename;
+    ColorScheme     m_colorScheme;
+    int             m_frameSkip{};
+    bool            m_isAutoFrameSkipEnabled{};
+
+    // The keys of the joypad buttons, indexed by `Joypad::Button`
+    std::array<SDL_Keycode, (int)Joypad::Button::_Count> m_joypadKeyCodes{
+        SDLK_w,     // Up
+        SDLK_s,     // Down
+        SDLK_a,     // Left
+        SDLK_d,     // Right
+        SDLK_RIGHT, // Button A
+        SDLK_LEFT,  // Button B
+        SDLK_UP,    // Select
+        SDLK_DOWN,  // Start
+    };
 
     void initGUI();
     void initDebugWindow();
@@ -62,22 +117,42 @@ private:
     
     void showCartridgeInfo();
 
-    void updateGraphics();
-    void emulateCycle();
-
-    void waitForSpaceKey();
-
-    void updateDebugWindow();
+    // These run on the emulation thread
+    void emulationLoop();
+    // Queues the changes of the pressed buttons in the machine at the current T-cycle
+    void applyPressedButtons();
+    // Copies `pixels` and the contents of the shown windows to the triple buffer and wakes the main thread
+    void publishFrame(const std::vector<uint32_t> &pixels);
+
+    // These run on the main thread
+    void handleEvent(const SDL_Event &event);
+    void onJoypadKey(SDL_Keycode key, bool isPressed);
+    // Sets `m_isDone` and wakes the emulation thread
+    void quit();
+    // Wakes the emulation thread if it waits in STOP mode
+    void wakeEmulationThread();
+    void presentFrame(const PresentedFrame &frame);
+
+    void updateDebugWindow(const PresentedFrame &frame);
     void toggleDebugWindow();
 
-    void updateTileWindow();
+    void updateTileWindow(const PresentedFrame &frame);
     void toggleTileWindow();
 
-    void updateSerialViewer();
+    void updateSerialViewer(const PresentedFrame &frame);
     void toggleSerialViewer();
 
 public:
-    GBEmulator(const std::string &romFilename);
+    /*
+     * See GBMachine::setFrameSkip(). If `isAutoFrameSkipEnabled` is set, frames are skipped
+     * while they end after their deadlines in FramePacer, see GBMachine::requestFrameSkip().
+     * `speed` is the multiple of the real speed, 0 is unthrottled, see FramePacer.
+     * The input script `inputScriptFilename` is replayed, and the button presses and releases
+     * are written to `inputRecordFilename` with their T-cycles, they can be empty.
+     */
+    GBEmulator(const std::string &romFilename, const ColorScheme &colorScheme=colorSchemeGreen,
+            int frameSkip=0, bool isAutoFrameSkipEnabled=false, double speed=1,
+            const std::string &inputScriptFilename="", const std::string &inputRecordFilename="");
 
     void startLoop();
 
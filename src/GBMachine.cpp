@@ -0,0 +1,458 @@
+#include "GBMachine.h"
+#include "Logger.h"
+#include "string_formatting.h"
+#include "opcode_table.h"
+#include "StateStream.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+// Return from a halted cycle after this many M-cycles even if the CPU is still halted,
+// so the caller can check the input and the frames even if no interrupt is enabled
+#define HALT_MAX_MCYCLES (PPU_FRAME_TCYCLES/4)
+
+// A busy-wait loop is at most this long, in bytes including the closing JR
+#define IDLE_LOOP_MAX_SIZE 16
+
+#define STATE_MAGIC     0x54534247 // "GBST"
+// Increment when the layout of the saved state changes
+#define STATE_VERSION   8
+
+GBMachine::GBMachine(const std::string &romFilename)
+    : GBMachine{CartridgeReader{romFilename}}
+{
+}
+
+GBMachine::GBMachine(const uint8_t *romData, size_t romSize)
+    : GBMachine{CartridgeReader{romData, romSize}}
+{
+}
+
+GBMachine::GBMachine(CartridgeReader &&cartridgeReader)
+    : m_cartridgeInfo{cartridgeReader.getCartridgeInfo()},
+    m_memory{&m_cartridgeInfo, &m_joypad, &m_timer},
+    m_cpu{&m_memory}, // the CPU needs to know about the memory to do the memory operations
+    m_ppu{&m_memory}
+{
+    Logger::info("Initializing virtual hardware");
+
+    cartridgeReader.loadRomToMemory(m_memory);
+    cartridgeReader.closeRomFile();
+}
+
+bool GBMachine::isFrameEnd()
+{
+    if (m_isFrameDone)
+        return true;
+
+    // There is no V-blank while the LCD is off, so count a frame's worth of cycles instead
+    return (m_memory.get(REGISTER_ADDR_LCDC, false) & LCDC_BIT_LCD_PPU_ENABLE) == 0
+            && m_tCyclesDone-m_frameStartTCycle >= PPU_FRAME_TCYCLES;
+}
+
+bool GBMachine::emulateFrame()
+{
+    m_frameStartTCycle = m_tCyclesDone;
+
+    do
+    {
+        emulateCycle();
+
+        // The time passes but nothing is emulated until a button is pressed,
+        // the frame is not finished, so it is not counted
+        if (m_cpu.isStopped())
+            return false;
+    }
+    while (!isFrameEnd());
+
+    ++m_framesDone;
+    return true;
+}
+
+void GBMachine::queueInput(const InputEvent &event)
+{
+    // After the events of the same T-cycle
+    const auto it{std::upper_bound(m_inputQueue.begin(), m_inputQueue.end(), event,
+            [](const InputEvent &a, const InputEvent &b){ return a.tCycle < b.tCycle; })};
+    m_inputQueue.insert(it, event);
+}
+
+unsigned long long GBMachine::getTCyclesUntilInput() const
+{
+    if (m_inputQueue.empty())
+        return ULLONG_MAX;
+    return m_inputQueue.front().tCycle > m_tCyclesDone ? m_inputQueue.front().tCycle-m_tCyclesDone : 0;
+}
+
+void GBMachine::applyDueInput()
+{
+    while (isInputDue())
+    {
+        const InputEvent &event{m_inputQueue.front()};
+        if (event.isPress)
+            m_joypad.setBtnPressed(event.button);
+        else
+            m_joypad.setBtnReleased(event.button);
+        m_inputQueue.pop_front();
+    }
+}
+
+void GBMachine::requestInterrupts()
+{
+    // If the timer interrupt is requested
+    if (m_timer.isInterruptRequested())
+    {
+        // Set the bit in IF
+        m_memory.requestInterrupt(INTERRUPT_MASK_TIMER);
+        m_timer.resetInterrupt();
+    }
+
+    if (m_joypad.isInterruptRequested())
+    {
+        Logger::info("Setting joypad bit in IF");
+        // Set the bit in IF
+        m_memory.requestInterrupt(INTERRUPT_MASK_JOYPAD);
+        m_joypad.clearInterruptRequestedFlag();
+    }
+}
+
+void GBMachine::tickHardware(int mCycles)
+{
+    for (int i{}; i < mCycles*4; ++i)
+        m_timer.tick();
+    for (int i{}; i < mCycles; ++i)
+    {
+        m_memory.tickDma();
+    }
+
+    requestInterrupts();
+
+    for (int i{}; i < mCycles*4; ++i)
+    {
+        m_ppu.updateBackground();
+
+        if (m_memory.get(REGISTER_ADDR_LY, false) == 144 && m_ppu.isScanlineStart()) // Start of v-blank
+        {
+            m_isFrameDone = true;
+        }
+    }
+
+    requestInterrupts();
+
+    if (mCycles > 0)
+        m_tCyclesDone += mCycles*4;
+}
+
+void GBMachine::skipIdleHardware(int mCycles)
+{
+    m_timer.skip(mCycles*4);
+    for (int i{}; i < mCycles; ++i)
+        m_memory.tickDma();
+    m_ppu.skipIdleCycles(mCycles*4);
+    m_tCyclesDone += mCycles*4;
+}
+
+int GBMachine::emulateHalt()
+{
+    int elapsedMCycles{};
+    while (!m_memory.getPendingInterrupts()
+            && !m_isFrameDone && elapsedMCycles < HALT_MAX_MCYCLES && !isInputDue())
+    {
+        // Jump over the cycles where nothing can request an interrupt.
+        // The cycle of the timer overflow is emulated normally, so the interrupt is requested in time,
+        // and the skip ends at the M-cycle where the next input event is due.
+        const int inputMCycles{(int)(std::min(
+                getTCyclesUntilInput(), (unsigned long long)HALT_MAX_MCYCLES*4)+3)/4};
+        // A button press requests the interrupt in the next emulated cycle
+        const int skippableMCycles{m_isIdleSkippingEnabled && !m_joypad.isInterruptRequested()
+            ? std::min({m_ppu.getIdleCycles(), m_timer.getCyclesUntilInterrupt()-1, (HALT_MAX_MCYCLES-elapsedMCycles)*4,
+                    inputMCycles*4})/4
+            : 0};
+
+        if (skippableMCycles > 0)
+        {
+            skipIdleHardware(skippableMCycles);
+            elapsedMCycles += skippableMCycles;
+        }
+        else
+        {
+            tickHardware(1);
+            ++elapsedMCycles;
+        }
+    }
+    return elapsedMCycles;
+}
+
+int GBMachine::getIdleLoopInstructionCount(uint16_t startAddr, uint16_t jumpAddr)
+{
+    if (jumpAddr-startAddr+2 > IDLE_LOOP_MAX_SIZE)
+        return 0;
+
+    int instructionCount{};
+    uint16_t addr{startAddr};
+    while (addr < jumpAddr)
+    {
+        const uint8_t opcode{m_memory.get(addr, false)};
+        const uint8_t operand{m_memory.get(addr+1, false)};
+        switch (opcode)
+        {
+        case 0x00: // NOP
+        case 0xa7: // AND A
+        case 0xaf: // XOR A
+        case 0xb7: // OR A
+        case 0xbf: // CP A
+        case 0xe6: // AND d8
+        case 0xee: // XOR d8
+        case 0xf6: // OR d8
+        case 0xfe: // CP d8
+            break;
+
+        case 0xf0: // LDH A,(a8)
+            // Only the registers that are changed by the PPU or by an interrupt request,
+            // the others are constant while the CPU is in the loop, or are changed by the timer
+            if (operand != (REGISTER_ADDR_IF & 0xff)
+                    && (operand < (REGISTER_ADDR_LCDC & 0xff) || operand > (REGISTER_ADDR_WX & 0xff)))
+                return 0;
+            break;
+
+        case 0xcb: // BIT n,A
+            if (operand < 0x40 || operand > 0x7f || (operand & 0x07) != 0x07)
+                return 0;
+            break;
+
+        default:
+            return 0;
+        }
+        addr += (opcode == 0xcb ? prefixedOpcodeTable[operand].size : opcodeTable[opcode].size);
+        ++instructionCount;
+    }
+    // An instruction overlaps the JR
+    if (addr != jumpAddr)
+        return 0;
+
+    // +1 for the JR
+    return instructionCount+1;
+}
+
+int GBMachine::skipIdleLoop(uint16_t jumpAddr)
+{
+    const uint16_t startAddr{m_cpu.getRegisters()->getPC()};
+    int skippedMCycles{};
+
+    if (m_idleLoop.instructionCount == 0 || m_idleLoop.startAddr != startAddr || m_idleLoop.jumpAddr != jumpAddr)
+    {
+        m_idleLoop = IdleLoop{};
+        const int instructionCount{getIdleLoopInstructionCount(startAddr, jumpAddr)};
+        if (instructionCount == 0)
+            return 0;
+        m_idleLoop.startAddr = startAddr;
+        m_idleLoop.jumpAddr = jumpAddr;
+        m_idleLoop.instructionCount = instructionCount;
+    }
+    else
+    {
+        const int iterationTCycles{(int)(m_tCyclesDone-m_idleLoop.iterationStartTCycle)};
+        const uint8_t ifRegValue{m_memory.get(REGISTER_ADDR_IF, false)};
+
+        // The last iteration was not interrupted, the PPU registers and IF did not change during it,
+        // and it ended with the same A and F as it started with.
+        // So every iteration is the same until the PPU or the timer changes something.
+        if (m_cyclesDone-m_idleLoop.iterationStartCycle == (unsigned long)m_idleLoop.instructionCount
+                && iterationTCycles <= m_idleLoop.iterationStartPpuIdleTCycles
+                && ifRegValue == m_idleLoop.iterationStartIF
+                && m_cpu.getRegisters()->getAF() == m_idleLoop.iterationStartAF
+                && !m_cpu.isInterruptPending()
+                && !m_joypad.isInterruptRequested())
+        {
+            // The cycle of the timer overflow is emulated normally, so the interrupt is requested in time
+            // An input event is applied at the first instruction boundary at or after its T-cycle,
+            // so only the iterations that end before it (or at it) are skipped
+            const int iterations{std::min({
+                    m_ppu.getIdleCycles(),
+                    m_timer.getCyclesUntilInterrupt()-1,
+                    PPU_FRAME_TCYCLES,
+                    (int)std::min(getTCyclesUntilInput(), (unsigned long long)PPU_FRAME_TCYCLES)})/iterationTCycles};
+            if (iterations > 0)
+            {
+                skippedMCycles = iterations*iterationTCycles/4;
+                skipIdleHardware(skippedMCycles);
+                m_cyclesDone += iterations*m_idleLoop.instructionCount;
+            }
+        }
+    }
+
+    m_idleLoop.iterationStartCycle = m_cyclesDone;
+    m_idleLoop.iterationStartTCycle = m_tCyclesDone;
+    m_idleLoop.iterationStartPpuIdleTCycles = m_ppu.getIdleCycles();
+    m_idleLoop.iterationStartAF = m_cpu.getRegisters()->getAF();
+    m_idleLoop.iterationStartIF = m_memory.get(REGISTER_ADDR_IF, false);
+    return skippedMCycles;
+}
+
+bool GBMachine::canFusePair(int mCycles)
+{
+    // The pair is executed at once, so the hardware has to stay idle during all of its cycles
+    const int tCycles{mCycles*4};
+    if (tCycles > m_ppu.getIdleCycles() || tCycles >= m_timer.getCyclesUntilInterrupt()
+            || m_joypad.isInterruptRequested() || getTCyclesUntilInput() < (unsigned long long)tCycles)
+        return false;
+
+    // The frame of a disabled LCD must not end between the two opcodes
+    return (m_memory.get(REGISTER_ADDR_LCDC, false) & LCDC_BIT_LCD_PPU_ENABLE) != 0
+            || m_tCyclesDone-m_frameStartTCycle+tCycles < PPU_FRAME_TCYCLES;
+}
+
+int GBMachine::emulateStep()
+{
+    int elapsedMCycles{m_cpu.fetchNext()};
+    if (m_cpu.isHalted())
+    {
+        tickHardware(elapsedMCycles);
+        ++m_cyclesDone;
+        return elapsedMCycles;
+    }
+
+    // A fused pair is executed with one dispatch, when no interrupt was handled before it
+    if (elapsedMCycles == 0 && m_cpu.getFusedPairCycles() && canFusePair(m_cpu.getFusedPairCycles()))
+    {
+        elapsedMCycles = m_cpu.executeFusedPair();
+        skipIdleHardware(elapsedMCycles);
+        m_cyclesDone += 2;
+        return elapsedMCycles;
+    }
+
+    elapsedMCycles += m_cpu.executeOpcode();
+    tickHardware(elapsedMCycles);
+    ++m_cyclesDone;
+
+    // A JR (0x18) or JR cc (0x20, 0x28, 0x30, 0x38) that jumped back can close a busy-wait loop
+    const uint8_t opcode{m_cpu.getCurrentOpcode()};
+    const uint16_t opcodeAddr{m_cpu.getCurrentOpcodeAddr()};
+    if (m_isIdleSkippingEnabled && !m_cpu.isPrefixedOpcode() && (opcode == 0x18 || (opcode & 0xe7) == 0x20)
+            && m_cpu.getRegisters()->getPC() <= opcodeAddr)
+        return elapsedMCycles+skipIdleLoop(opcodeAddr);
+
+    return elapsedMCycles;
+}
+
+int GBMachine::emulateCycle()
+{
+    m_isFrameDone = false;
+
+    // The time does not pass in STOP mode, so the next event would never be due
+    if (m_cpu.isStopped() && !m_inputQueue.empty())
+        m_inputQueue.front().tCycle = m_tCyclesDone;
+    applyDueInput();
+
+    // In STOP mode nothing happens until a button is pressed,
+    // if one is already held down, STOP does not stop
+    if (m_cpu.isStopped())
+    {
+        if (!m_joypad.isInterruptRequested() && !m_joypad.isAnyButtonPressed())
+            return 0;
+        m_cpu.wakeUpFromStop();
+    }
+
+    // The CPU is halted until an interrupt is requested
+    if (m_cpu.isHalted() && !m_cpu.isInterruptRequested())
+    {
+        const int elapsedMCycles{emulateHalt()};
+        ++m_cyclesDone;
+        return elapsedMCycles;
+    }
+
+    return emulateStep();
+}
+
+unsigned long long GBMachine::emulateTCycles(unsigned long long tCycles)
+{
+    const unsigned long long startTCycle{m_tCyclesDone};
+    while (m_tCyclesDone-startTCycle < tCycles && !m_cpu.isStopped())
+        emulateCycle();
+    return m_tCyclesDone-startTCycle;
+}
+
+template <class Stream>
+void GBMachine::serializeState(Stream &stream)
+{
+    uint32_t magic{STATE_MAGIC};
+    uint32_t version{STATE_VERSION};
+    stream.value(magic);
+    stream.value(version);
+    // Identifies the cartridge, loadState() checks these before loading anything
+    stream.value(m_cartridgeInfo.title);
+    stream.value(m_cartridgeInfo.headerChecksum);
+    stream.value(m_cartridgeInfo.globalChecksum);
+
+    stream.value(m_cyclesDone);
+    stream.value(m_tCyclesDone);
+    stream.value(m_framesDone);
+    stream.value(m_isFrameDone);
+
+    m_joypad.serializeState(stream);
+    m_timer.serializeState(stream);
+    m_memory.serializeState(stream);
+    m_cpu.serializeState(stream);
+    m_ppu.serializeState(stream);
+}
+
+size_t GBMachine::getStateSize()
+{
+    StateSizer sizer;
+    serializeState(sizer);
+    return sizer.getSize();
+}
+
+bool GBMachine::saveState(uint8_t *buffer, size_t bufferSize)
+{
+    StateWriter writer{buffer, bufferSize};
+    serializeState(writer);
+    return !writer.isFailed();
+}
+
+bool GBMachine::loadState(const uint8_t *buffer, size_t bufferSize)
+{
+    // Check the state before changing the machine
+    if (bufferSize != getStateSize())
+        return false;
+
+    StateReader headerReader{buffer, bufferSize};
+    uint32_t magic{};
+    uint32_t version{};
+    char title[sizeof(m_cartridgeInfo.title)]{};
+    uint8_t headerChecksum{};
+    uint16_t globalChecksum{};
+    headerReader.value(magic);
+    headerReader.value(version);
+    headerReader.value(title);
+    headerReader.value(headerChecksum);
+    headerReader.value(globalChecksum);
+    if (magic != STATE_MAGIC || version != STATE_VERSION)
+        return false;
+    // The ROM is not in the state, so it has to be the same cartridge
+    if (std::memcmp(title, m_cartridgeInfo.title, sizeof(title)) != 0
+            || headerChecksum != m_cartridgeInfo.headerChecksum || globalChecksum != m_cartridgeInfo.globalChecksum)
+        return false;
+
+    // The size of the state depends only on the number of RAM banks,
+    // so if the size matches, the banks match too and loading shouldn't fail halfway.
+    // If it does, the current state is put back, the machine may be in a library that must not exit.
+    std::vector<uint8_t> currentState(bufferSize);
+    saveState(currentState.data(), currentState.size());
+    StateReader reader{buffer, bufferSize};
+    serializeState(reader);
+    if (reader.isFailed())
+    {
+        Logger::error("Failed to load state");
+        StateReader restorer{currentState.data(), currentState.size()};
+        serializeState(restorer);
+        return false;
+    }
+    m_idleLoop = IdleLoop{};
+    // The events would be applied at the wrong cycles of the loaded timeline
+    m_inputQueue.clear();
+    // The banks may be different
+    m_memory.onBankSwitch();
+    return true;
+}
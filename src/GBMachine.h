@@ -0,0 +1,197 @@
+#ifndef GBMACHINE_H_
+#define GBMACHINE_H_
+
+#include "config.h"
+
+#include "common.h"
+
+#include "CPU.h"
+#include "PPU.h"
+#include "CartridgeReader.h"
+#include "Memory.h"
+#include "Joypad.h"
+#include "Timer.h"
+
+#include <string>
+#include <vector>
+#include <deque>
+
+/*
+ * The emulated hardware without the user interface.
+ *
+ * It has no windows and does not handle SDL events, so any number of machines
+ * can run in one process, each driven by a single thread at a time.
+ * All the state of a machine is in this object, so it can't be copied.
+ */
+class GBMachine final
+{
+public:
+    // A button press or release, applied before the first instruction that starts at or after `tCycle`
+    struct InputEvent
+    {
+        unsigned long long  tCycle{};
+        Joypad::Button      button{};
+        bool                isPress{};
+    };
+
+private:
+    unsigned long   m_cyclesDone{};
+    unsigned long long m_tCyclesDone{};
+    unsigned long   m_framesDone{};
+    // The T-cycle where the current emulateFrame() call started
+    unsigned long long m_frameStartTCycle{};
+    // Set if the last cycle started the V-blank
+    bool            m_isFrameDone{};
+    // Skip the cycles where the hardware has nothing to do while the CPU waits
+    bool            m_isIdleSkippingEnabled{true};
+
+    /*
+     * The last busy-wait loop: a short loop that only reads the I/O registers and only changes A and F,
+     * so it does the same until the hardware changes one of the registers.
+     */
+    struct IdleLoop
+    {
+        uint16_t            startAddr{};
+        // The address of the JR that closes the loop
+        uint16_t            jumpAddr{};
+        // The number of emulated cycles of one iteration
+        int                 instructionCount{};
+
+        // The state at the start of the current iteration
+        unsigned long       iterationStartCycle{};
+        unsigned long long  iterationStartTCycle{};
+        int                 iterationStartPpuIdleTCycles{};
+        uint16_t            iterationStartAF{};
+        uint8_t             iterationStartIF{};
+    };
+    IdleLoop        m_idleLoop;
+
+    // The queued input events, in the order of their T-cycles
+    std::deque<InputEvent> m_inputQueue;
+
+    // The components are constructed in this order, a component only points to the ones above it
+    CartridgeInfo   m_cartridgeInfo;
+    Joypad          m_joypad;
+    Timer           m_timer;
+    Memory          m_memory;
+    CPU             m_cpu; // the registers are in the CPU
+    PPU             m_ppu;
+
+    GBMachine(CartridgeReader &&cartridgeReader);
+
+    inline bool isInputDue() const { return !m_inputQueue.empty() && m_inputQueue.front().tCycle <= m_tCyclesDone; }
+    // The T-cycles until the next queued input event, ULLONG_MAX if there is none
+    unsigned long long getTCyclesUntilInput() const;
+    void applyDueInput();
+    void requestInterrupts();
+    // Returns true if emulateFrame() has to return after the current cycle
+    bool isFrameEnd();
+    // Emulates the timer, DMA and PPU for `mCycles` M-cycles
+    void tickHardware(int mCycles);
+    // Advances the hardware by `mCycles` M-cycles where the timer and the PPU are idle
+    void skipIdleHardware(int mCycles);
+    // Emulates the hardware while the CPU is halted, returns the elapsed M-cycles
+    int emulateHalt();
+    // Returns true if the hardware can't change anything during the `mCycles` M-cycles of a fused pair
+    bool canFusePair(int mCycles);
+    // Executes one instruction (or a fused pair) and emulates the hardware during it, returns the elapsed M-cycles
+    int emulateStep();
+    // Returns the instruction count of the loop if it is a busy-wait loop, otherwise 0
+    int getIdleLoopInstructionCount(uint16_t startAddr, uint16_t jumpAddr);
+    /*
+     * Called after the JR at `jumpAddr` jumped back. If it closes a busy-wait loop,
+     * skips the iterations that would read the same values. Returns the skipped M-cycles.
+     */
+    int skipIdleLoop(uint16_t jumpAddr);
+
+    template <class Stream>
+    void serializeState(Stream &stream);
+
+public:
+    /*
+     * The frames are not displayed, see setFrameReadyCallback(),
+     * and the serial output is only collected, see Memory::getSerialOutput().
+     */
+    GBMachine(const std::string &romFilename);
+    // Loads the ROM from memory, `romData` is copied
+    GBMachine(const uint8_t *romData, size_t romSize);
+    GBMachine(const GBMachine&) = delete;
+    GBMachine& operator=(const GBMachine&) = delete;
+
+    // Emulates one instruction (or a fused pair) and the hardware during it, returns the elapsed M-cycles
+    int emulateCycle();
+    /*
+     * Emulates until the start of the next V-blank, or until the CPU enters STOP mode.
+     * Returns true if the frame was finished, only those are counted by getFramesDone().
+     */
+    bool emulateFrame();
+    /*
+     * Emulates at least `tCycles` T-cycles, or until the CPU enters STOP mode, returns the elapsed T-cycles.
+     * Instructions are not split, so this can be a few cycles more than requested.
+     */
+    unsigned long long emulateTCycles(unsigned long long tCycles);
+
+    // The size of a saved state in bytes, it depends on the cartridge
+    size_t getStateSize();
+    // Returns false if `bufferSize` is too small
+    bool saveState(uint8_t *buffer, size_t bufferSize);
+    /*
+     * Returns false if the state is invalid or was saved from a different cartridge, then the machine is unchanged.
+     * The queued input is not part of the state, its T-cycles belong to the old timeline,
+     * so it is cleared when a state is loaded. The caller queues the input of the new timeline.
+     */
+    bool loadState(const uint8_t *buffer, size_t bufferSize);
+
+    /*
+     * If enabled, the cycles where the CPU waits and the other hardware does nothing observable
+     * are jumped over instead of emulated one by one, both while the CPU is halted and while it polls
+     * the I/O registers in a busy-wait loop. The result is the same, this is for checking that.
+     */
+    inline void setIdleSkipping(bool isEnabled)         { m_isIdleSkippingEnabled = isEnabled; }
+    /*
+     * The opcode pairs in `pairs` are executed in one emulateCycle() call, when nothing can come between them.
+     * The result is the same, but there is less work per opcode. By default the pairs in fused_pairs.h are used.
+     */
+    inline void setFusedPairs(const std::vector<FusedPair> &pairs) { m_cpu.setFusedPairs(pairs); }
+    // Computes the flags after every ALU operation instead of lazily, see Registers.h
+    inline void setEagerFlags(bool isEnabled) { m_cpu.getRegisters()->setEagerFlags(isEnabled); }
+
+    // Sets the shades of the LCD, see PPU.h
+    inline void setColorScheme(const ColorScheme &colorScheme) { m_ppu.setColorScheme(colorScheme); }
+
+    /*
+     * Queues a button press or release, it is applied at the instruction boundary where the machine reaches
+     * `event.tCycle` (or at once if that is already past). The idle skipping and the fused pairs stop there,
+     * so replaying the same events gives the same result in every mode.
+     * In STOP mode the time does not pass, so the next event is applied at once. loadState() clears the queue.
+     */
+    void queueInput(const InputEvent &event);
+
+    // Draws only every `frameSkip+1`th frame, see PPU::setFrameSkip()
+    inline void setFrameSkip(int frameSkip)             { m_ppu.setFrameSkip(frameSkip); }
+    /*
+     * Skips the next frame too, see PPU::requestFrameSkip(). The machine does not know the real time,
+     * the user interface calls this while the emulation is behind it.
+     */
+    inline void requestFrameSkip()                      { m_ppu.requestFrameSkip(); }
+    inline unsigned long getRenderedFrames() const      { return m_ppu.getRenderedFrames(); }
+    inline unsigned long getSkippedFrames() const       { return m_ppu.getSkippedFrames(); }
+
+    // `callback` is called with each drawn frame, at the start of V-blank
+    inline void setFrameReadyCallback(const PPU::FrameReadyCallback &callback) { m_ppu.setFrameReadyCallback(callback); }
+
+    // In STOP mode the machine does nothing until a button is pressed
+    inline bool isStopped() const                       { return m_cpu.isStopped(); }
+    inline bool isFrameDone() const                     { return m_isFrameDone; }
+    inline unsigned long getCyclesDone() const          { return m_cyclesDone; }
+    inline unsigned long getFramesDone() const          { return m_framesDone; }
+    inline unsigned long long getTCyclesDone() const    { return m_tCyclesDone; }
+
+    inline CPU* getCpu()                                { return &m_cpu; }
+    inline PPU* getPpu()                                { return &m_ppu; }
+    inline Memory* getMemory()                          { return &m_memory; }
+    inline Joypad* getJoypad()                          { return &m_joypad; }
+    inline const CartridgeInfo* getCartridgeInfo() const{ return &m_cartridgeInfo; }
+};
+
+#endif /* GBMACHINE_H_ */
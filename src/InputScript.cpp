@@ -0,0 +1,89 @@
+#include "InputScript.h"
+
+#include "Logger.h"
+
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+
+static bool strToButton(const std::string &str, Joypad::Button *btnOut)
+{
+    for (int i{}; i < (int)Joypad::Button::_Count; ++i)
+    {
+        if (Joypad::buttonEnumToStr((Joypad::Button)i) == str)
+        {
+            *btnOut = (Joypad::Button)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+InputScript::InputScript(const std::string &filename)
+{
+    std::ifstream file{filename};
+    if (!file.is_open())
+        Logger::fatal("Failed to open input script: "+filename);
+
+    std::string line;
+    int lineI{};
+    while (std::getline(file, line))
+    {
+        ++lineI;
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        // A T-cycle instead of a frame
+        const bool hasTCycle{line[0] == '@'};
+        std::stringstream ss{hasTCycle ? line.substr(1) : line};
+        unsigned long long time{};
+        Event event;
+        std::string buttonName;
+        std::string action;
+        if (!(ss >> time >> buttonName >> action)
+         || !strToButton(buttonName, &event.button)
+         || (action != "down" && action != "up"))
+            Logger::fatal("Invalid line in input script: "+filename+":"+std::to_string(lineI));
+        event.isPress = (action == "down");
+
+        if (hasTCycle)
+        {
+            m_tCycleEvents.push_back({time, event.button, event.isPress});
+        }
+        else
+        {
+            event.frame = (unsigned long)time;
+            m_events.push_back(event);
+        }
+    }
+
+    // Keep the order of the events in the same frame
+    std::stable_sort(m_events.begin(), m_events.end(),
+            [](const Event &a, const Event &b){ return a.frame < b.frame; });
+
+    Logger::info("Loaded "+std::to_string(m_events.size()+m_tCycleEvents.size())+" input events from "+filename);
+}
+
+void InputScript::applyFrame(unsigned long frame, Joypad *joypad)
+{
+    while (m_nextEventI < m_events.size() && m_events[m_nextEventI].frame <= frame)
+    {
+        const Event &event{m_events[m_nextEventI]};
+        if (event.isPress)
+            joypad->setBtnPressed(event.button);
+        else
+            joypad->setBtnReleased(event.button);
+        ++m_nextEventI;
+    }
+}
+
+void InputScript::queueTCycleEvents(GBMachine *machine) const
+{
+    for (const GBMachine::InputEvent &event : m_tCycleEvents)
+        machine->queueInput(event);
+}
+
+std::string InputScript::formatEvent(const GBMachine::InputEvent &event)
+{
+    return '@'+std::to_string(event.tCycle)+' '+Joypad::buttonEnumToStr(event.button)+(event.isPress ? " down" : " up");
+}
@@ -0,0 +1,53 @@
+#ifndef INPUTSCRIPT_H
+#define INPUTSCRIPT_H
+
+#include "config.h"
+#include "common.h"
+
+#include "Joypad.h"
+#include "GBMachine.h"
+
+#include <string>
+#include <vector>
+
+/*
+ * A list of button presses and releases to replay, for reproducible runs.
+ *
+ * Each line of a script file is: <frame> <button> <down|up>
+ * or, to apply the event at an exact T-cycle: @<T-cycle> <button> <down|up>
+ * The button names are the ones returned by `Joypad::buttonEnumToStr()`.
+ * Empty lines and lines starting with '#' are ignored.
+ * The emulator records the input in the second format, see formatEvent().
+ */
+class InputScript final
+{
+public:
+    struct Event
+    {
+        unsigned long   frame{};
+        Joypad::Button  button{};
+        bool            isPress{};
+    };
+
+private:
+    std::vector<Event>  m_events;
+    size_t              m_nextEventI{};
+    // The events with a T-cycle, they are queued in the machine
+    std::vector<GBMachine::InputEvent> m_tCycleEvents;
+
+public:
+    // An empty script
+    InputScript() {}
+    InputScript(const std::string &filename);
+
+    // Applies the events of frame `frame` to the joypad.
+    // The frames have to be applied in ascending order.
+    void applyFrame(unsigned long frame, Joypad *joypad);
+    // Queues the events with a T-cycle in `machine`, see GBMachine::queueInput()
+    void queueTCycleEvents(GBMachine *machine) const;
+
+    // Returns `event` as a line of a script, without the newline
+    static std::string formatEvent(const GBMachine::InputEvent &event);
+};
+
+#endif // INPUTSCRIPT_H
@@ -2,7 +2,6 @@
 #define JOYPAD_H
 
 #include "Logger.h"
-#include <SDL2/SDL.h>
 
 #include <cassert>
 #include <stdint.h>
@@ -61,8 +60,13 @@ public:
         return m_btnStates[btnEnumToInt(btn)];
     }
 
-    void onKeyPress(SDL_Keycode key);
-    void onKeyRelease(SDL_Keycode key);
+    inline bool isAnyButtonPressed() const
+    {
+        for (bool isPressed : m_btnStates)
+            if (isPressed)
+                return true;
+        return false;
+    }
 
     inline void setBtnPressed(Button btn)
     {
@@ -80,18 +84,14 @@ public:
         Logger::info("Released button: "+buttonEnumToStr(btn));
         m_btnStates[btnEnumToInt(btn)] = false;
     }
-};
 
-
-static constexpr SDL_Keycode joypadKeyCodes[(int)Joypad::Button::_Count] = {
-    SDLK_w,     // Up
-    SDLK_s,     // Down
-    SDLK_a,     // Left
-    SDLK_d,     // Right
-    SDLK_RIGHT, // Button A
-    SDLK_LEFT,  // Button B
-    SDLK_UP,    // Select
-    SDLK_DOWN,  // Start
+    // Passes the state to `stream`, see StateStream.h
+    template <class Stream>
+    void serializeState(Stream &stream)
+    {
+        stream.value(m_btnStates);
+        stream.value(m_isIntReq);
+    }
 };
 
 #endif // JOYPAD_H
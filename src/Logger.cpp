@@ -1,11 +1,15 @@
 #include <iostream>
 #include <iomanip>
 #include <chrono>
+#include <atomic>
 
 #include "Logger.h"
 
 //#define LOG_NO_COLOR
 
+// Read by every thread that logs, only the flag itself has to be atomic
+static std::atomic<bool> s_isQuiet{};
+
 static inline std::string getTime()
 {
     namespace chr = std::chrono;
@@ -70,6 +74,9 @@ void Logger::info(const std::string &message)
 {
     using namespace std::chrono;
 
+    if (s_isQuiet.load(std::memory_order_relaxed))
+        return;
+
     std::cout << std::dec;
 
     #ifndef LOG_NO_COLOR
@@ -80,3 +87,13 @@ void Logger::info(const std::string &message)
     
     std::cout.flush();
 }
+
+void Logger::setQuiet(bool isQuiet)
+{
+    s_isQuiet.store(isQuiet, std::memory_order_relaxed);
+}
+
+bool Logger::isQuiet()
+{
+    return s_isQuiet.load(std::memory_order_relaxed);
+}
@@ -9,6 +9,10 @@ namespace Logger
     void error(const std::string &message);
     void warning(const std::string &message);
     void info(const std::string &message);
+
+    // When quiet, info messages are not printed
+    void setQuiet(bool isQuiet);
+    bool isQuiet();
 }
 
 #endif // LOGGER_H
@@ -13,8 +13,8 @@
 #define JOYP_BIT_RIGHT_OR_BTN_A  (1 << 0)
 #define JOYP_MASK_ALL_BTNS       0x0f
 
-Memory::Memory(const CartridgeInfo *info, SerialViewer *serial, Joypad *joypad, Timer *timer)
-    : m_serial{serial}, m_joypadPtr{joypad}, m_timerPtr{timer}
+Memory::Memory(const CartridgeInfo *info, Joypad *joypad, Timer *timer)
+    : m_joypadPtr{joypad}, m_timerPtr{timer}
 {
     m_romBanks.resize(std::max(1, (int)info->romBanks));
     m_ramBanks.resize(std::max(1, (int)info->ramBanks));
@@ -43,10 +43,8 @@ uint8_t Memory::get(uint16_t address, bool log/*=true*/)
         return m_vram[address-0x7fff-1];
     else if (address <= 0xbfff) // SRAM - External cartridge RAM
         return m_ramBanks.at(m_currentRamBank)[address-0x9fff-1];
-    else if (address <= 0xcfff) // WRAM0 - Work RAM
-        return m_wram0[address-0xbfff-1];
-    else if (address <= 0xdfff) // WRAMX - Work RAM
-        return m_wram1[address-0xcfff-1];
+    else if (address <= 0xdfff) // WRAM0 and WRAMX - Work RAM
+        return m_wram[address-0xbfff-1];
     else if (address <= 0xfdff) // ECHO - Mirror RAM
         return get(address-0xbfff-1, log); // map the address to the start of WRAM0
     else if (address <= 0xfe9f) // OAM - Object Attribute RAM / Sprite information table
@@ -206,6 +204,24 @@ uint8_t Memory::get(uint16_t address, bool log/*=true*/)
     return 0;
 }
 
+const uint8_t* Memory::getPagePtr(uint16_t address)
+{
+    // The pages are in one array if they are in one of these areas, like in get()
+    const uint16_t pageStart{(uint16_t)(address & 0xff00)};
+    if      (address <= 0x3fff) // ROM0
+        return m_rom0.data()+pageStart;
+    else if (address <= 0x7fff) // ROMX
+        return m_romBanks.at(m_currentRomBank).data()+(pageStart-0x3fff-1);
+    else if (address <= 0x9fff) // VRAM
+        return m_vram.data()+(pageStart-0x7fff-1);
+    else if (address <= 0xbfff) // SRAM
+        return m_ramBanks.at(m_currentRamBank).data()+(pageStart-0x9fff-1);
+    else if (address <= 0xdfff) // WRAM0 and WRAMX
+        return m_wram.data()+(pageStart-0xbfff-1);
+    // The rest is mirrored or mapped to registers
+    return nullptr;
+}
+
 void Memory::set(uint16_t address, uint8_t value, bool log/*=true*/)
 {
     //if (log) Logger::info("Memory written to address: "+toHexStr(address)+" with value: "+toHexStr(value));
@@ -237,21 +253,34 @@ void Memory::set(uint16_t address, uint8_t value, bool log/*=true*/)
     */
 
     if      (address <= 0x3fff) // ROM0 - Non-switchable ROM bank
-        m_rom0[address] = value;
+    {
+        // The CPU writes go to the registers of the MBC, they don't change the ROM.
+        // Only the cartridge reader writes here.
+        if (!log)
+            m_rom0[address] = value;
+    }
     else if (address <= 0x7fff) // ROMX - Switchable ROM bank
-        m_romBanks.at(m_currentRomBank)[address-0x3fff-1] = value;
+    {
+        if (!log)
+            m_romBanks.at(m_currentRomBank)[address-0x3fff-1] = value;
+    }
     else if (address <= 0x9fff) // VRAM - Video RAM
+    {
         m_vram[address-0x7fff-1] = value;
+        if (address <= 0x97ff) // Tile data
+            m_tileCache.invalidateTile((address-0x7fff-1)/TILE_CACHE_TILE_BYTES);
+    }
     else if (address <= 0xbfff) // SRAM - External cartridge RAM
         m_ramBanks.at(m_currentRamBank)[address-0x9fff-1] = value;
-    else if (address <= 0xcfff) // WRAM0 - Work RAM
-        m_wram0[address-0xbfff-1] = value;
-    else if (address <= 0xdfff) // WRAMX - Work RAM
-        m_wram1[address-0xcfff-1] = value;
+    else if (address <= 0xdfff) // WRAM0 and WRAMX - Work RAM
+        m_wram[address-0xbfff-1] = value;
     else if (address <= 0xfdff) // ECHO - Mirror RAM
         set(address-0xbfff-1, value); // map the address to the start of WRAM0
     else if (address <= 0xfe9f) // OAM - Object Attribute Ram / Sprite information table
+    {
         m_oam[address-0xfdff-1] = value;
+        ++m_oamVersion;
+    }
     else if (address <= 0xfeff) // UNUSED
     {
         // Writes are ignored
@@ -272,9 +301,9 @@ void Memory::set(uint16_t address, uint8_t value, bool log/*=true*/)
             // TODO: The other bits?
             if (value & 0b10000000) // If bit 7 is set
             {
-                m_serial->write(m_sb);  // Write the data in SB to the serial port
+                m_serialOutput += (char)m_sb; // Write the data in SB to the serial port
                 value &= 0b01111111; // Unset bit 7
-                m_ifRegister |= INTERRUPT_MASK_SERIAL; // Call the serial interrupt
+                requestInterrupt(INTERRUPT_MASK_SERIAL); // Call the serial interrupt
             }
             break;
         case REGISTER_ADDR_DIV:
@@ -292,6 +321,7 @@ void Memory::set(uint16_t address, uint8_t value, bool log/*=true*/)
             break;
         case REGISTER_ADDR_IF:
             m_ifRegister = value;
+            updatePendingInterrupts();
             break;
         case REGISTER_ADDR_NR10:
             m_nr10Register = value;
@@ -401,12 +431,15 @@ void Memory::set(uint16_t address, uint8_t value, bool log/*=true*/)
             break;
         case REGISTER_ADDR_BGP:
             m_bgpRegister = value;
+            ++m_paletteVersion;
             break;
         case REGISTER_ADDR_OBP0:
             m_obp0Register = value;
+            ++m_paletteVersion;
             break;
         case REGISTER_ADDR_OBP1:
             m_obp1Register = value;
+            ++m_paletteVersion;
             break;
         case REGISTER_ADDR_DMA:
         {
@@ -421,6 +454,7 @@ void Memory::set(uint16_t address, uint8_t value, bool log/*=true*/)
                 //set(0xfe00+i, get(source+i, false), false);
                 //Logger::info("DMA transfer from "+toHexStr(source+i)+" to "+toHexStr(0xfe00+i));
             }
+            ++m_oamVersion;
         }
             break;
         case 0xff4f: // VRAM bank selector, but DMG does not have switchable VRAM, so writes are ignored
@@ -447,7 +481,10 @@ void Memory::set(uint16_t address, uint8_t value, bool log/*=true*/)
     else if (address <= 0xfffe) // HRAM - High RAM / internal CPU RAM
         m_hram[address-0xff7f-1] = value;
     else if (address == REGISTER_ADDR_IE) // IE Register - Interrupt enable flags
+    {
         m_ie = value;
+        updatePendingInterrupts();
+    }
     else
         IMPOSSIBLE();
 }
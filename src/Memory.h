@@ -7,13 +7,14 @@ struct CartridgeInfo;
 
 #include "common.h"
 #include "CartridgeReader.h"
-#include "SerialViewer.h"
 #include "Joypad.h"
 #include "Timer.h"
+#include "TileCache.h"
 
 #include <stdint.h>
 #include <vector>
 #include <array>
+#include <string>
 
 // Addresses of memory-mapped registers
 #define REGISTER_ADDR_JOYP    0xff00
@@ -67,6 +68,7 @@ struct CartridgeInfo;
 #define INTERRUPT_MASK_TIMER    0b00000100
 #define INTERRUPT_MASK_SERIAL   0b00001000
 #define INTERRUPT_MASK_JOYPAD   0b00010000
+#define INTERRUPT_MASK_ALL      0b00011111
 
 #define STAT_MASK_PPU_MODE          (3)
 // H-Blank
@@ -98,17 +100,17 @@ private:
     /// - tile RAM (data about graphics) and
     // background RAM (where these should be placed) are here
     std::array<uint8_t, 0x1fff + 1>                 m_vram{};
+    // The tiles of the VRAM, decoded
+    TileCache                                       m_tileCache{m_vram.data()};
 
     // External RAM banks
     std::vector<std::array<uint8_t, 0x1fff + 1>>    m_ramBanks{}; // ???
     // Index of current RAM bank
     uint8_t                                         m_currentRamBank{};
 
-    // Work RAM
-    std::array<uint8_t, 0xfff + 1>                  m_wram0{};
-
-    // Work RAM bank, not switchable
-    std::array<uint8_t, 0xfff + 1>                  m_wram1{};
+    // Work RAM, WRAM0 and the WRAMX bank (not switchable) after each other,
+    // so the whole WRAM can be accessed directly
+    std::array<uint8_t, 0x1fff + 1>                 m_wram{};
 
     // ECHO RAM
     // Actually WRAM0 and WRAM1
@@ -213,13 +215,22 @@ private:
 
     // -------------------------------------------------------------------------
 
-    SerialViewer                                    *m_serial{nullptr};
+    // Everything written to the serial port
+    std::string                                     m_serialOutput;
     Joypad                                          *m_joypadPtr{nullptr};
     Timer                                           *m_timerPtr{nullptr};
     int                                             m_dmaRemainingCycles{};
+    unsigned                                        m_pageMapVersion{};
+    unsigned                                        m_oamVersion{};
+    unsigned                                        m_paletteVersion{};
+    // IE & IF, the interrupts that are enabled and requested
+    uint8_t                                         m_pendingInterrupts{};
+
+    inline void updatePendingInterrupts() { m_pendingInterrupts = m_ie & m_ifRegister & INTERRUPT_MASK_ALL; }
 
 public:
-    Memory(const CartridgeInfo *info, SerialViewer *serial, Joypad *joypad, Timer *timer);
+    // The serial output is collected, see getSerialOutput()
+    Memory(const CartridgeInfo *info, Joypad *joypad, Timer *timer);
 
     uint8_t get(uint16_t address, bool log=true);
     void    set(uint16_t address, uint8_t value, bool log=true);
@@ -237,15 +248,51 @@ public:
         set(address+1, (value&0xff00)>>8);
     }
 
-    // Gets a 24-bit value without endianess correction
-    inline uint32_t getOpcodeNoSwap(uint16_t address)
+    /*
+     * Returns the host memory of the 256-byte page that contains `address`,
+     * or NULL if the page is not plain memory that can be read without side effects.
+     * The pointer is valid until getPageMapVersion() changes.
+     */
+    const uint8_t* getPagePtr(uint16_t address);
+    // Incremented when the pages are mapped to different memory, for example by a bank switch
+    inline unsigned getPageMapVersion() const { return m_pageMapVersion; }
+    // Has to be called after a ROM or RAM bank is switched
+    inline void onBankSwitch() { ++m_pageMapVersion; }
+
+    // The decoded tiles, for the PPU
+    inline TileCache& getTileCache() { return m_tileCache; }
+    // The OAM, for the PPU
+    inline const std::array<uint8_t, 0x9f + 1>& getOam() const { return m_oam; }
+    // Incremented when the OAM is written, directly or by DMA
+    inline unsigned getOamVersion() const { return m_oamVersion; }
+
+    // Incremented when BGP, OBP0 or OBP1 is written
+    inline unsigned getPaletteVersion() const { return m_paletteVersion; }
+
+    // Returns IE & IF, it is kept up to date when either register changes, so it is cheap to check
+    inline uint8_t getPendingInterrupts() const { return m_pendingInterrupts; }
+    // Sets the bits of `mask` in IF
+    inline void requestInterrupt(uint8_t mask)
+    {
+        m_ifRegister |= mask;
+        updatePendingInterrupts();
+    }
+    // Resets the bits of `mask` in IF, when the interrupt handler is called
+    inline void acknowledgeInterrupt(uint8_t mask)
     {
-        return
-            (get(address+0, false) << 24) |
-            (get(address+1, false) << 16) |
-            (get(address+2, false) <<  8);
+        m_ifRegister &= ~mask;
+        updatePendingInterrupts();
     }
 
+    inline const std::string& getSerialOutput() const { return m_serialOutput; }
+
+    // The Video RAM (0x8000-0x9fff)
+    inline const std::array<uint8_t, 0x1fff + 1>& getVram() const { return m_vram; }
+
+    // Direct access to the Work RAM (0xc000-0xdfff)
+    inline std::array<uint8_t, 0x1fff + 1>& getWram() { return m_wram; }
+    inline const std::array<uint8_t, 0x1fff + 1>& getWram() const { return m_wram; }
+
     void tickDma()
     {
         if (m_dmaRemainingCycles > 0)
@@ -254,6 +301,68 @@ public:
 
     void printRom0();
     void printWhole();
+
+    // Passes the state to `stream`, see StateStream.h
+    template <class Stream>
+    void serializeState(Stream &stream)
+    {
+        // The ROM is not saved, it can't be written, only the selected bank
+        stream.value(m_currentRomBank);
+        stream.value(m_vram);
+        stream.vector(m_ramBanks);
+        stream.value(m_currentRamBank);
+        stream.value(m_wram);
+        stream.value(m_oam);
+        stream.value(m_joypRegister);
+        stream.value(m_sb);
+        stream.value(m_ifRegister);
+        stream.value(m_nr10Register);
+        stream.value(m_nr11Register);
+        stream.value(m_nr12Register);
+        stream.value(m_nr13Register);
+        stream.value(m_nr14Register);
+        stream.value(m_nr21Register);
+        stream.value(m_nr22Register);
+        stream.value(m_nr23Register);
+        stream.value(m_nr24Register);
+        stream.value(m_nr30Register);
+        stream.value(m_nr31Register);
+        stream.value(m_nr32Register);
+        stream.value(m_nr33Register);
+        stream.value(m_nr34Register);
+        stream.value(m_nr41Register);
+        stream.value(m_nr42Register);
+        stream.value(m_nr43Register);
+        stream.value(m_nr44Register);
+        stream.value(m_nr50Register);
+        stream.value(m_nr51Register);
+        stream.value(m_nr52Register);
+        stream.value(m_lcdControlRegister);
+        stream.value(m_lcdStatusRegister);
+        stream.value(m_scyRegister);
+        stream.value(m_scxRegister);
+        stream.value(m_lyRegister);
+        stream.value(m_lycRegister);
+        stream.value(m_wyRegister);
+        stream.value(m_wxRegister);
+        stream.value(m_bgpRegister);
+        stream.value(m_obp0Register);
+        stream.value(m_obp1Register);
+        stream.value(m_dmaRegister);
+        stream.value(m_hram);
+        stream.value(m_ie);
+        stream.value(m_dmaRemainingCycles);
+
+        if (stream.isLoading())
+        {
+            // It is computed from IE and IF, so it is not saved
+            updatePendingInterrupts();
+            // The OAM, the palettes and the tiles may be different now
+            ++m_oamVersion;
+            ++m_paletteVersion;
+            m_tileCache.invalidateAll();
+        }
+    }
 };
 
 
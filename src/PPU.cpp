@@ -2,10 +2,12 @@
 
 #include "Logger.h"
 #include "string_formatting.h"
+#include "tile_decoder.h"
 
 #include <iostream>
-
-#define PPU_TEX_PIX_FORM SDL_PIXELFORMAT_RGBA32
+#include <climits>
+#include <algorithm>
+#include <cstring>
 
 // Ignore Background Palette Register
 //#define PPU_IGNORE_BPR
@@ -24,75 +26,200 @@
 // There are 10 pseudo-scanlines at the end of a frame
 #define PPU_MODE_1_TCYCLES (10*PPU_SCANLINE_TCYCLES)
 
-PPU::PPU(SDL_Renderer *renderer, Memory *memory)
-    :
-    m_rendererPtr{renderer},
-    m_memoryPtr{memory},
-    m_texture{SDL_CreateTexture(
-            m_rendererPtr,
-            PPU_TEX_PIX_FORM,
-            SDL_TEXTUREACCESS_STREAMING,
-            TILE_MAP_DISPLAYED_TILES_PER_ROW*TILE_SIZE,
-            TILE_MAP_DISPLAYED_TILES_PER_COL*TILE_SIZE
-            )}
+PPU::PPU(Memory *memory)
+    : m_memoryPtr{memory}
+{
+    for (Frame &frame : m_frames)
+    {
+        frame.shades.resize(PPU_SCREEN_WIDTH*PPU_SCREEN_HEIGHT/4);
+        frame.pixels.resize(PPU_SCREEN_WIDTH*PPU_SCREEN_HEIGHT);
+    }
+    setColorScheme(colorSchemeGreen);
+}
+
+int PPU::getTileDataIndex(uint8_t tileI, TileDataSelector tileDataSelector)
 {
-    if (!m_texture) Logger::fatal("Failed to create texture for PPU: " + std::string(SDL_GetError()));
-    SDL_LockTexture(m_texture, nullptr, (void**)&m_texDataPtr, &m_texPitch);
-    m_texForm = SDL_AllocFormat(PPU_TEX_PIX_FORM);
-    // TODO: Deallocate
+    // With the 8800 method tile 0 is at 0x9000, the 256th tile from 0x8000
+    return tileDataSelector == TileDataSelector::Unsigned ? tileI : 256+(int8_t)tileI;
 }
 
 uint8_t PPU::getPixelColorIndex(uint8_t tileI, int tilePixelI, TileDataSelector bgDataSelector) const
 {
-    const uint16_t dataAddrBase = uint16_t((bgDataSelector == TileDataSelector::Unsigned
-                ? TILE_DATA_UNSIGNED_START : TILE_DATA_SIGNED_START));
-    // This should be ok
-    const int tileI_ = (bgDataSelector == TileDataSelector::Unsigned ? tileI : (int8_t)tileI);
-    const uint16_t pixelDataAddress{(uint16_t)(dataAddrBase+tileI_*TILE_SIZE*2+tilePixelI/TILE_SIZE*2)};
-    uint8_t colorI{
-            (uint8_t)
-            (((m_memoryPtr->get(pixelDataAddress+0, false) & (1 << (TILE_SIZE-tilePixelI%TILE_SIZE-1))) ? 2 : 0) |
-             ((m_memoryPtr->get(pixelDataAddress+1, false) & (1 << (TILE_SIZE-tilePixelI%TILE_SIZE-1))) ? 1 : 0))};
-
-    return colorI;
+    return m_memoryPtr->getTileCache().getRow(
+            getTileDataIndex(tileI, bgDataSelector), tilePixelI/TILE_SIZE)[tilePixelI%TILE_SIZE];
 }
 
 uint8_t PPU::getPixelColorIndexFlat(uint tileI, int tilePixelI) const
 {
-    const uint16_t pixelDataAddress{(uint16_t)(TILE_DATA_UNSIGNED_START+tileI*TILE_SIZE*2+tilePixelI/TILE_SIZE*2)};
-    uint8_t colorI{
-            (uint8_t)
-            (((m_memoryPtr->get(pixelDataAddress+0, false) & (1 << (TILE_SIZE-tilePixelI%TILE_SIZE-1))) ? 2 : 0) |
-             ((m_memoryPtr->get(pixelDataAddress+1, false) & (1 << (TILE_SIZE-tilePixelI%TILE_SIZE-1))) ? 1 : 0))};
+    return m_memoryPtr->getTileCache().getRow(tileI, tilePixelI/TILE_SIZE)[tilePixelI%TILE_SIZE];
+}
 
-    return colorI;
+RgbaColor PPU::mapIndexToColor(uint8_t index, uint16_t paletteRegAddr) const
+{
+    // Get the value of the palette register
+    const uint8_t paletteValue{m_memoryPtr->get(paletteRegAddr, false)};
+
+    // Get which color is mapped to the color index
+    const int paletteEntryI{(paletteValue & (3 << index*2)) >> index*2};
+
+    return m_colorScheme[paletteEntryI];
 }
 
-SDL_Color PPU::mapIndexToColor(uint8_t index)
+void PPU::setColorScheme(const ColorScheme &colorScheme)
 {
-    // Get the value of the Background Palette Register
-    const uint8_t bgpValue{m_memoryPtr->get(REGISTER_ADDR_BGP, false)};
-
-    static constexpr SDL_Color palette[]{
-            SDL_Color{0x82, 0x78, 0x0d, 0xff},
-            SDL_Color{0x3a, 0x53, 0x36, 0xff},
-            SDL_Color{0x5c, 0x71, 0x22, 0xff},
-            SDL_Color{0x1c, 0x36, 0x28, 0xff},
-    };
+    m_colorScheme = colorScheme;
+    for (int shade{}; shade < 4; ++shade)
+    {
+        // R, G, B, A in memory, whatever the byte order of the host is
+        const uint8_t bytes[4]{colorScheme[shade].r, colorScheme[shade].g, colorScheme[shade].b, 0xff};
+        std::memcpy(&m_shadePixels[shade], bytes, sizeof(uint32_t));
+    }
+}
 
-    /*
-    static constexpr SDL_Color palette[]{
-            SDL_Color{255, 255, 255, 0xff},
-            SDL_Color{200, 200, 200, 0xff},
-            SDL_Color{100, 100, 100, 0xff},
-            SDL_Color{  0,   0,   0, 0xff},
-    };
-    */
+void PPU::updatePalettes()
+{
+    auto updateShades{[this](std::array<uint8_t, 4> &shades, uint16_t paletteRegAddr){
+        const uint8_t paletteValue{m_memoryPtr->get(paletteRegAddr, false)};
+        for (int colorI{}; colorI < 4; ++colorI)
+            shades[colorI] = (paletteValue >> colorI*2) & 3;
+    }};
+    updateShades(m_bgShades, REGISTER_ADDR_BGP);
+    updateShades(m_obp0Shades, REGISTER_ADDR_OBP0);
+    updateShades(m_obp1Shades, REGISTER_ADDR_OBP1);
+
+    m_palettesVersion = m_memoryPtr->getPaletteVersion();
+    m_arePalettesValid = true;
+}
 
-    // Get which color is mapped to the color index
-    const int paletteEntryI{(bgpValue & (3 << index*2)) >> index*2};
+void PPU::drawPixels(int x, int y, const uint8_t *shades, int count)
+{
+    Frame &frame{m_frames[m_drawnFrameI]};
+    const int firstPixelI{y*PPU_SCREEN_WIDTH+x};
+    for (int i{}; i < count; ++i)
+    {
+        uint8_t &byte{frame.shades[(firstPixelI+i)/4]};
+        const int shift{6-(firstPixelI+i)%4*2};
+        byte = uint8_t((byte & ~(3 << shift)) | (shades[i] << shift));
+    }
+    mapColorIndices(shades, count, m_shadePixels.data(), frame.pixels.data()+firstPixelI);
+}
 
-    return palette[paletteEntryI];
+void PPU::updateFramePixels()
+{
+    for (Frame &frame : m_frames)
+    {
+        for (int pixelI{}; pixelI < PPU_SCREEN_WIDTH*PPU_SCREEN_HEIGHT; ++pixelI)
+            frame.pixels[pixelI] = m_shadePixels[(frame.shades[pixelI/4] >> (6-pixelI%4*2)) & 3];
+    }
+}
+
+void PPU::updateLineSprites(int spriteHeight)
+{
+    for (LineSprites &line : m_lineSprites)
+        line.count = 0;
+
+    const auto &oam{m_memoryPtr->getOam()};
+    // In OAM order, so a scanline gets the first 10 sprites that are on it
+    for (int i{}; i < OAM_SPRITE_COUNT; ++i)
+    {
+        const uint8_t *sprite{oam.data()+i*OAM_SPRITE_SIZE};
+        const int top{sprite[0]-16};
+        for (int y{std::max(top, 0)}; y < std::min(top+spriteHeight, 144); ++y)
+        {
+            LineSprites &line{m_lineSprites[y]};
+            if (line.count == SPRITES_PER_LINE_MAX)
+                continue;
+
+            // The sprite with the smaller X is on top, with the same X the one earlier in OAM
+            int insertI{line.count};
+            while (insertI > 0 && oam[line.oamIs[insertI-1]*OAM_SPRITE_SIZE+1] > sprite[1])
+            {
+                line.oamIs[insertI] = line.oamIs[insertI-1];
+                --insertI;
+            }
+            line.oamIs[insertI] = uint8_t(i);
+            ++line.count;
+        }
+    }
+
+    m_lineSpritesOamVersion = m_memoryPtr->getOamVersion();
+    m_lineSpritesHeight = spriteHeight;
+}
+
+void PPU::getTileMapSpan(uint8_t *output, uint16_t tileMapStart, TileDataSelector tileDataSelector,
+        uint8_t mapX, uint8_t mapY, int count) const
+{
+    const uint16_t tileRowStart{uint16_t(tileMapStart+mapY/TILE_SIZE*TILE_MAP_TILES_PER_ROW)};
+    TileCache &tileCache{m_memoryPtr->getTileCache()};
+    // Copy the decoded pixels tile by tile
+    while (count > 0)
+    {
+        const uint8_t tileI{m_memoryPtr->get(tileRowStart+mapX/TILE_SIZE, false)};
+        const uint8_t *row{tileCache.getRow(getTileDataIndex(tileI, tileDataSelector), mapY%TILE_SIZE)};
+        const int pixelCount{std::min(count, TILE_SIZE-mapX%TILE_SIZE)};
+        std::memcpy(output, row+mapX%TILE_SIZE, pixelCount);
+
+        output += pixelCount;
+        count -= pixelCount;
+        mapX = uint8_t(mapX+pixelCount);
+    }
+}
+
+bool PPU::isWindowVisible(uint8_t lcdcRegValue, uint8_t lyRegValue) const
+{
+    return (lcdcRegValue & LCDC_BIT_BG_WIN_ENABLE)
+        && (lcdcRegValue & LCDC_BIT_WIN_ENABLE)
+        && lyRegValue >= m_memoryPtr->get(REGISTER_ADDR_WY, false)
+        && m_memoryPtr->get(REGISTER_ADDR_WX, false) < 160+7;
+}
+
+uint8_t PPU::getSpritePixelColorIndex(const uint8_t *sprite, int x, int y, int spriteHeight) const
+{
+    const uint8_t attributes{sprite[3]};
+    if (attributes & OAM_ATTR_BIT_X_FLIP)
+        x = TILE_SIZE-1-x;
+    if (attributes & OAM_ATTR_BIT_Y_FLIP)
+        y = spriteHeight-1-y;
+
+    // 8x16 sprites are 2 tiles after each other, the lowest bit of the tile index is ignored
+    uint8_t tileI{sprite[2]};
+    if (spriteHeight == 16)
+        tileI = uint8_t((tileI & 0xfe) | (y / TILE_SIZE));
+
+    // Sprites always use the 8000 method
+    return getPixelColorIndex(tileI, x+y%TILE_SIZE*TILE_SIZE, TileDataSelector::Unsigned);
+}
+
+int PPU::getIdleCycles() const
+{
+    // While the LCD is off, the PPU does nothing
+    if ((m_memoryPtr->get(REGISTER_ADDR_LCDC, false) & LCDC_BIT_LCD_PPU_ENABLE) == 0)
+        return INT_MAX;
+
+    const uint8_t lyRegValue{m_memoryPtr->get(REGISTER_ADDR_LY, false)};
+    // The last cycle of a scanline increments LY, that is never idle
+    const int lastCycle{PPU_SCANLINE_TCYCLES-1};
+
+    if (lyRegValue < 144)
+    {
+        // Scanline 0 starts with the cycle that wraps LY, so mode 2 is only set in its 2nd cycle
+        const int mode2FirstIdleCycle{lyRegValue == 0 ? 2 : 1};
+
+        if (m_scanlineElapsed >= mode2FirstIdleCycle && m_scanlineElapsed < PPU_MODE_2_TCYCLES)
+            return PPU_MODE_2_TCYCLES-m_scanlineElapsed;
+        // Mode 3 is idle when the pixels of the line are drawn
+        if (m_scanlineElapsed > PPU_MODE_2_TCYCLES && m_scanlineElapsed < PPU_MODE_2_TCYCLES+PPU_MODE_3_TCYCLES
+                && m_xPos >= 160)
+            return PPU_MODE_2_TCYCLES+PPU_MODE_3_TCYCLES-m_scanlineElapsed;
+        if (m_scanlineElapsed > PPU_MODE_2_TCYCLES+PPU_MODE_3_TCYCLES && m_scanlineElapsed < lastCycle)
+            return lastCycle-m_scanlineElapsed;
+        return 0;
+    }
+
+    // In V-blank only the first cycle of a scanline does something
+    if (lyRegValue <= 153 && m_scanlineElapsed >= 1 && m_scanlineElapsed < lastCycle)
+        return lastCycle-m_scanlineElapsed;
+    return 0;
 }
 
 void PPU::updateBackground()
@@ -110,8 +237,7 @@ void PPU::updateBackground()
      * This sets the STAT bit in IF.
      */
     auto reqStatInterrupt = [this](){
-        const uint8_t ifVal = m_memoryPtr->get(REGISTER_ADDR_IF, false);
-        m_memoryPtr->set(REGISTER_ADDR_IF, ifVal | INTERRUPT_MASK_LCDCSTAT, false);
+        m_memoryPtr->requestInterrupt(INTERRUPT_MASK_LCDCSTAT);
     };
 
     if (lyRegValue < 144) // A normal scanline
@@ -142,7 +268,7 @@ void PPU::updateBackground()
             if (m_memoryPtr->get(REGISTER_ADDR_LCDSTAT, false) & STAT_BIT_MODE_2_INT_EN)
                 reqStatInterrupt();
 
-            // TODO: OAM scan, sprites are not supported yet
+            // The OAM scan is done when the first pixels are drawn, see updateLineSprites()
         }
         else if (m_scanlineElapsed < PPU_MODE_2_TCYCLES+PPU_MODE_3_TCYCLES) // The PPU is in mode 3
         {
@@ -151,25 +277,89 @@ void PPU::updateBackground()
                     (m_memoryPtr->get(REGISTER_ADDR_LCDSTAT, false) & ~STAT_MASK_PPU_MODE) | STAT_PPU_MODE_3_VAL,
                     false);
 
-            for (int i{}; i < 8 && m_xPos < 160; ++i)
+            const bool areSpritesEnabled{(lcdcRegValue & LCDC_BIT_OBJ_ENABLE) != 0};
+            const int spriteHeight{(lcdcRegValue & LCDC_BIT_OBJ_SIZE) ? 16 : 8};
+            if (areSpritesEnabled && !m_isFrameSkipped && (m_lineSpritesHeight != spriteHeight
+                        || m_lineSpritesOamVersion != m_memoryPtr->getOamVersion()))
+                updateLineSprites(spriteHeight);
+            const LineSprites &lineSprites{m_lineSprites[lyRegValue]};
+            const uint8_t *oam{m_memoryPtr->getOam().data()};
+
+            if (m_xPos < 160 && m_isFrameSkipped)
             {
-                const int screenx = m_xPos-scrollX;
-                const int screeny = lyRegValue-scrollY;
+                // Nothing is drawn, but the window line has to advance the same way
+                m_xPos = 160;
+                if (isWindowVisible(lcdcRegValue, lyRegValue))
+                    ++m_windowLine;
+            }
+            else if (m_xPos < 160)
+            {
+                const bool isWindowOnLine{isWindowVisible(lcdcRegValue, lyRegValue)};
+                // The window covers the line from WX-7 to the right edge
+                const int windowX{m_memoryPtr->get(REGISTER_ADDR_WX, false)-7};
+
+                // The pixels drawn in this cycle, 8 of the background,
+                // or the rest of the line if the window starts in them, so the window is one span
+                const int spanStart{m_xPos};
+                const int spanEnd{isWindowOnLine && windowX < m_xPos+8 ? 160 : std::min(m_xPos+8, 160)};
+                const int windowStart{isWindowOnLine ? std::clamp(windowX, spanStart, spanEnd) : spanEnd};
+                std::array<uint8_t, 160> bgColorIs;
+
+                if (lcdcRegValue & LCDC_BIT_BG_WIN_ENABLE)
+                {
+                    // The background, up to the window
+                    if (windowStart > spanStart)
+                        getTileMapSpan(bgColorIs.data(), bgTileMapStart, tileDataSelector,
+                                uint8_t(spanStart+scrollX), uint8_t(lyRegValue+scrollY), windowStart-spanStart);
+
+                    // The window, its lines are counted separately, so it continues where it stopped
+                    if (spanEnd > windowStart)
+                    {
+                        const uint16_t winTileMapStart{(lcdcRegValue & LCDC_BIT_WIN_TILE_MAP_AREA)
+                            ? (uint16_t)TILE_MAP_H_START : (uint16_t)TILE_MAP_L_START};
+                        getTileMapSpan(bgColorIs.data()+(windowStart-spanStart), winTileMapStart, tileDataSelector,
+                                uint8_t(windowStart-windowX), uint8_t(m_windowLine), spanEnd-windowStart);
+                        // The next line of the window is only drawn on the next line where the window is drawn
+                        ++m_windowLine;
+                    }
+                }
+                else
+                    std::fill_n(bgColorIs.data(), spanEnd-spanStart, 0);
 
-                if (screenx >= 0 && screenx < 160 && screeny >= 0 && screeny < 144) // Only render if visible
+                if (!m_arePalettesValid || m_palettesVersion != m_memoryPtr->getPaletteVersion())
+                    updatePalettes();
+
+                // The shades of the background and the window
+                std::array<uint8_t, 160> shades;
+                for (int i{}; i < spanEnd-spanStart; ++i)
+                    shades[i] = m_bgShades[bgColorIs[i]];
+
+                // Then the sprites are drawn over them pixel by pixel
+                for (; areSpritesEnabled && m_xPos < spanEnd; ++m_xPos)
                 {
-                    const uint8_t tileI = m_memoryPtr->get(
-                            bgTileMapStart+lyRegValue/TILE_SIZE*TILE_MAP_TILES_PER_ROW+m_xPos/8,
-                            false);
-                    const uint8_t colorI = getPixelColorIndex(tileI, m_xPos%8+lyRegValue%8*8, tileDataSelector);
-                    const SDL_Color color = mapIndexToColor(colorI);
-                    assert(m_texDataPtr);
-                    
-                    const Uint32 mappedColor = SDL_MapRGBA(m_texForm, color.r, color.g, color.b, 255);
-                    m_texDataPtr[screeny*m_texPitch/m_texForm->BytesPerPixel+screenx] = mappedColor;
+                    const uint8_t bgColorI{bgColorIs[m_xPos-spanStart]};
+                    for (int j{}; j < lineSprites.count; ++j)
+                    {
+                        const uint8_t *sprite{oam+lineSprites.oamIs[j]*OAM_SPRITE_SIZE};
+                        const int spriteX{m_xPos-(sprite[1]-8)};
+                        if (spriteX < 0 || spriteX >= TILE_SIZE)
+                            continue;
+
+                        const uint8_t spriteColorI{getSpritePixelColorIndex(
+                                sprite, spriteX, lyRegValue-(sprite[0]-16), spriteHeight)};
+                        // Color 0 is transparent, a sprite below can be visible
+                        if (spriteColorI == 0)
+                            continue;
+
+                        // The topmost opaque sprite decides, even if the background is drawn over it
+                        if (!((sprite[3] & OAM_ATTR_BIT_BG_OVER_OBJ) && bgColorI != 0))
+                            shades[m_xPos-spanStart] = ((sprite[3] & OAM_ATTR_BIT_PALETTE) ? m_obp1Shades : m_obp0Shades)[spriteColorI];
+                        break;
+                    }
                 }
+                m_xPos = spanEnd;
 
-                ++m_xPos;
+                drawPixels(spanStart, lyRegValue, shades.data(), spanEnd-spanStart);
             }
         }
         else if (m_scanlineElapsed
@@ -194,20 +384,25 @@ void PPU::updateBackground()
                 (m_memoryPtr->get(REGISTER_ADDR_LCDSTAT, false) & ~STAT_MASK_PPU_MODE) | STAT_PPU_MODE_1_VAL, false);
 
         // Call the V-blank interrupt
-        m_memoryPtr->set(REGISTER_ADDR_IF, m_memoryPtr->get(REGISTER_ADDR_IF, false) | INTERRUPT_MASK_VBLANK, false);
+        m_memoryPtr->requestInterrupt(INTERRUPT_MASK_VBLANK);
+
+        // The window starts from its first line in the next frame
+        m_windowLine = 0;
 
         // If the mode 1 STAT interrupt is enabled, request it
         if (m_memoryPtr->get(REGISTER_ADDR_LCDSTAT, false) & STAT_BIT_MODE_1_INT_EN)
             reqStatInterrupt();
 
-        SDL_UnlockTexture(m_texture);
-        SDL_RenderCopy(m_rendererPtr, m_texture, nullptr, nullptr);
-        SDL_LockTexture(m_texture, nullptr, (void**)&m_texDataPtr, &m_texPitch);
     }
     else if (lyRegValue > 153 && m_scanlineElapsed == 0) // End of V-BLANK
     {
         m_memoryPtr->set(REGISTER_ADDR_LY, 0, false);
         //Logger::info("V-Blank");
+
+        // Decide if the new frame is drawn
+        m_isFrameSkipped = m_skippedFramesInRow < m_frameSkip
+            || (m_isFrameSkipRequested && m_skippedFramesInRow < PPU_REQUESTED_SKIPS_MAX);
+        m_isFrameSkipRequested = false;
     }
 
     {
@@ -240,5 +435,20 @@ void PPU::updateBackground()
         m_scanlineElapsed = 0;
         m_memoryPtr->set(REGISTER_ADDR_LY, lyRegValue+1, false);
         m_xPos = 0;
+
+        // After the last visible line the frame is finished, the next one is drawn to the other buffer
+        if (lyRegValue+1 == 144 && m_isFrameSkipped)
+        {
+            ++m_skippedFrames;
+            ++m_skippedFramesInRow;
+        }
+        else if (lyRegValue+1 == 144)
+        {
+            ++m_renderedFrames;
+            m_skippedFramesInRow = 0;
+            m_drawnFrameI ^= 1;
+            if (m_frameReadyCallback)
+                m_frameReadyCallback(getFrame());
+        }
     }
 }
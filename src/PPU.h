@@ -6,7 +6,11 @@
 
 #include "Memory.h"
 
-#include <SDL2/SDL.h>
+#include <stdint.h>
+#include <vector>
+#include <array>
+#include <functional>
+#include <algorithm>
 
 #define PIXEL_SCALE 5
 #define TILE_DATA_UNSIGNED_START 0x8000
@@ -22,6 +26,16 @@
 #define TILE_MAP_DISPLAYED_TILES_PER_ROW 20
 #define TILE_MAP_DISPLAYED_TILES_PER_COL 18
 
+#define PPU_SCREEN_WIDTH  (TILE_MAP_DISPLAYED_TILES_PER_ROW*TILE_SIZE)
+#define PPU_SCREEN_HEIGHT (TILE_MAP_DISPLAYED_TILES_PER_COL*TILE_SIZE)
+
+// The length of a whole frame (154 scanlines) in T-cycles
+#define PPU_FRAME_TCYCLES (154*456)
+// The clock speed of the DMG in T-cycles
+#define DMG_CLOCK_HZ 4194304
+// At most this many frames are skipped in a row by requestFrameSkip()
+#define PPU_REQUESTED_SKIPS_MAX 4
+
 #define LCDC_BIT_BG_WIN_ENABLE         (1 << 0)
 #define LCDC_BIT_OBJ_ENABLE            (1 << 1)
 #define LCDC_BIT_OBJ_SIZE              (1 << 2)
@@ -31,20 +45,46 @@
 #define LCDC_BIT_WIN_TILE_MAP_AREA     (1 << 6)
 #define LCDC_BIT_LCD_PPU_ENABLE        (1 << 7)
 
-class PPU final
+#define OAM_SPRITE_COUNT 40
+#define OAM_SPRITE_SIZE 4
+// The PPU draws at most this many sprites in a scanline
+#define SPRITES_PER_LINE_MAX 10
+
+// Bits of the attribute byte of a sprite (byte 3 of its OAM entry)
+#define OAM_ATTR_BIT_PALETTE           (1 << 4)
+#define OAM_ATTR_BIT_X_FLIP            (1 << 5)
+#define OAM_ATTR_BIT_Y_FLIP            (1 << 6)
+#define OAM_ATTR_BIT_BG_OVER_OBJ       (1 << 7)
+
+// A color of a shade, the user interface converts it to its own type
+struct RgbaColor
 {
-private:
-    SDL_Renderer    *m_rendererPtr{nullptr};
-    Memory          *m_memoryPtr{nullptr};
+    uint8_t r{};
+    uint8_t g{};
+    uint8_t b{};
+    uint8_t a{0xff};
+};
 
-    SDL_Texture     *m_texture{};
-    int             m_texPitch{};
-    Uint32          *m_texDataPtr{};
-    SDL_PixelFormat *m_texForm{};
+// The 4 shades of the LCD, the palette registers map the color indices to these
+using ColorScheme = std::array<RgbaColor, 4>;
 
-    int m_xPos{};
-    int m_scanlineElapsed{};
+// The green shades of the original DMG, the default
+inline constexpr ColorScheme colorSchemeGreen{
+        RgbaColor{0x82, 0x78, 0x0d, 0xff},
+        RgbaColor{0x3a, 0x53, 0x36, 0xff},
+        RgbaColor{0x5c, 0x71, 0x22, 0xff},
+        RgbaColor{0x1c, 0x36, 0x28, 0xff},
+};
 
+inline constexpr ColorScheme colorSchemeGray{
+        RgbaColor{255, 255, 255, 0xff},
+        RgbaColor{200, 200, 200, 0xff},
+        RgbaColor{100, 100, 100, 0xff},
+        RgbaColor{  0,   0,   0, 0xff},
+};
+
+class PPU final
+{
 public:
     enum class TileDataSelector
     {
@@ -54,15 +94,155 @@ public:
         Signed,
     };
 
-    PPU(SDL_Renderer *renderer, Memory *memory);
+    /*
+     * A frame of PPU_SCREEN_WIDTH x PPU_SCREEN_HEIGHT pixels, row by row.
+     * `shades` has the shade of each pixel (an index to the ColorScheme) in 2 bits,
+     * 4 pixels per byte with the leftmost one in the highest bits.
+     * `pixels` has the same frame in the colors of the ColorScheme, 4 bytes per pixel in R, G, B, A order.
+     */
+    struct Frame
+    {
+        std::vector<uint8_t>    shades;
+        std::vector<uint32_t>   pixels;
+    };
+    // Called at the start of V-blank with the finished frame
+    using FrameReadyCallback = std::function<void(const Frame &frame)>;
+
+private:
+    Memory          *m_memoryPtr{nullptr};
+
+    // The frame that is being drawn and the last finished one, they are swapped at the start of V-blank
+    std::array<Frame, 2> m_frames;
+    int m_drawnFrameI{};
+    FrameReadyCallback m_frameReadyCallback;
+
+    int m_xPos{};
+    int m_scanlineElapsed{};
+    ColorScheme m_colorScheme{};
+    // The colors of the ColorScheme in the format of Frame::pixels
+    std::array<uint32_t, 4> m_shadePixels{};
+    /*
+     * The shade of each color index with BGP, OBP0 and OBP1, so drawing a pixel is a lookup.
+     * They are only computed again when a palette register is written.
+     */
+    std::array<uint8_t, 4> m_bgShades{};
+    std::array<uint8_t, 4> m_obp0Shades{};
+    std::array<uint8_t, 4> m_obp1Shades{};
+    // Memory::getPaletteVersion() when the shades were computed
+    unsigned m_palettesVersion{};
+    bool m_arePalettesValid{};
+
+    // Frame skipping, see setFrameSkip()
+    int m_frameSkip{};
+    bool m_isFrameSkipRequested{};
+    // Set if the pixels of the current frame are not drawn
+    bool m_isFrameSkipped{};
+    int m_skippedFramesInRow{};
+    unsigned long m_renderedFrames{};
+    unsigned long m_skippedFrames{};
+
+    // The line of the window that is drawn next, it only advances on the scanlines where the window is drawn
+    int m_windowLine{};
+
+    // The sprites of a scanline as OAM indices, in priority order
+    struct LineSprites
+    {
+        int                                         count{};
+        std::array<uint8_t, SPRITES_PER_LINE_MAX>   oamIs{};
+    };
+    /*
+     * The sprites selected for each scanline.
+     * Selecting them needs all 40 OAM entries, so they are only selected again
+     * when the OAM or the sprite size changes, not in every mode 2.
+     */
+    std::array<LineSprites, 144> m_lineSprites{};
+    // Memory::getOamVersion() and the sprite height when m_lineSprites was built, 0 height means never
+    unsigned m_lineSpritesOamVersion{};
+    int m_lineSpritesHeight{};
+
+    /*
+     * Writes the color indices of `count` pixels of a row of a tile map (the background or the window)
+     * to `output`, starting at (`mapX`, `mapY`). It wraps around at the right edge of the map.
+     */
+    void getTileMapSpan(uint8_t *output, uint16_t tileMapStart, TileDataSelector tileDataSelector,
+            uint8_t mapX, uint8_t mapY, int count) const;
+    // Returns true if the window is drawn on the scanline: it and LCDC bit 0 are enabled and it covers a part of it
+    bool isWindowVisible(uint8_t lcdcRegValue, uint8_t lyRegValue) const;
+
+    // Returns the index of a tile in the TileCache
+    static int getTileDataIndex(uint8_t tileI, TileDataSelector tileDataSelector);
+
+    void updatePalettes();
+    // Writes the shades of `count` pixels from (`x`, `y`) to the drawn frame
+    void drawPixels(int x, int y, const uint8_t *shades, int count);
+    // Computes Frame::pixels from Frame::shades in both frames
+    void updateFramePixels();
+    void updateLineSprites(int spriteHeight);
+    // Returns the color index of the sprite at (`x`, `y`), 0 if it is transparent there
+    uint8_t getSpritePixelColorIndex(const uint8_t *sprite, int x, int y, int spriteHeight) const;
+
+public:
+    // The frames are only drawn to buffers, read them with `getFrame()` or in a FrameReadyCallback
+    PPU(Memory *memory);
 
     uint8_t getPixelColorIndex(uint8_t tileI, int tilePixelI, TileDataSelector bgDataSelector) const;
     uint8_t getPixelColorIndexFlat(uint tileI, int tilePixelI) const;
-    SDL_Color mapIndexToColor(uint8_t index);
+    // `paletteRegAddr` is the address of BGP, OBP0 or OBP1
+    RgbaColor mapIndexToColor(uint8_t index, uint16_t paletteRegAddr=REGISTER_ADDR_BGP) const;
+
+    // Sets the shades of the LCD, used from the next drawn pixel
+    void setColorScheme(const ColorScheme &colorScheme);
 
     inline bool isScanlineStart() const { return m_scanlineElapsed == 0; }
 
+    // The last finished frame, it is valid until the next one is finished
+    inline const Frame& getFrame() const { return m_frames[m_drawnFrameI^1]; }
+    // The pixels of the last finished frame, `getPixelPitch()` bytes per row
+    inline const uint32_t* getPixelData() const { return getFrame().pixels.data(); }
+    inline int getPixelPitch() const { return PPU_SCREEN_WIDTH*sizeof(uint32_t); }
+    // `callback` is called when a frame is finished, it can be empty
+    inline void setFrameReadyCallback(const FrameReadyCallback &callback) { m_frameReadyCallback = callback; }
+
+    /*
+     * Only every `frameSkip+1`th frame is drawn. In the skipped frames the modes, LY and the interrupts
+     * are the same, but no pixels are fetched or drawn, the last drawn frame stays in getFrame()
+     * and the FrameReadyCallback is not called.
+     */
+    inline void setFrameSkip(int frameSkip) { m_frameSkip = std::max(frameSkip, 0); }
+    // Skips the next frame too, for example when the emulation is behind the real time
+    inline void requestFrameSkip() { m_isFrameSkipRequested = true; }
+    inline unsigned long getRenderedFrames() const { return m_renderedFrames; }
+    inline unsigned long getSkippedFrames() const { return m_skippedFrames; }
+
     void updateBackground();
+
+    /*
+     * Returns how many of the next `updateBackground()` calls would only repeat the previous one,
+     * setting the same mode and requesting the same interrupts.
+     * Those can be replaced by `skipIdleCycles()`. INT_MAX if the LCD is off.
+     */
+    int getIdleCycles() const;
+    // Skips `tCycles` T-cycles, at most `getIdleCycles()`
+    inline void skipIdleCycles(int tCycles)
+    {
+        if (m_memoryPtr->get(REGISTER_ADDR_LCDC, false) & LCDC_BIT_LCD_PPU_ENABLE)
+            m_scanlineElapsed += tCycles;
+    }
+
+    // Passes the state to `stream`, see StateStream.h
+    template <class Stream>
+    void serializeState(Stream &stream)
+    {
+        stream.value(m_xPos);
+        stream.value(m_scanlineElapsed);
+        stream.value(m_windowLine);
+        stream.value(m_drawnFrameI);
+        for (Frame &frame : m_frames)
+            stream.vector(frame.shades);
+        // The pixels are computed from the shades, so they are not saved
+        if (stream.isLoading())
+            updateFramePixels();
+    }
 };
 
 #endif // PPU_H
@@ -6,9 +6,19 @@
 #include "common.h"
 #include "Logger.h"
 #include "string_formatting.h"
+#include "bit_magic.h"
 
 #include <stdint.h>
 
+// Log every register write. This slows down the emulation a lot.
+//#define LOG_REGISTER_WRITES
+
+#ifdef LOG_REGISTER_WRITES
+#define LOG_REGISTER_WRITE(name, value) Logger::info("Value of register " name " set to: " + toHexStr(value))
+#else
+#define LOG_REGISTER_WRITE(name, value) do {} while (0)
+#endif
+
 #define CPU_FLAG_SHIFT_ZERO   (7)
 #define CPU_FLAG_SHIFT_NEG    (6)
 #define CPU_FLAG_SHIFT_HCARRY (5)
@@ -46,6 +56,74 @@ public:
     enum class r16{AF, BC, DE, HL, SP, PC};
     enum class cond{Z, NZ, C, NC};
 
+    // The 8-bit ALU operations whose flags can be computed later
+    enum class FlagOp : uint8_t
+    {
+        None,   // F is up to date
+        Add,    // Z0HC
+        Sub,    // Z1HC
+        And,    // Z010
+        Or,     // Z000, also for XOR
+        Inc,    // Z0H-
+        Dec,    // Z1H-
+    };
+
+private:
+    /*
+     * Lazy flags: most flags are overwritten before anything reads them,
+     * so an ALU operation only saves its operands and result, and F is computed from them when it is read.
+     * For INC and DEC, `m_flagOperand2` is the carry flag before the operation.
+     */
+    FlagOp      m_flagOp{FlagOp::None};
+    uint8_t     m_flagOperand1{};
+    uint8_t     m_flagOperand2{};
+    uint8_t     m_flagResult{};
+    // Compute F right after every ALU operation, only for measuring the lazy flags, see --cpu-benchmark
+    bool        m_isEagerFlags{};
+
+    uint8_t computeFlags() const
+    {
+        const uint8_t zeroFlag{(uint8_t)(m_flagResult == 0 ? CPU_FLAG_BIT_ZERO : 0)};
+        switch (m_flagOp)
+        {
+        case FlagOp::None:
+            return m_F;
+        case FlagOp::Add:
+            return zeroFlag
+                | (wouldAddHalfCarry8(m_flagOperand1, m_flagOperand2) << CPU_FLAG_SHIFT_HCARRY)
+                | (wouldAddCarry8(m_flagOperand1, m_flagOperand2) << CPU_FLAG_SHIFT_CARRY);
+        case FlagOp::Sub:
+            return zeroFlag | CPU_FLAG_BIT_NEG
+                | (wouldSubHalfCarry8(m_flagOperand1, m_flagOperand2) << CPU_FLAG_SHIFT_HCARRY)
+                | (wouldSubCarry8(m_flagOperand1, m_flagOperand2) << CPU_FLAG_SHIFT_CARRY);
+        case FlagOp::And:
+            return zeroFlag | CPU_FLAG_BIT_HCARRY;
+        case FlagOp::Or:
+            return zeroFlag;
+        case FlagOp::Inc:
+            return zeroFlag
+                | (wouldAddHalfCarry8(m_flagOperand1, 1) << CPU_FLAG_SHIFT_HCARRY)
+                | (m_flagOperand2 << CPU_FLAG_SHIFT_CARRY);
+        case FlagOp::Dec:
+            return zeroFlag | CPU_FLAG_BIT_NEG
+                | (wouldSubHalfCarry8(m_flagOperand1, 1) << CPU_FLAG_SHIFT_HCARRY)
+                | (m_flagOperand2 << CPU_FLAG_SHIFT_CARRY);
+        default: IMPOSSIBLE();
+        }
+    }
+
+    // Stores the lazy flags to F, so single flags can be changed
+    inline void materializeFlags()
+    {
+        if (m_flagOp != FlagOp::None)
+        {
+            m_F = computeFlags();
+            m_flagOp = FlagOp::None;
+        }
+    }
+
+public:
+
     Registers();
 
     // --- 8-bit registers ---
@@ -56,7 +134,7 @@ public:
     inline uint8_t getC() const         { return m_C; Logger::info("Value of register C got"); }
     inline uint8_t getD() const         { return m_D; Logger::info("Value of register D got"); }
     inline uint8_t getE() const         { return m_E; Logger::info("Value of register E got"); }
-    inline uint8_t getF() const         { return m_F; Logger::info("Value of register F got"); }
+    inline uint8_t getF() const         { return computeFlags(); Logger::info("Value of register F got"); }
     inline uint8_t getH() const         { return m_H; Logger::info("Value of register H got"); }
     inline uint8_t getL() const         { return m_L; Logger::info("Value of register L got"); }
 
@@ -77,14 +155,14 @@ public:
     }
 
     // -- set --
-    inline void setA(uint8_t value)     { m_A = value; Logger::info("Value of register A set to: " + toHexStr(value)); }
-    inline void setB(uint8_t value)     { m_B = value; Logger::info("Value of register B set to: " + toHexStr(value)); }
-    inline void setC(uint8_t value)     { m_C = value; Logger::info("Value of register C set to: " + toHexStr(value)); }
-    inline void setD(uint8_t value)     { m_D = value; Logger::info("Value of register D set to: " + toHexStr(value)); }
-    inline void setE(uint8_t value)     { m_E = value; Logger::info("Value of register E set to: " + toHexStr(value)); }
-    inline void setF(uint8_t value)     { m_F = value; resetFlagRegisterLowerBits(); Logger::info("Value of register F set to: " + toHexStr(value)); }
-    inline void setH(uint8_t value)     { m_H = value; Logger::info("Value of register H set to: " + toHexStr(value)); }
-    inline void setL(uint8_t value)     { m_L = value; Logger::info("Value of register L set to: " + toHexStr(value)); }
+    inline void setA(uint8_t value)     { m_A = value; LOG_REGISTER_WRITE("A", value); }
+    inline void setB(uint8_t value)     { m_B = value; LOG_REGISTER_WRITE("B", value); }
+    inline void setC(uint8_t value)     { m_C = value; LOG_REGISTER_WRITE("C", value); }
+    inline void setD(uint8_t value)     { m_D = value; LOG_REGISTER_WRITE("D", value); }
+    inline void setE(uint8_t value)     { m_E = value; LOG_REGISTER_WRITE("E", value); }
+    inline void setF(uint8_t value)     { m_flagOp = FlagOp::None; m_F = value; resetFlagRegisterLowerBits(); LOG_REGISTER_WRITE("F", value); }
+    inline void setH(uint8_t value)     { m_H = value; LOG_REGISTER_WRITE("H", value); }
+    inline void setL(uint8_t value)     { m_L = value; LOG_REGISTER_WRITE("L", value); }
 
     inline void set8(r8 reg, uint8_t value)
     {
@@ -107,7 +185,7 @@ public:
 
     // -- get --
     inline uint16_t getAF() const       { return (uint16_t)m_A << 8 |
-                                                 (uint16_t)m_F;         }
+                                                 (uint16_t)getF();      }
     inline uint16_t getBC() const       { return (uint16_t)m_B << 8 |
                                                  (uint16_t)m_C;         }
     inline uint16_t getDE() const       { return (uint16_t)m_D << 8 |
@@ -133,7 +211,7 @@ public:
 
     // -- set --
     inline void setAF(uint16_t value)   { m_A = value >> 8;
-                                          m_F =  value & 0x00ff; resetFlagRegisterLowerBits(); }
+                                          setF(value & 0x00ff);         }
     inline void setBC(uint16_t value)   { m_B = value >> 8;
                                           m_C =  value & 0x00ff;        }
     inline void setDE(uint16_t value)   { m_D = value >> 8;
@@ -174,10 +252,27 @@ public:
     inline void resetFlagRegisterLowerBits() { m_F &= 0xf0; }
 
     // -- get --
-    inline uint8_t getZeroFlag()      const { return (m_F & CPU_FLAG_BIT_ZERO)   >> CPU_FLAG_SHIFT_ZERO;   }
-    inline uint8_t getNegativeFlag()  const { return (m_F & CPU_FLAG_BIT_NEG)    >> CPU_FLAG_SHIFT_NEG;    }
-    inline uint8_t getHalfCarryFlag() const { return (m_F & CPU_FLAG_BIT_HCARRY) >> CPU_FLAG_SHIFT_HCARRY; }
-    inline uint8_t getCarryFlag()     const { return (m_F & CPU_FLAG_BIT_CARRY)  >> CPU_FLAG_SHIFT_CARRY;  }
+    // Z is the same for every lazy operation, so it is not computed through computeFlags()
+    inline uint8_t getZeroFlag()      const { return m_flagOp == FlagOp::None
+                                                ? (m_F & CPU_FLAG_BIT_ZERO) >> CPU_FLAG_SHIFT_ZERO
+                                                : m_flagResult == 0;                                                  }
+    inline uint8_t getNegativeFlag()  const { return (getF() & CPU_FLAG_BIT_NEG)    >> CPU_FLAG_SHIFT_NEG;    }
+    inline uint8_t getHalfCarryFlag() const { return (getF() & CPU_FLAG_BIT_HCARRY) >> CPU_FLAG_SHIFT_HCARRY; }
+    // The carry is read by INC, DEC and the conditions, so it is computed without the other flags
+    inline uint8_t getCarryFlag()     const
+    {
+        switch (m_flagOp)
+        {
+        case FlagOp::None: return (m_F & CPU_FLAG_BIT_CARRY) >> CPU_FLAG_SHIFT_CARRY;
+        case FlagOp::Add:  return wouldAddCarry8(m_flagOperand1, m_flagOperand2);
+        case FlagOp::Sub:  return wouldSubCarry8(m_flagOperand1, m_flagOperand2);
+        case FlagOp::And:
+        case FlagOp::Or:   return 0;
+        case FlagOp::Inc:
+        case FlagOp::Dec:  return m_flagOperand2;
+        default: IMPOSSIBLE();
+        }
+    }
 
     inline uint8_t getCondition(cond c)
     {
@@ -192,16 +287,16 @@ public:
     }
 
     // -- set --
-    inline void setZeroFlag()      { m_F |= CPU_FLAG_BIT_ZERO;   }
-    inline void setNegativeFlag()  { m_F |= CPU_FLAG_BIT_NEG;    }
-    inline void setHalfCarryFlag() { m_F |= CPU_FLAG_BIT_HCARRY; }
-    inline void setCarryFlag()     { m_F |= CPU_FLAG_BIT_CARRY;  }
+    inline void setZeroFlag()      { materializeFlags(); m_F |= CPU_FLAG_BIT_ZERO;   }
+    inline void setNegativeFlag()  { materializeFlags(); m_F |= CPU_FLAG_BIT_NEG;    }
+    inline void setHalfCarryFlag() { materializeFlags(); m_F |= CPU_FLAG_BIT_HCARRY; }
+    inline void setCarryFlag()     { materializeFlags(); m_F |= CPU_FLAG_BIT_CARRY;  }
 
     // unset
-    inline void unsetZeroFlag()      { m_F &= ~CPU_FLAG_BIT_ZERO;   }
-    inline void unsetNegativeFlag()  { m_F &= ~CPU_FLAG_BIT_NEG;    }
-    inline void unsetHalfCarryFlag() { m_F &= ~CPU_FLAG_BIT_HCARRY; }
-    inline void unsetCarryFlag()     { m_F &= ~CPU_FLAG_BIT_CARRY;  }
+    inline void unsetZeroFlag()      { materializeFlags(); m_F &= ~CPU_FLAG_BIT_ZERO;   }
+    inline void unsetNegativeFlag()  { materializeFlags(); m_F &= ~CPU_FLAG_BIT_NEG;    }
+    inline void unsetHalfCarryFlag() { materializeFlags(); m_F &= ~CPU_FLAG_BIT_HCARRY; }
+    inline void unsetCarryFlag()     { materializeFlags(); m_F &= ~CPU_FLAG_BIT_CARRY;  }
 
     // set depending on the argument
     inline void setZeroFlag(uint8_t value)       { value ? setZeroFlag()      : unsetZeroFlag();      }
@@ -209,6 +304,27 @@ public:
     inline void setHalfCarryFlag(uint8_t value)  { value ? setHalfCarryFlag() : unsetHalfCarryFlag(); }
     inline void setCarryFlag(uint8_t value)      { value ? setCarryFlag()     : unsetCarryFlag();     }
 
+    /*
+     * Sets all the flags of an 8-bit ALU operation, they are computed when they are read.
+     * `operand1` and `operand2` are the operands (for INC and DEC: the register and the carry flag before),
+     * `result` is the 8-bit result.
+     */
+    inline void setFlagsLazily(FlagOp op, uint8_t operand1, uint8_t operand2, uint8_t result)
+    {
+        m_flagOp = op;
+        m_flagOperand1 = operand1;
+        m_flagOperand2 = operand2;
+        m_flagResult = result;
+        if (m_isEagerFlags)
+            materializeFlags();
+    }
+
+    /*
+     * If enabled, F is computed right after every ALU operation instead of when it is read.
+     * The result is the same, this is for measuring the speed of the lazy flags.
+     */
+    inline void setEagerFlags(bool isEnabled) { materializeFlags(); m_isEagerFlags = isEnabled; }
+
 
     // --- misc. registers ---
 
@@ -221,6 +337,25 @@ public:
 
     // -- unset --
     inline void unsetIme() { m_ime = false; }
+
+    // Passes the state to `stream`, see StateStream.h
+    template <class Stream>
+    void serializeState(Stream &stream)
+    {
+        stream.value(m_A);
+        stream.value(m_B);
+        stream.value(m_C);
+        stream.value(m_D);
+        stream.value(m_E);
+        // Only F is saved, it is computed if it is lazy
+        materializeFlags();
+        stream.value(m_F);
+        stream.value(m_H);
+        stream.value(m_L);
+        stream.value(m_SP);
+        stream.value(m_PC);
+        stream.value(m_ime);
+    }
 };
 
 
@@ -27,6 +27,7 @@ public:
 
     inline void write(const std::string string) { m_buffer += string; }
     inline void write(char character) { if (character) m_buffer += character; }
+    inline void setText(const std::string &text) { m_buffer = text; }
 
     inline void show() { SDL_ShowWindow(m_window); }
     inline void hide() { SDL_HideWindow(m_window); }
@@ -0,0 +1,143 @@
+#ifndef STATESTREAM_H_
+#define STATESTREAM_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <cstring>
+#include <vector>
+#include <type_traits>
+
+/*
+ * Streams used to save and load the state of a machine.
+ *
+ * A component has one `serializeState(Stream&)` template method that passes
+ * every field to `stream.value()`, so the fields are listed only once
+ * and the same method measures, saves and loads the state.
+ * What has to be recomputed from the loaded fields is done only if `stream.isLoading()`.
+ * The values are stored in the native byte order, with no padding.
+ */
+
+// Counts the size of the state
+class StateSizer final
+{
+private:
+    size_t m_size{};
+
+public:
+    template <typename T>
+    inline void value(const T&)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Only plain values can be saved");
+        m_size += sizeof(T);
+    }
+
+    template <typename T>
+    inline void vector(const std::vector<T> &vec)
+    {
+        value(vec.size());
+        m_size += vec.size()*sizeof(T);
+    }
+
+    inline size_t getSize() const { return m_size; }
+    static constexpr bool isLoading() { return false; }
+};
+
+// Writes the state to a buffer
+class StateWriter final
+{
+private:
+    uint8_t *m_buffer{};
+    size_t  m_bufferSize{};
+    size_t  m_pos{};
+    bool    m_isFailed{};
+
+    inline void write(const void *data, size_t size)
+    {
+        if (m_isFailed || m_pos+size > m_bufferSize)
+        {
+            m_isFailed = true;
+            return;
+        }
+        std::memcpy(m_buffer+m_pos, data, size);
+        m_pos += size;
+    }
+
+public:
+    StateWriter(uint8_t *buffer, size_t bufferSize)
+        : m_buffer{buffer}, m_bufferSize{bufferSize}
+    {
+    }
+
+    template <typename T>
+    inline void value(const T &val)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Only plain values can be saved");
+        write(&val, sizeof(T));
+    }
+
+    template <typename T>
+    inline void vector(const std::vector<T> &vec)
+    {
+        value(vec.size());
+        write(vec.data(), vec.size()*sizeof(T));
+    }
+
+    // Set if the buffer was too small
+    inline bool isFailed() const { return m_isFailed; }
+    static constexpr bool isLoading() { return false; }
+};
+
+// Reads the state from a buffer
+class StateReader final
+{
+private:
+    const uint8_t   *m_buffer{};
+    size_t          m_bufferSize{};
+    size_t          m_pos{};
+    bool            m_isFailed{};
+
+    inline void read(void *data, size_t size)
+    {
+        if (m_isFailed || m_pos+size > m_bufferSize)
+        {
+            m_isFailed = true;
+            return;
+        }
+        std::memcpy(data, m_buffer+m_pos, size);
+        m_pos += size;
+    }
+
+public:
+    StateReader(const uint8_t *buffer, size_t bufferSize)
+        : m_buffer{buffer}, m_bufferSize{bufferSize}
+    {
+    }
+
+    template <typename T>
+    inline void value(T &val)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Only plain values can be loaded");
+        read(&val, sizeof(T));
+    }
+
+    // The size of the vector is not changed, the saved size has to match it
+    template <typename T>
+    inline void vector(std::vector<T> &vec)
+    {
+        size_t size{};
+        value(size);
+        if (size != vec.size())
+        {
+            m_isFailed = true;
+            return;
+        }
+        read(vec.data(), vec.size()*sizeof(T));
+    }
+
+    // Set if the buffer was too small or did not match the machine
+    inline bool isFailed() const { return m_isFailed; }
+    inline bool isAtEnd() const { return m_pos == m_bufferSize; }
+    static constexpr bool isLoading() { return true; }
+};
+
+#endif /* STATESTREAM_H_ */
@@ -0,0 +1,247 @@
+#include "TestRunner.h"
+
+#include "GBMachine.h"
+#include "Logger.h"
+#include "string_formatting.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+std::string TestRunner::statusEnumToStr(Status status)
+{
+    switch (status)
+    {
+    case Status::Passed:  return "passed";
+    case Status::Failed:  return "failed";
+    case Status::Timeout: return "timeout";
+    case Status::Skipped: return "skipped";
+    }
+    IMPOSSIBLE();
+    return "";
+}
+
+TestRunner::TestRunner(const std::string &romDir, unsigned long maxFrames, int jobCount/*=0*/)
+    : m_maxFrames{maxFrames}, m_jobCount{jobCount}
+{
+    namespace fs = std::filesystem;
+
+    std::error_code error;
+    for (const fs::directory_entry &entry : fs::directory_iterator{romDir, error})
+    {
+        const std::string extension{entry.path().extension().string()};
+        if (entry.is_regular_file() && (extension == ".gb" || extension == ".gbc"))
+        {
+            Result result;
+            result.romPath = entry.path().string();
+            m_results.push_back(result);
+        }
+    }
+    if (error)
+        Logger::fatal("Failed to list test ROM directory: "+romDir+"\nReason: "+error.message());
+
+    std::sort(m_results.begin(), m_results.end(),
+            [](const Result &a, const Result &b){ return a.romPath < b.romPath; });
+
+    if (m_jobCount <= 0)
+        m_jobCount = std::max(1u, std::thread::hardware_concurrency());
+}
+
+void TestRunner::runRom(Result *result, unsigned long maxFrames)
+{
+    namespace chr = std::chrono;
+
+    const auto startTime{chr::steady_clock::now()};
+
+    // A broken ROM fails only its own test, the cartridge reader would exit the whole runner
+    std::ifstream romFile{result->romPath, std::ios::binary};
+    const std::vector<uint8_t> romData{std::istreambuf_iterator<char>{romFile}, std::istreambuf_iterator<char>{}};
+    std::string error;
+    if (romFile.fail() && !romFile.eof())
+        error = "Failed to read ROM file";
+    if (error.empty() && !CartridgeReader::checkHeader(romData.data(), romData.size(), &error))
+        error = "Invalid ROM: "+error;
+    if (!error.empty())
+    {
+        result->status = Status::Failed;
+        result->message = error;
+        return;
+    }
+
+    GBMachine machine{romData.data(), romData.size()};
+    if (machine.getCartridgeInfo()->isCGBOnly)
+    {
+        result->status = Status::Skipped;
+        result->message = "CGB only";
+        return;
+    }
+
+    const std::string &serialOutput{machine.getMemory()->getSerialOutput()};
+
+    result->status = Status::Timeout;
+    while (machine.getFramesDone() < maxFrames)
+    {
+        // There is no input, so a stopped machine would never wake up or finish a frame
+        if (!machine.emulateFrame())
+        {
+            result->message = "Stopped, there is no input to wake it up";
+            break;
+        }
+
+        if (serialOutput.find("Passed") != serialOutput.npos)
+        {
+            result->status = Status::Passed;
+            break;
+        }
+        if (serialOutput.find("Failed") != serialOutput.npos)
+        {
+            result->status = Status::Failed;
+            break;
+        }
+    }
+
+    result->seconds = chr::duration<double>(chr::steady_clock::now()-startTime).count();
+    result->frames = machine.getFramesDone();
+    result->serialOutput = serialOutput;
+}
+
+void TestRunner::run()
+{
+    // Every thread takes the next ROM that is not taken yet
+    std::atomic<size_t> nextRomI{};
+    auto worker{[this, &nextRomI](){
+        size_t romI{};
+        while ((romI = nextRomI++) < m_results.size())
+            runRom(&m_results[romI], m_maxFrames);
+    }};
+
+    const int threadCount{std::min(m_jobCount, (int)m_results.size())};
+    std::vector<std::thread> threads;
+    for (int i{}; i < threadCount; ++i)
+        threads.emplace_back(worker);
+    for (std::thread &thread : threads)
+        thread.join();
+}
+
+int TestRunner::getFailedCount() const
+{
+    return (int)std::count_if(m_results.begin(), m_results.end(),
+            [](const Result &result){
+                return result.status == Status::Failed || result.status == Status::Timeout; });
+}
+
+static std::string escapeJson(const std::string &str)
+{
+    std::string output;
+    for (const char c : str)
+    {
+        switch (c)
+        {
+        case '"':  output += "\\\""; break;
+        case '\\': output += "\\\\"; break;
+        case '\n': output += "\\n";  break;
+        case '\r': output += "\\r";  break;
+        case '\t': output += "\\t";  break;
+        default:
+            if ((unsigned char)c < 0x20 || (unsigned char)c >= 0x7f)
+                output += "\\u00"+toHexStr((uint8_t)c, 2, false);
+            else
+                output += c;
+        }
+    }
+    return output;
+}
+
+static std::string escapeXml(const std::string &str)
+{
+    std::string output;
+    for (const char c : str)
+    {
+        switch (c)
+        {
+        case '<':  output += "&lt;";   break;
+        case '>':  output += "&gt;";   break;
+        case '&':  output += "&amp;";  break;
+        case '"':  output += "&quot;"; break;
+        case '\'': output += "&apos;"; break;
+        default:
+            // Control characters are not allowed in XML 1.0
+            if (((unsigned char)c < 0x20 && c != '\n' && c != '\r' && c != '\t') || (unsigned char)c >= 0x7f)
+                output += '?';
+            else
+                output += c;
+        }
+    }
+    return output;
+}
+
+void TestRunner::writeJson(std::ostream &stream) const
+{
+    stream << "{\n  \"results\": [\n";
+    for (size_t i{}; i < m_results.size(); ++i)
+    {
+        const Result &result{m_results[i]};
+        stream << "    {"
+            << "\"rom\": \"" << escapeJson(result.romPath) << "\", "
+            << "\"status\": \"" << statusEnumToStr(result.status) << "\", "
+            << "\"seconds\": " << result.seconds << ", "
+            << "\"frames\": " << result.frames << ", "
+            << "\"serial\": \"" << escapeJson(result.serialOutput) << "\", "
+            << "\"message\": \"" << escapeJson(result.message) << "\"}"
+            << (i+1 < m_results.size() ? ",\n" : "\n");
+    }
+    stream << "  ],\n"
+        << "  \"total\": " << m_results.size() << ",\n"
+        << "  \"failed\": " << getFailedCount() << "\n"
+        << "}\n";
+}
+
+void TestRunner::writeJUnit(std::ostream &stream) const
+{
+    double totalSeconds{};
+    int skippedCount{};
+    for (const Result &result : m_results)
+    {
+        totalSeconds += result.seconds;
+        skippedCount += (result.status == Status::Skipped);
+    }
+
+    stream << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        << "<testsuite name=\"gb-emu\" tests=\"" << m_results.size()
+        << "\" failures=\"" << getFailedCount()
+        << "\" skipped=\"" << skippedCount
+        << "\" time=\"" << totalSeconds << "\">\n";
+    for (const Result &result : m_results)
+    {
+        const std::string name{std::filesystem::path{result.romPath}.filename().string()};
+        stream << "  <testcase classname=\"gb-emu\" name=\"" << escapeXml(name)
+            << "\" time=\"" << result.seconds << "\">\n";
+        switch (result.status)
+        {
+        case Status::Passed:
+            break;
+        case Status::Failed:
+            stream << "    <failure message=\""
+                << (result.message.empty() ? "ROM reported failure" : escapeXml(result.message)) << "\"/>\n";
+            break;
+        case Status::Timeout:
+            stream << "    <failure message=\"";
+            if (result.message.empty())
+                stream << "No result after " << result.frames << " frames";
+            else
+                stream << escapeXml(result.message);
+            stream << "\"/>\n";
+            break;
+        case Status::Skipped:
+            stream << "    <skipped message=\"" << escapeXml(result.message) << "\"/>\n";
+            break;
+        }
+        stream << "    <system-out>" << escapeXml(result.serialOutput) << "</system-out>\n"
+            << "  </testcase>\n";
+    }
+    stream << "</testsuite>\n";
+}
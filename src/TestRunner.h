@@ -0,0 +1,68 @@
+#ifndef TESTRUNNER_H
+#define TESTRUNNER_H
+
+#include "config.h"
+#include "common.h"
+
+#include <string>
+#include <vector>
+#include <ostream>
+
+/*
+ * Runs test ROMs (like Blargg's cpu_instrs) headless, in parallel.
+ *
+ * The test ROMs report their results on the serial port,
+ * a ROM is stopped as soon as its output contains "Passed" or "Failed".
+ */
+class TestRunner final
+{
+public:
+    enum class Status
+    {
+        Passed,
+        Failed,
+        // The ROM did not report a result in time
+        Timeout,
+        // The ROM cannot be run (CGB only)
+        Skipped,
+    };
+
+    struct Result
+    {
+        std::string     romPath;
+        Status          status{Status::Timeout};
+        double          seconds{};
+        unsigned long   frames{};
+        std::string     serialOutput;
+        // Why the ROM was not run, empty if it was
+        std::string     message;
+    };
+
+    static std::string statusEnumToStr(Status status);
+
+private:
+    std::vector<Result> m_results;
+    unsigned long       m_maxFrames{};
+    int                 m_jobCount{};
+
+    static void runRom(Result *result, unsigned long maxFrames);
+
+public:
+    /*
+     * Collects the .gb and .gbc files in `romDir`.
+     * A ROM times out after `maxFrames` frames.
+     * If `jobCount` is 0, a thread is started for each CPU core.
+     */
+    TestRunner(const std::string &romDir, unsigned long maxFrames, int jobCount=0);
+
+    void run();
+
+    inline const std::vector<Result>& getResults() const { return m_results; }
+    // The number of ROMs that did not pass (skipped ones are not counted)
+    int getFailedCount() const;
+
+    void writeJson(std::ostream &stream) const;
+    void writeJUnit(std::ostream &stream) const;
+};
+
+#endif // TESTRUNNER_H
@@ -0,0 +1,15 @@
+#include "TileCache.h"
+#include "tile_decoder.h"
+
+TileCache::TileCache(const uint8_t *tileData)
+    : m_tileDataPtr{tileData}
+{
+    // Nothing is decoded yet
+    invalidateAll();
+}
+
+void TileCache::decodeTile(int tileI)
+{
+    ::decodeTile(m_tileDataPtr+tileI*TILE_CACHE_TILE_BYTES, m_tiles[tileI].data());
+    m_isTileDirty[tileI] = false;
+}
@@ -0,0 +1,47 @@
+#ifndef TILE_CACHE_H_
+#define TILE_CACHE_H_
+
+#include <stdint.h>
+#include <array>
+#include <bitset>
+
+// The tiles in the tile data area of the VRAM (0x8000-0x97ff)
+#define TILE_CACHE_TILE_COUNT 384
+// The size of a tile in the VRAM, 2 bytes per row
+#define TILE_CACHE_TILE_BYTES 16
+
+/*
+ * The tiles of the VRAM decoded to one color index per byte,
+ * so the pixels of a tile row can be copied instead of decoded from the 2 bit planes.
+ *
+ * Memory invalidates a tile when it is written, it is decoded again the next time it is read.
+ */
+class TileCache final
+{
+private:
+    // The start of the tile data in the VRAM
+    const uint8_t *m_tileDataPtr{};
+    // 8x8 color indices per tile, row by row
+    std::array<std::array<uint8_t, 8*8>, TILE_CACHE_TILE_COUNT> m_tiles{};
+    std::bitset<TILE_CACHE_TILE_COUNT> m_isTileDirty;
+
+    void decodeTile(int tileI);
+
+public:
+    // `tileData` is the start of the VRAM, it has to be valid while the cache is used
+    explicit TileCache(const uint8_t *tileData);
+
+    // Has to be called when a byte of tile `tileI` is written
+    inline void invalidateTile(int tileI) { m_isTileDirty[tileI] = true; }
+    inline void invalidateAll() { m_isTileDirty.set(); }
+
+    // Returns the 8 color indices of row `rowI` of tile `tileI`, `tileI` is counted from 0x8000
+    inline const uint8_t* getRow(int tileI, int rowI)
+    {
+        if (m_isTileDirty[tileI])
+            decodeTile(tileI);
+        return m_tiles[tileI].data()+rowI*8;
+    }
+};
+
+#endif /* TILE_CACHE_H_ */
@@ -0,0 +1,103 @@
+#include "TileDecoderBenchmark.h"
+
+#include "tile_decoder.h"
+#include "hashing.h"
+#include "string_formatting.h"
+
+#include <chrono>
+#include <iostream>
+#include <algorithm>
+
+#define TILE_COUNT      384
+#define PIXELS_PER_TILE (8*8)
+#define LINE_PIXELS     160
+
+TileDecoderBenchmark::TileDecoderBenchmark()
+    : m_tileData(TILE_COUNT*TILE_DECODER_TILE_BYTES)
+{
+    // A xorshift generator, so every run decodes the same data
+    uint32_t state{0x2545f491};
+    for (uint8_t &byte : m_tileData)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        byte = uint8_t(state);
+    }
+}
+
+template <bool isSimd>
+TileDecoderBenchmark::Result TileDecoderBenchmark::runDecoder(unsigned long rounds) const
+{
+    namespace chr = std::chrono;
+
+    std::vector<uint8_t> colorIs(TILE_COUNT*PIXELS_PER_TILE);
+    std::vector<uint32_t> pixels(TILE_COUNT*PIXELS_PER_TILE);
+    static constexpr uint32_t palette[4]{0xffffffff, 0xffaaaaaa, 0xff555555, 0xff000000};
+
+    Result result;
+
+    auto startTime{chr::steady_clock::now()};
+    for (unsigned long round{}; round < rounds; ++round)
+    {
+        for (int tileI{}; tileI < TILE_COUNT; ++tileI)
+        {
+            if constexpr (isSimd)
+                decodeTile(m_tileData.data()+tileI*TILE_DECODER_TILE_BYTES, colorIs.data()+tileI*PIXELS_PER_TILE);
+            else
+                decodeTileScalar(m_tileData.data()+tileI*TILE_DECODER_TILE_BYTES, colorIs.data()+tileI*PIXELS_PER_TILE);
+        }
+        // Don't let the compiler merge the rounds
+        asm volatile("" ::: "memory");
+    }
+    result.decodeSeconds = chr::duration<double>(chr::steady_clock::now()-startTime).count();
+
+    startTime = chr::steady_clock::now();
+    for (unsigned long round{}; round < rounds; ++round)
+    {
+        for (size_t lineStart{}; lineStart < colorIs.size(); lineStart += LINE_PIXELS)
+        {
+            // The last line is shorter
+            const int count{int(std::min<size_t>(LINE_PIXELS, colorIs.size()-lineStart))};
+            if constexpr (isSimd)
+                mapColorIndices(colorIs.data()+lineStart, count, palette, pixels.data()+lineStart);
+            else
+                mapColorIndicesScalar(colorIs.data()+lineStart, count, palette, pixels.data()+lineStart);
+        }
+        asm volatile("" ::: "memory");
+    }
+    result.mapSeconds = chr::duration<double>(chr::steady_clock::now()-startTime).count();
+
+    result.hash = hashFnv1a64(colorIs.data(), colorIs.size());
+    result.hash = hashFnv1a64(pixels.data(), pixels.size()*sizeof(uint32_t), result.hash);
+    return result;
+}
+
+void TileDecoderBenchmark::printResult(const std::string &title, const Result &result, unsigned long rounds)
+{
+    const double pixelCount{double(rounds)*TILE_COUNT*PIXELS_PER_TILE};
+    std::cout << std::dec
+        << title << ":\n"
+        << "  Decoded pixels/s: " << pixelCount/result.decodeSeconds << '\n'
+        << "  Mapped pixels/s:  " << pixelCount/result.mapSeconds << '\n'
+        << "  Hash:             " << toHexStr(result.hash, 16, false) << '\n';
+}
+
+bool TileDecoderBenchmark::run(unsigned long rounds)
+{
+    const Result scalar{runDecoder<false>(rounds)};
+    const Result simd{runDecoder<true>(rounds)};
+
+    std::cout << "----- Tile decoder benchmark results -----\n"
+        << "Rounds:            " << std::dec << rounds << " (" << TILE_COUNT << " tiles each)\n";
+    printResult("Scalar", scalar, rounds);
+    printResult(TILE_DECODER_NAME, simd, rounds);
+    std::cout << "Decode speedup:    " << scalar.decodeSeconds/simd.decodeSeconds << "x\n"
+        << "Map speedup:       " << scalar.mapSeconds/simd.mapSeconds << "x\n";
+
+    const bool isMatching{scalar.hash == simd.hash};
+    if (!isMatching)
+        std::cout << "The results differ\n";
+    std::cout.flush();
+    return isMatching;
+}
@@ -0,0 +1,42 @@
+#ifndef TILEDECODERBENCHMARK_H_
+#define TILEDECODERBENCHMARK_H_
+
+#include "config.h"
+#include "common.h"
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+/*
+ * Measures the speed of the functions in tile_decoder.h: decoding the 384 tiles of the VRAM
+ * (filled with pseudo-random data) and mapping whole screen lines of color indices to pixels.
+ * The scalar functions are run first, then the SIMD ones, and the hashes of their results are compared.
+ */
+class TileDecoderBenchmark final
+{
+private:
+    struct Result
+    {
+        double              decodeSeconds{};
+        double              mapSeconds{};
+        uint64_t            hash{};
+    };
+
+    std::vector<uint8_t>    m_tileData;
+
+    template <bool isSimd>
+    Result runDecoder(unsigned long rounds) const;
+    static void printResult(const std::string &title, const Result &result, unsigned long rounds);
+
+public:
+    TileDecoderBenchmark();
+
+    /*
+     * Decodes all the tiles and maps the same number of pixels `rounds` times with both decoders,
+     * and prints the decoded pixels per second. Returns false if the two decoders gave different results.
+     */
+    bool run(unsigned long rounds);
+};
+
+#endif /* TILEDECODERBENCHMARK_H_ */
@@ -5,6 +5,7 @@
 
 #include "Logger.h"
 #include "string_formatting.h"
+#include "tile_decoder.h"
 
 //#define TILE_WIN_USE_PALETTE
 #define TILE_WIN_DRAW_TILE_SEP
@@ -26,7 +27,7 @@ TileWindow::TileWindow(int x, int y)
     SDL_RenderClear(m_renderer);
 }
 
-void TileWindow::updateTiles(PPU *ppu, uint8_t lcdc)
+void TileWindow::updateTiles(const uint8_t *tileData, uint8_t lcdc)
 {
 #ifndef TILE_WIN_USE_PALETTE
     static constexpr uint8_t shades[]{
@@ -42,9 +43,12 @@ void TileWindow::updateTiles(PPU *ppu, uint8_t lcdc)
 
     for (int tileI{}; tileI < NUM_OF_TILES; ++tileI)
     {
+        uint8_t colorIs[PIXELS_PER_TILE];
+        decodeTile(tileData+tileI*TILE_DECODER_TILE_BYTES, colorIs);
+
         for (int tilePixelI{}; tilePixelI < PIXELS_PER_TILE; ++tilePixelI)
         {
-            auto colorI{ppu->getPixelColorIndexFlat(tileI, tilePixelI)};
+            auto colorI{colorIs[tilePixelI]};
 
 #ifdef TILE_WIN_USE_PALETTE
             uint8_t r, g, b;
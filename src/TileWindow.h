@@ -31,7 +31,8 @@ public:
         SDL_RenderPresent(m_renderer);
     }
 
-    void updateTiles(PPU *ppu, uint8_t lcdc);
+    // `tileData` is a copy of the tile data area of the VRAM (0x8000-0x97ff)
+    void updateTiles(const uint8_t *tileData, uint8_t lcdc);
 
     ~TileWindow();
 };
@@ -1,5 +1,7 @@
 #include "Timer.h"
 
+#include <climits>
+
 Timer::Timer()
 {
 }
@@ -40,24 +42,59 @@ void Timer::tick()
         }
 
         // Count down the cycles until increment from the value of TAC.
-        switch (m_tacRegister & 0b00000011)
+        m_cyclesUntilTimaIncrement = getTimaPeriod();
+    }
+}
+
+int Timer::getTimaPeriod() const
+{
+    switch (m_tacRegister & 0b00000011)
+    {
+    case 0:  return 1024;
+    case 1:  return 16;
+    case 2:  return 64;
+    default: return 256;
+    }
+}
+
+void Timer::skip(int tCycles)
+{
+    m_cyclesUntilDivIncrement -= tCycles;
+    while (m_cyclesUntilDivIncrement <= 0)
+    {
+        m_cyclesUntilDivIncrement += 256;
+        ++m_divRegister;
+    }
+
+    // If the timer is disabled, don't do anything with it.
+    if ((m_tacRegister & 0b00000100) == 0) return;
+
+    m_cyclesUntilTimaIncrement -= tCycles;
+    while (m_cyclesUntilTimaIncrement <= 0)
+    {
+        // If the TIMA overflows
+        if (m_timaRegister == 0xff)
         {
-        case 0:
-            m_cyclesUntilTimaIncrement = 1024;
-            break;
-        case 1:
-            m_cyclesUntilTimaIncrement = 16;
-            break;
-        case 2:
-            m_cyclesUntilTimaIncrement = 64;
-            break;
-        case 3:
-            m_cyclesUntilTimaIncrement = 256;
-            break;
+            m_timaRegister = m_tmaRegister;
+            m_isInterruptRequested = true;
         }
+        else
+        {
+            ++m_timaRegister;
+        }
+
+        m_cyclesUntilTimaIncrement += getTimaPeriod();
     }
 }
 
+int Timer::getCyclesUntilInterrupt() const
+{
+    if ((m_tacRegister & 0b00000100) == 0)
+        return INT_MAX;
+
+    return m_cyclesUntilTimaIncrement + (0xff-m_timaRegister)*getTimaPeriod();
+}
+
 Timer::~Timer()
 {
 }
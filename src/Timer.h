@@ -14,12 +14,18 @@ private:
     uint8_t m_tmaRegister{}; // Value to set after TIMA overflows
     uint8_t m_tacRegister{}; // Timer control
 
+    int getTimaPeriod() const;
+
     bool m_isInterruptRequested{};
 
 public:
     Timer();
 
     void tick();
+    // Same as calling `tick()` `tCycles` times
+    void skip(int tCycles);
+    // The number of `tick()` calls until the timer interrupt is requested, INT_MAX if the timer is stopped
+    int getCyclesUntilInterrupt() const;
 
     // ----- DIV register ------
     inline uint8_t getDivRegister() const { return m_divRegister; }
@@ -38,6 +44,19 @@ public:
     inline bool isInterruptRequested() const { return m_isInterruptRequested; }
     inline void resetInterrupt() { m_isInterruptRequested = false; }
 
+    // Passes the state to `stream`, see StateStream.h
+    template <class Stream>
+    void serializeState(Stream &stream)
+    {
+        stream.value(m_cyclesUntilDivIncrement);
+        stream.value(m_divRegister);
+        stream.value(m_cyclesUntilTimaIncrement);
+        stream.value(m_timaRegister);
+        stream.value(m_tmaRegister);
+        stream.value(m_tacRegister);
+        stream.value(m_isInterruptRequested);
+    }
+
     ~Timer();
 };
 
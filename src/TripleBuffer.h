@@ -0,0 +1,52 @@
+#ifndef TRIPLEBUFFER_H_
+#define TRIPLEBUFFER_H_
+
+#include <array>
+#include <atomic>
+#include <stdint.h>
+
+/*
+ * Passes values from one producer thread to one consumer thread without locking.
+ *
+ * The producer fills the write buffer and publishes it, the consumer takes the last published one.
+ * Neither of them ever waits: the producer can publish again before the consumer took the previous value
+ * (then that is dropped), and the consumer keeps its buffer until there is a newer one.
+ */
+template <class T>
+class TripleBuffer final
+{
+private:
+    // Set in `m_middle` if the middle buffer was published and not taken yet
+    static constexpr uint8_t NEW_BIT{1 << 2};
+    static constexpr uint8_t INDEX_MASK{NEW_BIT-1};
+
+    std::array<T, 3>        m_buffers{};
+    // The index of the buffer between the two threads, and NEW_BIT
+    std::atomic<uint8_t>    m_middle{1};
+    // Only used by the producer
+    uint8_t                 m_writeI{0};
+    // Only used by the consumer
+    uint8_t                 m_readI{2};
+
+public:
+    // The buffer of the producer, it keeps an older value, so it has to be overwritten
+    inline T& getWriteBuffer() { return m_buffers[m_writeI]; }
+    // Hands the write buffer over to the consumer, then the producer gets another buffer
+    inline void publish()
+    {
+        m_writeI = m_middle.exchange(m_writeI | NEW_BIT, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    // Takes the last published buffer, returns false if nothing was published since the last call
+    inline bool consume()
+    {
+        if ((m_middle.load(std::memory_order_relaxed) & NEW_BIT) == 0)
+            return false;
+        m_readI = m_middle.exchange(m_readI, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+    // The buffer taken by the last successful consume()
+    inline const T& getReadBuffer() const { return m_buffers[m_readI]; }
+};
+
+#endif /* TRIPLEBUFFER_H_ */
@@ -0,0 +1,137 @@
+#include "WorkStealingPool.h"
+
+#include "Logger.h"
+
+#include <algorithm>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// The pool and the index of the worker running on this thread
+static thread_local WorkStealingPool *t_pool{};
+static thread_local size_t t_workerI{};
+
+WorkStealingPool::WorkStealingPool(int threadCount/*=0*/, bool pinThreads/*=false*/)
+{
+    const int coreCount{(int)std::max(1u, std::thread::hardware_concurrency())};
+    if (threadCount <= 0)
+        threadCount = coreCount;
+
+    for (int i{}; i < threadCount; ++i)
+        m_workers.push_back(std::make_unique<Worker>());
+
+    // Start the threads only after every queue exists, as they steal from each other
+    for (int i{}; i < threadCount; ++i)
+    {
+        m_workers[i]->thread = std::thread{&WorkStealingPool::workerLoop, this, (size_t)i};
+
+        if (pinThreads)
+        {
+#ifdef __linux__
+            cpu_set_t cpuSet;
+            CPU_ZERO(&cpuSet);
+            CPU_SET(i%coreCount, &cpuSet);
+            if (pthread_setaffinity_np(m_workers[i]->thread.native_handle(), sizeof(cpu_set_t), &cpuSet))
+                Logger::warning("Failed to pin worker "+std::to_string(i)+" to core "+std::to_string(i%coreCount));
+#else
+            if (i == 0)
+                Logger::warning("Pinning threads is not supported on this platform");
+#endif
+        }
+    }
+}
+
+void WorkStealingPool::submit(Task task)
+{
+    // Tasks submitted by a worker stay on that worker, others are spread out
+    const size_t workerI{t_pool == this ? t_workerI : m_nextWorkerI++%m_workers.size()};
+
+    ++m_pendingTaskCount;
+    {
+        std::lock_guard<std::mutex> lock{m_workers[workerI]->mutex};
+        // Counted before the task can be popped, so a thief can't decrement the counter below 0
+        ++m_queuedTaskCount;
+        m_workers[workerI]->tasks.push_back(std::move(task));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{m_stateMutex};
+    }
+    m_workCond.notify_one();
+}
+
+bool WorkStealingPool::popTask(size_t workerI, Task *output)
+{
+    Worker &worker{*m_workers[workerI]};
+    std::lock_guard<std::mutex> lock{worker.mutex};
+    if (worker.tasks.empty())
+        return false;
+
+    *output = std::move(worker.tasks.back());
+    worker.tasks.pop_back();
+    --m_queuedTaskCount;
+    return true;
+}
+
+bool WorkStealingPool::stealTask(size_t workerI, Task *output)
+{
+    for (size_t i{1}; i < m_workers.size(); ++i)
+    {
+        Worker &victim{*m_workers[(workerI+i)%m_workers.size()]};
+        std::lock_guard<std::mutex> lock{victim.mutex};
+        if (victim.tasks.empty())
+            continue;
+
+        *output = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        --m_queuedTaskCount;
+        return true;
+    }
+    return false;
+}
+
+void WorkStealingPool::workerLoop(size_t workerI)
+{
+    t_pool = this;
+    t_workerI = workerI;
+
+    while (true)
+    {
+        Task task;
+        if (popTask(workerI, &task) || stealTask(workerI, &task))
+        {
+            task();
+
+            if (--m_pendingTaskCount == 0)
+            {
+                std::lock_guard<std::mutex> lock{m_stateMutex};
+                m_doneCond.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock{m_stateMutex};
+        m_workCond.wait(lock, [this](){ return m_isStopping || m_queuedTaskCount > 0; });
+        if (m_isStopping && m_queuedTaskCount == 0)
+            return;
+    }
+}
+
+void WorkStealingPool::wait()
+{
+    std::unique_lock<std::mutex> lock{m_stateMutex};
+    m_doneCond.wait(lock, [this](){ return m_pendingTaskCount == 0; });
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        std::lock_guard<std::mutex> lock{m_stateMutex};
+        m_isStopping = true;
+    }
+    m_workCond.notify_all();
+
+    for (auto &worker : m_workers)
+        worker->thread.join();
+}
@@ -0,0 +1,73 @@
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include "config.h"
+#include "common.h"
+
+#include <functional>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+/*
+ * A thread pool where every worker has its own task queue.
+ *
+ * A worker takes the newest task from its own queue, and when that is empty,
+ * it steals the oldest task from the queue of another worker.
+ * Tasks submitted from a worker go to the queue of that worker,
+ * so a task that resubmits itself tends to stay on the same core.
+ */
+class WorkStealingPool final
+{
+public:
+    using Task = std::function<void()>;
+
+private:
+    struct Worker
+    {
+        std::mutex          mutex;
+        std::deque<Task>    tasks;
+        std::thread         thread;
+    };
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+
+    // Tasks that are submitted but not finished yet
+    std::atomic<size_t>     m_pendingTaskCount{};
+    // Tasks that are in one of the queues
+    std::atomic<size_t>     m_queuedTaskCount{};
+    std::atomic<size_t>     m_nextWorkerI{};
+    bool                    m_isStopping{};
+
+    std::mutex              m_stateMutex;
+    // Notified when a task is queued or the pool is stopping
+    std::condition_variable m_workCond;
+    // Notified when the last pending task is finished
+    std::condition_variable m_doneCond;
+
+    bool popTask(size_t workerI, Task *output);
+    bool stealTask(size_t workerI, Task *output);
+    void workerLoop(size_t workerI);
+
+public:
+    /*
+     * If `threadCount` is 0, a thread is started for each CPU core.
+     * If `pinThreads` is true, worker N only runs on core N (modulo the core count).
+     */
+    WorkStealingPool(int threadCount=0, bool pinThreads=false);
+
+    // Can be called from a task too
+    void submit(Task task);
+    // Blocks until every submitted task is finished, including the ones submitted by tasks
+    void wait();
+
+    inline int getThreadCount() const { return (int)m_workers.size(); }
+
+    ~WorkStealingPool();
+};
+
+#endif // WORKSTEALINGPOOL_H
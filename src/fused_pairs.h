@@ -0,0 +1,29 @@
+#ifndef FUSED_PAIRS_H_
+#define FUSED_PAIRS_H_
+
+#include <array>
+#include <stdint.h>
+
+/*
+ * Two opcodes that are executed by one handler (CPU::executeFusedPair()) when the second directly follows the first,
+ * with one fetch and the cycles of both. Only the pairs below have a handler.
+ */
+struct FusedPair
+{
+    uint8_t first;
+    uint8_t second;
+};
+
+// Sequences that are common in the copy, wait and delay loops of games
+inline constexpr std::array<FusedPair, 8> defaultFusedPairs{{
+    {0x2a, 0x12}, // LD A,(HL+); LD (DE),A
+    {0x0b, 0x78}, // DEC BC; LD A,B
+    {0x78, 0xb1}, // LD A,B; OR C
+    {0x05, 0x20}, // DEC B; JR NZ,i8
+    {0x0d, 0x20}, // DEC C; JR NZ,i8
+    {0x3d, 0x20}, // DEC A; JR NZ,i8
+    {0xf0, 0xe6}, // LDH A,(u8); AND A,u8
+    {0xf0, 0xfe}, // LDH A,(u8); CP A,u8
+}};
+
+#endif /* FUSED_PAIRS_H_ */
@@ -0,0 +1,122 @@
+#include "gbemu.h"
+
+#include "GBMachine.h"
+#include "CartridgeReader.h"
+#include "Logger.h"
+
+#include <string>
+
+struct gbemu
+{
+    GBMachine machine;
+
+    gbemu(const uint8_t *rom, size_t romSize)
+        : machine{rom, romSize}
+    {
+    }
+};
+
+int gbemu_api_version(void)
+{
+    return GBEMU_API_VERSION;
+}
+
+void gbemu_set_quiet(int is_quiet)
+{
+    Logger::setQuiet(is_quiet);
+}
+
+gbemu* gbemu_create(const uint8_t *rom, size_t rom_size)
+{
+    // The cartridge reader exits on an invalid header, the host process must not exit
+    std::string error;
+    if (!rom || !CartridgeReader::checkHeader(rom, rom_size, &error))
+    {
+        Logger::error("gbemu_create: "+(rom ? error : std::string{"ROM is NULL"}));
+        return nullptr;
+    }
+    if (rom[0x0143] == 0xc0)
+    {
+        Logger::error("gbemu_create: ROM is CGB only");
+        return nullptr;
+    }
+
+    return new gbemu{rom, rom_size};
+}
+
+void gbemu_destroy(gbemu *gb)
+{
+    delete gb;
+}
+
+uint64_t gbemu_step_frame(gbemu *gb)
+{
+    const unsigned long long startTCycle{gb->machine.getTCyclesDone()};
+    gb->machine.emulateFrame();
+    return gb->machine.getTCyclesDone()-startTCycle;
+}
+
+uint64_t gbemu_step_cycles(gbemu *gb, uint64_t t_cycles)
+{
+    return gb->machine.emulateTCycles(t_cycles);
+}
+
+void gbemu_set_joypad(gbemu *gb, uint8_t buttons)
+{
+    Joypad *joypad{gb->machine.getJoypad()};
+    for (int i{}; i < (int)Joypad::Button::_Count; ++i)
+    {
+        if (buttons & (1 << i))
+            joypad->setBtnPressed((Joypad::Button)i);
+        else
+            joypad->setBtnReleased((Joypad::Button)i);
+    }
+}
+
+const uint8_t* gbemu_framebuffer(gbemu *gb, size_t *pitch)
+{
+    const PPU *ppu{gb->machine.getPpu()};
+    if (pitch)
+        *pitch = ppu->getPixelPitch();
+    return reinterpret_cast<const uint8_t*>(ppu->getPixelData());
+}
+
+const uint8_t* gbemu_framebuffer_shades(gbemu *gb)
+{
+    return gb->machine.getPpu()->getFrame().shades.data();
+}
+
+uint8_t* gbemu_wram(gbemu *gb)
+{
+    return gb->machine.getMemory()->getWram().data();
+}
+
+int gbemu_is_stopped(const gbemu *gb)
+{
+    return gb->machine.isStopped();
+}
+
+uint64_t gbemu_frames_done(const gbemu *gb)
+{
+    return gb->machine.getFramesDone();
+}
+
+uint64_t gbemu_t_cycles_done(const gbemu *gb)
+{
+    return gb->machine.getTCyclesDone();
+}
+
+size_t gbemu_state_size(gbemu *gb)
+{
+    return gb->machine.getStateSize();
+}
+
+int gbemu_save_state(gbemu *gb, void *buffer, size_t size)
+{
+    return gb->machine.saveState(static_cast<uint8_t*>(buffer), size) ? 0 : -1;
+}
+
+int gbemu_load_state(gbemu *gb, const void *buffer, size_t size)
+{
+    return gb->machine.loadState(static_cast<const uint8_t*>(buffer), size) ? 0 : -1;
+}
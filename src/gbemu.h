@@ -0,0 +1,102 @@
+#ifndef GBEMU_H_
+#define GBEMU_H_
+
+/*
+ * C API of libgbemu, to embed the emulator in other programs.
+ *
+ * A `gbemu` is one headless machine. Different machines can be used from different threads,
+ * but a machine has to be used by one thread at a time.
+ * The pointer to the WRAM stays valid until the machine is destroyed.
+ * The framebuffer is double-buffered, its pointers are only valid until the next frame is finished.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define GBEMU_API __attribute__((visibility("default")))
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define GBEMU_API_VERSION 3
+
+#define GBEMU_SCREEN_WIDTH  160
+#define GBEMU_SCREEN_HEIGHT 144
+#define GBEMU_WRAM_SIZE     0x2000
+
+/* Joypad buttons, OR them together for `gbemu_set_joypad()` */
+#define GBEMU_BUTTON_UP     (1 << 0)
+#define GBEMU_BUTTON_DOWN   (1 << 1)
+#define GBEMU_BUTTON_LEFT   (1 << 2)
+#define GBEMU_BUTTON_RIGHT  (1 << 3)
+#define GBEMU_BUTTON_A      (1 << 4)
+#define GBEMU_BUTTON_B      (1 << 5)
+#define GBEMU_BUTTON_SELECT (1 << 6)
+#define GBEMU_BUTTON_START  (1 << 7)
+
+typedef struct gbemu gbemu;
+
+/* Returns GBEMU_API_VERSION of the library */
+GBEMU_API int gbemu_api_version(void);
+
+/* Disables the logging of all machines if `is_quiet` is nonzero */
+GBEMU_API void gbemu_set_quiet(int is_quiet);
+
+/*
+ * Creates a machine from a ROM image, the ROM is copied.
+ * Returns NULL if the ROM is too small, its header is invalid or it is for Game Boy Color only.
+ */
+GBEMU_API gbemu* gbemu_create(const uint8_t *rom, size_t rom_size);
+GBEMU_API void gbemu_destroy(gbemu *gb);
+
+/*
+ * Emulates until the start of the next V-blank, returns the elapsed T-cycles.
+ * Returns early if the CPU enters STOP mode.
+ */
+GBEMU_API uint64_t gbemu_step_frame(gbemu *gb);
+/*
+ * Emulates at least `t_cycles` T-cycles, returns the elapsed T-cycles.
+ * Instructions are not split, so this can be a few cycles more than requested.
+ * Returns early if the CPU enters STOP mode.
+ */
+GBEMU_API uint64_t gbemu_step_cycles(gbemu *gb, uint64_t t_cycles);
+
+/* Sets the pressed buttons, see GBEMU_BUTTON_* */
+GBEMU_API void gbemu_set_joypad(gbemu *gb, uint8_t buttons);
+
+/*
+ * Returns the last finished frame: GBEMU_SCREEN_HEIGHT rows of `*pitch` bytes,
+ * 4 bytes per pixel in R, G, B, A order. `pitch` can be NULL.
+ */
+GBEMU_API const uint8_t* gbemu_framebuffer(gbemu *gb, size_t *pitch);
+/*
+ * Returns the last finished frame as shades (0-3, from the lightest): GBEMU_SCREEN_HEIGHT rows of
+ * GBEMU_SCREEN_WIDTH/4 bytes, 4 pixels per byte with the leftmost one in the highest 2 bits.
+ */
+GBEMU_API const uint8_t* gbemu_framebuffer_shades(gbemu *gb);
+/* Returns the Work RAM (0xc000-0xdfff), GBEMU_WRAM_SIZE bytes. Writes are seen by the emulated CPU. */
+GBEMU_API uint8_t* gbemu_wram(gbemu *gb);
+
+/* Returns nonzero if the CPU is in STOP mode, then only pressing a button with `gbemu_set_joypad()` wakes it up */
+GBEMU_API int gbemu_is_stopped(const gbemu *gb);
+
+/* Returns the number of finished frames, a frame cut short by STOP mode is not counted */
+GBEMU_API uint64_t gbemu_frames_done(const gbemu *gb);
+GBEMU_API uint64_t gbemu_t_cycles_done(const gbemu *gb);
+
+/* Returns the size of a saved state, it is the same for every machine of the same ROM */
+GBEMU_API size_t gbemu_state_size(gbemu *gb);
+/* Saves the state to `buffer`, returns 0 on success and -1 if `size` is too small */
+GBEMU_API int gbemu_save_state(gbemu *gb, void *buffer, size_t size);
+/*
+ * Loads a state saved from a machine of the same ROM, returns 0 on success and -1 if the state is invalid
+ * or was saved with another ROM (the title and the checksums of the header are compared).
+ */
+GBEMU_API int gbemu_load_state(gbemu *gb, const void *buffer, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GBEMU_H_ */
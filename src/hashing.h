@@ -0,0 +1,25 @@
+#ifndef HASHING_H_
+#define HASHING_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define FNV1A64_OFFSET_BASIS 0xcbf29ce484222325ull
+#define FNV1A64_PRIME        0x00000100000001b3ull
+
+/*
+ * Hashes `size` bytes at `data` with 64-bit FNV-1a.
+ * To continue a rolling hash, pass the previous result in `hash`.
+ */
+inline uint64_t hashFnv1a64(const void *data, size_t size, uint64_t hash=FNV1A64_OFFSET_BASIS)
+{
+    const uint8_t *bytes{static_cast<const uint8_t*>(data)};
+    for (size_t i{}; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= FNV1A64_PRIME;
+    }
+    return hash;
+}
+
+#endif /* HASHING_H_ */
@@ -1,16 +1,250 @@
 #include "config.h"
 #include "GBEmulator.h"
+#include "Benchmark.h"
+#include "CpuBenchmark.h"
+#include "TileDecoderBenchmark.h"
+#include "TestRunner.h"
+#include "Farm.h"
+#include "Logger.h"
 
-int main()
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <cstdlib>
+
+static void printUsage(const char *programName)
+{
+    std::cerr << "Usage: " << programName << " [options] [ROM...]\n"
+        << "Options:\n"
+        << "    --benchmark FRAMES    Run FRAMES frames headless and print the frame hashes\n"
+        << "    --input FILE          Replay the input script FILE\n"
+        << "    --record FILE         Write the button presses and releases to FILE as an input script\n"
+        << "    --expect FB:WRAM      Fail if the final hashes differ (with --benchmark)\n"
+        << "    --cpu-benchmark FRAMES Run FRAMES frames of generated ALU-heavy code and print the CPU speed\n"
+        << "    --decoder-benchmark ROUNDS Decode the tiles of the VRAM ROUNDS times and print the decoded pixels per second\n"
+        << "    --no-idle-skip        Emulate the idle cycles one by one, to check that skipping them changes nothing\n"
+        << "    --fuse PAIRS          Fused opcode pairs to use (see src/fused_pairs.h), like 2a12,0520, or none (with --benchmark, --cpu-benchmark and --farm)\n"
+        << "    --colors green|gray   The shades of the LCD (default: green)\n"
+        << "    --speed N|max         Run at N times the real speed, or as fast as possible (default: 1)\n"
+        << "    --frameskip N|auto    Draw only every N+1th frame, or skip frames while slower than real time\n"
+        << "    --test-roms DIR       Run the test ROMs in DIR in parallel and print a report\n"
+        << "    --report json|junit   Format of the test report (default: json)\n"
+        << "    --timeout FRAMES      Fail a test ROM after FRAMES frames (default: 7200)\n"
+        << "    --jobs N              Number of threads for --test-roms and --farm (default: number of cores)\n"
+        << "    --farm INSTANCES      Run INSTANCES headless machines of the ROMs in parallel and print the stats\n"
+        << "    --frames N            Frames to emulate on each machine (with --farm, default: 600)\n"
+        << "    --quantum FRAMES      Frames a worker emulates on a machine at once (with --farm, default: 1)\n"
+        << "    --pin                 Pin each worker thread to a CPU core (with --farm)\n";
+}
+
+// Parses a list like "2a12,0520" (the first and the second opcode in hex), or "none". Returns false if it is invalid.
+static bool parseFusedPairs(const std::string &str, std::vector<FusedPair> &pairs)
 {
+    pairs.clear();
+    if (str == "none")
+        return true;
+
+    std::stringstream ss{str};
+    std::string item;
+    while (std::getline(ss, item, ','))
+    {
+        if (item.size() != 4 || item.find_first_not_of("0123456789abcdefABCDEF") != std::string::npos)
+            return false;
+        const unsigned long value{std::stoul(item, nullptr, 16)};
+        pairs.push_back({(uint8_t)(value >> 8), (uint8_t)(value & 0xff)});
+    }
+    return !pairs.empty();
+}
+
+int main(int argc, char **argv)
+{
+    //std::string romFilename{"roms/Pokemon - Blue Version (UE) [S][!].gb"};
+    //std::string romFilename{"roms/Super Mario Land (JUE) (V1.1) [!].gb"};
+    //std::string romFilename{"roms/Super Mario Bros. Deluxe (U) (V1.1) [C][!].gbc"};
+    //std::string romFilename{"roms/cpu_instrs.gb"};
+    //std::string romFilename{"roms/Tetris (JUE) (V1.1) [!].gb"};
+    std::string romFilename{"roms/Dr. Mario (JU) (V1.1).gb"};
+
+    unsigned long benchmarkFrames{};
+    unsigned long cpuBenchmarkFrames{};
+    unsigned long decoderBenchmarkRounds{};
+    std::string inputScriptFilename;
+    std::string inputRecordFilename;
+    std::string expectedHashes;
+    bool isIdleSkippingEnabled{true};
+    std::vector<FusedPair> fusedPairs{defaultFusedPairs.begin(), defaultFusedPairs.end()};
+    ColorScheme colorScheme{colorSchemeGreen};
+    int frameSkip{};
+    bool isAutoFrameSkipEnabled{};
+    double speed{1};
+    std::string testRomDir;
+    std::string reportFormat{"json"};
+    unsigned long testTimeoutFrames{7200};
+    int jobCount{};
+    int farmInstanceCount{};
+    unsigned long farmFrames{600};
+    unsigned long farmQuantumFrames{1};
+    bool pinThreads{};
+    std::vector<std::string> romFilenames;
+
+    for (int i{1}; i < argc; ++i)
+    {
+        const std::string arg{argv[i]};
+        const bool hasValue{i+1 < argc};
+
+        if (arg == "--benchmark" && hasValue)
+            benchmarkFrames = std::stoul(argv[++i]);
+        else if (arg == "--cpu-benchmark" && hasValue)
+            cpuBenchmarkFrames = std::stoul(argv[++i]);
+        else if (arg == "--decoder-benchmark" && hasValue)
+            decoderBenchmarkRounds = std::stoul(argv[++i]);
+        else if (arg == "--input" && hasValue)
+            inputScriptFilename = argv[++i];
+        else if (arg == "--record" && hasValue)
+            inputRecordFilename = argv[++i];
+        else if (arg == "--expect" && hasValue)
+            expectedHashes = argv[++i];
+        else if (arg == "--no-idle-skip")
+            isIdleSkippingEnabled = false;
+        else if (arg == "--fuse" && hasValue)
+        {
+            if (!parseFusedPairs(argv[++i], fusedPairs))
+            {
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+        else if (arg == "--colors" && hasValue)
+        {
+            const std::string name{argv[++i]};
+            if (name == "green")
+                colorScheme = colorSchemeGreen;
+            else if (name == "gray")
+                colorScheme = colorSchemeGray;
+            else
+            {
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+        else if (arg == "--speed" && hasValue)
+        {
+            const std::string value{argv[++i]};
+            char *end{};
+            speed = value == "max" ? 0 : std::strtod(value.c_str(), &end);
+            if (value != "max" && (end == value.c_str() || *end || speed <= 0))
+            {
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+        else if (arg == "--frameskip" && hasValue)
+        {
+            const std::string value{argv[++i]};
+            if (value == "auto")
+                isAutoFrameSkipEnabled = true;
+            else if (!value.empty() && value.find_first_not_of("0123456789") == std::string::npos)
+                frameSkip = std::stoi(value);
+            else
+            {
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+        else if (arg == "--test-roms" && hasValue)
+            testRomDir = argv[++i];
+        else if (arg == "--report" && hasValue)
+            reportFormat = argv[++i];
+        else if (arg == "--timeout" && hasValue)
+            testTimeoutFrames = std::stoul(argv[++i]);
+        else if (arg == "--jobs" && hasValue)
+            jobCount = std::stoi(argv[++i]);
+        else if (arg == "--farm" && hasValue)
+            farmInstanceCount = std::stoi(argv[++i]);
+        else if (arg == "--frames" && hasValue)
+            farmFrames = std::stoul(argv[++i]);
+        else if (arg == "--quantum" && hasValue)
+            farmQuantumFrames = std::stoul(argv[++i]);
+        else if (arg == "--pin")
+            pinThreads = true;
+        else if (!arg.empty() && arg[0] != '-')
+        {
+            romFilename = arg;
+            romFilenames.push_back(arg);
+        }
+        else
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    // The results of the headless modes must not depend on the speed of the host
+    if (isAutoFrameSkipEnabled && (farmInstanceCount || benchmarkFrames))
+    {
+        std::cerr << "--frameskip auto can't be used with --benchmark or --farm\n";
+        return 1;
+    }
+
+    if (!testRomDir.empty())
+    {
+        if (reportFormat != "json" && reportFormat != "junit")
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+
+        Logger::setQuiet(true);
+
+        TestRunner runner{testRomDir, testTimeoutFrames, jobCount};
+        runner.run();
+        if (reportFormat == "junit")
+            runner.writeJUnit(std::cout);
+        else
+            runner.writeJson(std::cout);
+        return runner.getFailedCount() ? 2 : 0;
+    }
+
+    if (farmInstanceCount)
+    {
+        Logger::setQuiet(true);
+
+        if (romFilenames.empty())
+            romFilenames.push_back(romFilename);
+
+        Farm farm{romFilenames, farmInstanceCount, isIdleSkippingEnabled, fusedPairs, frameSkip};
+        farm.run(farmFrames, farmQuantumFrames, jobCount, pinThreads);
+        farm.writeReport(std::cout);
+        return 0;
+    }
+
+    if (cpuBenchmarkFrames)
+    {
+        Logger::setQuiet(true);
+
+        CpuBenchmark benchmark{fusedPairs};
+        return benchmark.run(cpuBenchmarkFrames) ? 0 : 2;
+    }
+
+    if (decoderBenchmarkRounds)
+    {
+        TileDecoderBenchmark benchmark;
+        return benchmark.run(decoderBenchmarkRounds) ? 0 : 2;
+    }
+
+    if (benchmarkFrames)
+    {
+        // Only the results should go to stdout
+        Logger::setQuiet(true);
 
-    //GBEmulator *emulator{new GBEmulator{"roms/Pokemon - Blue Version (UE) [S][!].gb"}};
-    //GBEmulator *emulator{new GBEmulator{"roms/Super Mario Land (JUE) (V1.1) [!].gb"}};
-    //GBEmulator *emulator{new GBEmulator{"roms/Super Mario Bros. Deluxe (U) (V1.1) [C][!].gbc"}};
-    //GBEmulator *emulator{new GBEmulator{"roms/cpu_instrs.gb"}};
-    //GBEmulator *emulator{new GBEmulator{"roms/Tetris (JUE) (V1.1) [!].gb"}};
-    GBEmulator *emulator{new GBEmulator{"roms/Dr. Mario (JU) (V1.1).gb"}};
+        Benchmark benchmark{romFilename, inputScriptFilename, isIdleSkippingEnabled, fusedPairs,
+            frameSkip};
+        return benchmark.run(benchmarkFrames, expectedHashes) ? 0 : 2;
+    }
 
+    GBEmulator *emulator{new GBEmulator{romFilename, colorScheme, frameSkip, isAutoFrameSkipEnabled, speed,
+        inputScriptFilename, inputRecordFilename}};
 
     emulator->startLoop();
 
@@ -0,0 +1,628 @@
+#ifndef OPCODE_TABLE_H_
+#define OPCODE_TABLE_H_
+
+#include "string_formatting.h"
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <stdint.h>
+
+/*
+ * The metadata of every opcode, used by the dispatcher, the disassembler and the idle loop detection.
+ *
+ * The cycles are in M-cycles. `branchCycles` is the time of a conditional jump, call or return
+ * when the condition is met, for the other opcodes it is the same as `cycles`.
+ * The unused opcodes are only reported, they take 1 cycle like a NOP.
+ */
+
+enum class OperandKind : uint8_t
+{
+    None,
+    U8,  // unsigned immediate byte
+    I8,  // signed offset
+    U16, // little endian immediate word
+};
+
+struct OpcodeInfo
+{
+    std::string_view    mnemonic;
+    OperandKind         operandKind;
+    uint8_t             size;
+    uint8_t             cycles;
+    uint8_t             branchCycles;
+};
+
+// The opcodes without a prefix
+inline constexpr std::array<OpcodeInfo, 256> opcodeTable{{
+    {"NOP",            OperandKind::None, 1, 1, 1}, // 0x00
+    {"LD BC,u16",      OperandKind::U16,  3, 3, 3}, // 0x01
+    {"LD (BC),A",      OperandKind::None, 1, 2, 2}, // 0x02
+    {"INC BC",         OperandKind::None, 1, 2, 2}, // 0x03
+    {"INC B",          OperandKind::None, 1, 1, 1}, // 0x04
+    {"DEC B",          OperandKind::None, 1, 1, 1}, // 0x05
+    {"LD B,u8",        OperandKind::U8,   2, 2, 2}, // 0x06
+    {"RLCA",           OperandKind::None, 1, 1, 1}, // 0x07
+    {"LD (u16),SP",    OperandKind::U16,  3, 5, 5}, // 0x08
+    {"ADD HL,BC",      OperandKind::None, 1, 2, 2}, // 0x09
+    {"LD A,(BC)",      OperandKind::None, 1, 2, 2}, // 0x0a
+    {"DEC BC",         OperandKind::None, 1, 2, 2}, // 0x0b
+    {"INC C",          OperandKind::None, 1, 1, 1}, // 0x0c
+    {"DEC C",          OperandKind::None, 1, 1, 1}, // 0x0d
+    {"LD C,u8",        OperandKind::U8,   2, 2, 2}, // 0x0e
+    {"RRCA",           OperandKind::None, 1, 1, 1}, // 0x0f
+    {"STOP",           OperandKind::None, 2, 1, 1}, // 0x10
+    {"LD DE,u16",      OperandKind::U16,  3, 3, 3}, // 0x11
+    {"LD (DE),A",      OperandKind::None, 1, 2, 2}, // 0x12
+    {"INC DE",         OperandKind::None, 1, 2, 2}, // 0x13
+    {"INC D",          OperandKind::None, 1, 1, 1}, // 0x14
+    {"DEC D",          OperandKind::None, 1, 1, 1}, // 0x15
+    {"LD D,u8",        OperandKind::U8,   2, 2, 2}, // 0x16
+    {"RLA",            OperandKind::None, 1, 1, 1}, // 0x17
+    {"JR i8",          OperandKind::I8,   2, 3, 3}, // 0x18
+    {"ADD HL,DE",      OperandKind::None, 1, 2, 2}, // 0x19
+    {"LD A,(DE)",      OperandKind::None, 1, 2, 2}, // 0x1a
+    {"DEC DE",         OperandKind::None, 1, 2, 2}, // 0x1b
+    {"INC E",          OperandKind::None, 1, 1, 1}, // 0x1c
+    {"DEC E",          OperandKind::None, 1, 1, 1}, // 0x1d
+    {"LD E,u8",        OperandKind::U8,   2, 2, 2}, // 0x1e
+    {"RRA",            OperandKind::None, 1, 1, 1}, // 0x1f
+    {"JR NZ,i8",       OperandKind::I8,   2, 2, 3}, // 0x20
+    {"LD HL,u16",      OperandKind::U16,  3, 3, 3}, // 0x21
+    {"LD (HL+),A",     OperandKind::None, 1, 2, 2}, // 0x22
+    {"INC HL",         OperandKind::None, 1, 2, 2}, // 0x23
+    {"INC H",          OperandKind::None, 1, 1, 1}, // 0x24
+    {"DEC H",          OperandKind::None, 1, 1, 1}, // 0x25
+    {"LD H,u8",        OperandKind::U8,   2, 2, 2}, // 0x26
+    {"DAA",            OperandKind::None, 1, 1, 1}, // 0x27
+    {"JR Z,i8",        OperandKind::I8,   2, 2, 3}, // 0x28
+    {"ADD HL,HL",      OperandKind::None, 1, 2, 2}, // 0x29
+    {"LD A,(HL+)",     OperandKind::None, 1, 2, 2}, // 0x2a
+    {"DEC HL",         OperandKind::None, 1, 2, 2}, // 0x2b
+    {"INC L",          OperandKind::None, 1, 1, 1}, // 0x2c
+    {"DEC L",          OperandKind::None, 1, 1, 1}, // 0x2d
+    {"LD L,u8",        OperandKind::U8,   2, 2, 2}, // 0x2e
+    {"CPL",            OperandKind::None, 1, 1, 1}, // 0x2f
+    {"JR NC,i8",       OperandKind::I8,   2, 2, 3}, // 0x30
+    {"LD SP,u16",      OperandKind::U16,  3, 3, 3}, // 0x31
+    {"LD (HL-),A",     OperandKind::None, 1, 2, 2}, // 0x32
+    {"INC SP",         OperandKind::None, 1, 2, 2}, // 0x33
+    {"INC (HL)",       OperandKind::None, 1, 3, 3}, // 0x34
+    {"DEC (HL)",       OperandKind::None, 1, 3, 3}, // 0x35
+    {"LD (HL),u8",     OperandKind::U8,   2, 3, 3}, // 0x36
+    {"SCF",            OperandKind::None, 1, 1, 1}, // 0x37
+    {"JR C,i8",        OperandKind::I8,   2, 2, 3}, // 0x38
+    {"ADD HL,SP",      OperandKind::None, 1, 2, 2}, // 0x39
+    {"LD A,(HL-)",     OperandKind::None, 1, 2, 2}, // 0x3a
+    {"DEC SP",         OperandKind::None, 1, 2, 2}, // 0x3b
+    {"INC A",          OperandKind::None, 1, 1, 1}, // 0x3c
+    {"DEC A",          OperandKind::None, 1, 1, 1}, // 0x3d
+    {"LD A,u8",        OperandKind::U8,   2, 2, 2}, // 0x3e
+    {"CCF",            OperandKind::None, 1, 1, 1}, // 0x3f
+    {"LD B,B",         OperandKind::None, 1, 1, 1}, // 0x40
+    {"LD B,C",         OperandKind::None, 1, 1, 1}, // 0x41
+    {"LD B,D",         OperandKind::None, 1, 1, 1}, // 0x42
+    {"LD B,E",         OperandKind::None, 1, 1, 1}, // 0x43
+    {"LD B,H",         OperandKind::None, 1, 1, 1}, // 0x44
+    {"LD B,L",         OperandKind::None, 1, 1, 1}, // 0x45
+    {"LD B,(HL)",      OperandKind::None, 1, 2, 2}, // 0x46
+    {"LD B,A",         OperandKind::None, 1, 1, 1}, // 0x47
+    {"LD C,B",         OperandKind::None, 1, 1, 1}, // 0x48
+    {"LD C,C",         OperandKind::None, 1, 1, 1}, // 0x49
+    {"LD C,D",         OperandKind::None, 1, 1, 1}, // 0x4a
+    {"LD C,E",         OperandKind::None, 1, 1, 1}, // 0x4b
+    {"LD C,H",         OperandKind::None, 1, 1, 1}, // 0x4c
+    {"LD C,L",         OperandKind::None, 1, 1, 1}, // 0x4d
+    {"LD C,(HL)",      OperandKind::None, 1, 2, 2}, // 0x4e
+    {"LD C,A",         OperandKind::None, 1, 1, 1}, // 0x4f
+    {"LD D,B",         OperandKind::None, 1, 1, 1}, // 0x50
+    {"LD D,C",         OperandKind::None, 1, 1, 1}, // 0x51
+    {"LD D,D",         OperandKind::None, 1, 1, 1}, // 0x52
+    {"LD D,E",         OperandKind::None, 1, 1, 1}, // 0x53
+    {"LD D,H",         OperandKind::None, 1, 1, 1}, // 0x54
+    {"LD D,L",         OperandKind::None, 1, 1, 1}, // 0x55
+    {"LD D,(HL)",      OperandKind::None, 1, 2, 2}, // 0x56
+    {"LD D,A",         OperandKind::None, 1, 1, 1}, // 0x57
+    {"LD E,B",         OperandKind::None, 1, 1, 1}, // 0x58
+    {"LD E,C",         OperandKind::None, 1, 1, 1}, // 0x59
+    {"LD E,D",         OperandKind::None, 1, 1, 1}, // 0x5a
+    {"LD E,E",         OperandKind::None, 1, 1, 1}, // 0x5b
+    {"LD E,H",         OperandKind::None, 1, 1, 1}, // 0x5c
+    {"LD E,L",         OperandKind::None, 1, 1, 1}, // 0x5d
+    {"LD E,(HL)",      OperandKind::None, 1, 2, 2}, // 0x5e
+    {"LD E,A",         OperandKind::None, 1, 1, 1}, // 0x5f
+    {"LD H,B",         OperandKind::None, 1, 1, 1}, // 0x60
+    {"LD H,C",         OperandKind::None, 1, 1, 1}, // 0x61
+    {"LD H,D",         OperandKind::None, 1, 1, 1}, // 0x62
+    {"LD H,E",         OperandKind::None, 1, 1, 1}, // 0x63
+    {"LD H,H",         OperandKind::None, 1, 1, 1}, // 0x64
+    {"LD H,L",         OperandKind::None, 1, 1, 1}, // 0x65
+    {"LD H,(HL)",      OperandKind::None, 1, 2, 2}, // 0x66
+    {"LD H,A",         OperandKind::None, 1, 1, 1}, // 0x67
+    {"LD L,B",         OperandKind::None, 1, 1, 1}, // 0x68
+    {"LD L,C",         OperandKind::None, 1, 1, 1}, // 0x69
+    {"LD L,D",         OperandKind::None, 1, 1, 1}, // 0x6a
+    {"LD L,E",         OperandKind::None, 1, 1, 1}, // 0x6b
+    {"LD L,H",         OperandKind::None, 1, 1, 1}, // 0x6c
+    {"LD L,L",         OperandKind::None, 1, 1, 1}, // 0x6d
+    {"LD L,(HL)",      OperandKind::None, 1, 2, 2}, // 0x6e
+    {"LD L,A",         OperandKind::None, 1, 1, 1}, // 0x6f
+    {"LD (HL),B",      OperandKind::None, 1, 2, 2}, // 0x70
+    {"LD (HL),C",      OperandKind::None, 1, 2, 2}, // 0x71
+    {"LD (HL),D",      OperandKind::None, 1, 2, 2}, // 0x72
+    {"LD (HL),E",      OperandKind::None, 1, 2, 2}, // 0x73
+    {"LD (HL),H",      OperandKind::None, 1, 2, 2}, // 0x74
+    {"LD (HL),L",      OperandKind::None, 1, 2, 2}, // 0x75
+    {"HALT",           OperandKind::None, 1, 1, 1}, // 0x76
+    {"LD (HL),A",      OperandKind::None, 1, 2, 2}, // 0x77
+    {"LD A,B",         OperandKind::None, 1, 1, 1}, // 0x78
+    {"LD A,C",         OperandKind::None, 1, 1, 1}, // 0x79
+    {"LD A,D",         OperandKind::None, 1, 1, 1}, // 0x7a
+    {"LD A,E",         OperandKind::None, 1, 1, 1}, // 0x7b
+    {"LD A,H",         OperandKind::None, 1, 1, 1}, // 0x7c
+    {"LD A,L",         OperandKind::None, 1, 1, 1}, // 0x7d
+    {"LD A,(HL)",      OperandKind::None, 1, 2, 2}, // 0x7e
+    {"LD A,A",         OperandKind::None, 1, 1, 1}, // 0x7f
+    {"ADD A,B",        OperandKind::None, 1, 1, 1}, // 0x80
+    {"ADD A,C",        OperandKind::None, 1, 1, 1}, // 0x81
+    {"ADD A,D",        OperandKind::None, 1, 1, 1}, // 0x82
+    {"ADD A,E",        OperandKind::None, 1, 1, 1}, // 0x83
+    {"ADD A,H",        OperandKind::None, 1, 1, 1}, // 0x84
+    {"ADD A,L",        OperandKind::None, 1, 1, 1}, // 0x85
+    {"ADD A,(HL)",     OperandKind::None, 1, 2, 2}, // 0x86
+    {"ADD A,A",        OperandKind::None, 1, 1, 1}, // 0x87
+    {"ADC A,B",        OperandKind::None, 1, 1, 1}, // 0x88
+    {"ADC A,C",        OperandKind::None, 1, 1, 1}, // 0x89
+    {"ADC A,D",        OperandKind::None, 1, 1, 1}, // 0x8a
+    {"ADC A,E",        OperandKind::None, 1, 1, 1}, // 0x8b
+    {"ADC A,H",        OperandKind::None, 1, 1, 1}, // 0x8c
+    {"ADC A,L",        OperandKind::None, 1, 1, 1}, // 0x8d
+    {"ADC A,(HL)",     OperandKind::None, 1, 2, 2}, // 0x8e
+    {"ADC A,A",        OperandKind::None, 1, 1, 1}, // 0x8f
+    {"SUB A,B",        OperandKind::None, 1, 1, 1}, // 0x90
+    {"SUB A,C",        OperandKind::None, 1, 1, 1}, // 0x91
+    {"SUB A,D",        OperandKind::None, 1, 1, 1}, // 0x92
+    {"SUB A,E",        OperandKind::None, 1, 1, 1}, // 0x93
+    {"SUB A,H",        OperandKind::None, 1, 1, 1}, // 0x94
+    {"SUB A,L",        OperandKind::None, 1, 1, 1}, // 0x95
+    {"SUB A,(HL)",     OperandKind::None, 1, 2, 2}, // 0x96
+    {"SUB A,A",        OperandKind::None, 1, 1, 1}, // 0x97
+    {"SBC A,B",        OperandKind::None, 1, 1, 1}, // 0x98
+    {"SBC A,C",        OperandKind::None, 1, 1, 1}, // 0x99
+    {"SBC A,D",        OperandKind::None, 1, 1, 1}, // 0x9a
+    {"SBC A,E",        OperandKind::None, 1, 1, 1}, // 0x9b
+    {"SBC A,H",        OperandKind::None, 1, 1, 1}, // 0x9c
+    {"SBC A,L",        OperandKind::None, 1, 1, 1}, // 0x9d
+    {"SBC A,(HL)",     OperandKind::None, 1, 2, 2}, // 0x9e
+    {"SBC A,A",        OperandKind::None, 1, 1, 1}, // 0x9f
+    {"AND A,B",        OperandKind::None, 1, 1, 1}, // 0xa0
+    {"AND A,C",        OperandKind::None, 1, 1, 1}, // 0xa1
+    {"AND A,D",        OperandKind::None, 1, 1, 1}, // 0xa2
+    {"AND A,E",        OperandKind::None, 1, 1, 1}, // 0xa3
+    {"AND A,H",        OperandKind::None, 1, 1, 1}, // 0xa4
+    {"AND A,L",        OperandKind::None, 1, 1, 1}, // 0xa5
+    {"AND A,(HL)",     OperandKind::None, 1, 2, 2}, // 0xa6
+    {"AND A,A",        OperandKind::None, 1, 1, 1}, // 0xa7
+    {"XOR A,B",        OperandKind::None, 1, 1, 1}, // 0xa8
+    {"XOR A,C",        OperandKind::None, 1, 1, 1}, // 0xa9
+    {"XOR A,D",        OperandKind::None, 1, 1, 1}, // 0xaa
+    {"XOR A,E",        OperandKind::None, 1, 1, 1}, // 0xab
+    {"XOR A,H",        OperandKind::None, 1, 1, 1}, // 0xac
+    {"XOR A,L",        OperandKind::None, 1, 1, 1}, // 0xad
+    {"XOR A,(HL)",     OperandKind::None, 1, 2, 2}, // 0xae
+    {"XOR A,A",        OperandKind::None, 1, 1, 1}, // 0xaf
+    {"OR A,B",         OperandKind::None, 1, 1, 1}, // 0xb0
+    {"OR A,C",         OperandKind::None, 1, 1, 1}, // 0xb1
+    {"OR A,D",         OperandKind::None, 1, 1, 1}, // 0xb2
+    {"OR A,E",         OperandKind::None, 1, 1, 1}, // 0xb3
+    {"OR A,H",         OperandKind::None, 1, 1, 1}, // 0xb4
+    {"OR A,L",         OperandKind::None, 1, 1, 1}, // 0xb5
+    {"OR A,(HL)",      OperandKind::None, 1, 2, 2}, // 0xb6
+    {"OR A,A",         OperandKind::None, 1, 1, 1}, // 0xb7
+    {"CP A,B",         OperandKind::None, 1, 1, 1}, // 0xb8
+    {"CP A,C",         OperandKind::None, 1, 1, 1}, // 0xb9
+    {"CP A,D",         OperandKind::None, 1, 1, 1}, // 0xba
+    {"CP A,E",         OperandKind::None, 1, 1, 1}, // 0xbb
+    {"CP A,H",         OperandKind::None, 1, 1, 1}, // 0xbc
+    {"CP A,L",         OperandKind::None, 1, 1, 1}, // 0xbd
+    {"CP A,(HL)",      OperandKind::None, 1, 2, 2}, // 0xbe
+    {"CP A,A",         OperandKind::None, 1, 1, 1}, // 0xbf
+    {"RET NZ",         OperandKind::None, 1, 2, 5}, // 0xc0
+    {"POP BC",         OperandKind::None, 1, 3, 3}, // 0xc1
+    {"JP NZ,u16",      OperandKind::U16,  3, 3, 4}, // 0xc2
+    {"JP u16",         OperandKind::U16,  3, 4, 4}, // 0xc3
+    {"CALL NZ,u16",    OperandKind::U16,  3, 3, 6}, // 0xc4
+    {"PUSH BC",        OperandKind::None, 1, 4, 4}, // 0xc5
+    {"ADD A,u8",       OperandKind::U8,   2, 2, 2}, // 0xc6
+    {"RST 00h",        OperandKind::None, 1, 4, 4}, // 0xc7
+    {"RET Z",          OperandKind::None, 1, 2, 5}, // 0xc8
+    {"RET",            OperandKind::None, 1, 4, 4}, // 0xc9
+    {"JP Z,u16",       OperandKind::U16,  3, 3, 4}, // 0xca
+    {"PREFIX CB",      OperandKind::None, 1, 1, 1}, // 0xcb
+    {"CALL Z,u16",     OperandKind::U16,  3, 3, 6}, // 0xcc
+    {"CALL u16",       OperandKind::U16,  3, 6, 6}, // 0xcd
+    {"ADC A,u8",       OperandKind::U8,   2, 2, 2}, // 0xce
+    {"RST 08h",        OperandKind::None, 1, 4, 4}, // 0xcf
+    {"RET NC",         OperandKind::None, 1, 2, 5}, // 0xd0
+    {"POP DE",         OperandKind::None, 1, 3, 3}, // 0xd1
+    {"JP NC,u16",      OperandKind::U16,  3, 3, 4}, // 0xd2
+    {"UNUSED",         OperandKind::None, 1, 1, 1}, // 0xd3
+    {"CALL NC,u16",    OperandKind::U16,  3, 3, 6}, // 0xd4
+    {"PUSH DE",        OperandKind::None, 1, 4, 4}, // 0xd5
+    {"SUB A,u8",       OperandKind::U8,   2, 2, 2}, // 0xd6
+    {"RST 10h",        OperandKind::None, 1, 4, 4}, // 0xd7
+    {"RET C",          OperandKind::None, 1, 2, 5}, // 0xd8
+    {"RETI",           OperandKind::None, 1, 4, 4}, // 0xd9
+    {"JP C,u16",       OperandKind::U16,  3, 3, 4}, // 0xda
+    {"UNUSED",         OperandKind::None, 1, 1, 1}, // 0xdb
+    {"CALL C,u16",     OperandKind::U16,  3, 3, 6}, // 0xdc
+    {"UNUSED",         OperandKind::None, 1, 1, 1}, // 0xdd
+    {"SBC A,u8",       OperandKind::U8,   2, 2, 2}, // 0xde
+    {"RST 18h",        OperandKind::None, 1, 4, 4}, // 0xdf
+    {"LD (FF00+u8),A", OperandKind::U8,   2, 3, 3}, // 0xe0
+    {"POP HL",         OperandKind::None, 1, 3, 3}, // 0xe1
+    {"LD (FF00+C),A",  OperandKind::None, 1, 2, 2}, // 0xe2
+    {"UNUSED",         OperandKind::None, 1, 1, 1}, // 0xe3
+    {"UNUSED",         OperandKind::None, 1, 1, 1}, // 0xe4
+    {"PUSH HL",        OperandKind::None, 1, 4, 4}, // 0xe5
+    {"AND A,u8",       OperandKind::U8,   2, 2, 2}, // 0xe6
+    {"RST 20h",        OperandKind::None, 1, 4, 4}, // 0xe7
+    {"ADD SP,i8",      OperandKind::I8,   2, 4, 4}, // 0xe8
+    {"JP HL",          OperandKind::None, 1, 1, 1}, // 0xe9
+    {"LD (u16),A",     OperandKind::U16,  3, 4, 4}, // 0xea
+    {"UNUSED",         OperandKind::None, 1, 1, 1}, // 0xeb
+    {"UNUSED",         OperandKind::None, 1, 1, 1}, // 0xec
+    {"UNUSED",         OperandKind::None, 1, 1, 1}, // 0xed
+    {"XOR A,u8",       OperandKind::U8,   2, 2, 2}, // 0xee
+    {"RST 28h",        OperandKind::None, 1, 4, 4}, // 0xef
+    {"LD A,(FF00+u8)", OperandKind::U8,   2, 3, 3}, // 0xf0
+    {"POP AF",         OperandKind::None, 1, 3, 3}, // 0xf1
+    {"LD A,(FF00+C)",  OperandKind::None, 1, 2, 2}, // 0xf2
+    {"DI",             OperandKind::None, 1, 1, 1}, // 0xf3
+    {"UNUSED",         OperandKind::None, 1, 1, 1}, // 0xf4
+    {"PUSH AF",        OperandKind::None, 1, 4, 4}, // 0xf5
+    {"OR A,u8",        OperandKind::U8,   2, 2, 2}, // 0xf6
+    {"RST 30h",        OperandKind::None, 1, 4, 4}, // 0xf7
+    {"LD HL,SP+i8",    OperandKind::I8,   2, 3, 3}, // 0xf8
+    {"LD SP,HL",       OperandKind::None, 1, 2, 2}, // 0xf9
+    {"LD A,(u16)",     OperandKind::U16,  3, 4, 4}, // 0xfa
+    {"EI",             OperandKind::None, 1, 1, 1}, // 0xfb
+    {"UNUSED",         OperandKind::None, 1, 1, 1}, // 0xfc
+    {"UNUSED",         OperandKind::None, 1, 1, 1}, // 0xfd
+    {"CP A,u8",        OperandKind::U8,   2, 2, 2}, // 0xfe
+    {"RST 38h",        OperandKind::None, 1, 4, 4}, // 0xff
+}};
+
+// The opcodes after the 0xcb prefix, the size and the cycles include the prefix
+inline constexpr std::array<OpcodeInfo, 256> prefixedOpcodeTable{{
+    {"RLC B",      OperandKind::None, 2, 2, 2}, // 0x00
+    {"RLC C",      OperandKind::None, 2, 2, 2}, // 0x01
+    {"RLC D",      OperandKind::None, 2, 2, 2}, // 0x02
+    {"RLC E",      OperandKind::None, 2, 2, 2}, // 0x03
+    {"RLC H",      OperandKind::None, 2, 2, 2}, // 0x04
+    {"RLC L",      OperandKind::None, 2, 2, 2}, // 0x05
+    {"RLC (HL)",   OperandKind::None, 2, 4, 4}, // 0x06
+    {"RLC A",      OperandKind::None, 2, 2, 2}, // 0x07
+    {"RRC B",      OperandKind::None, 2, 2, 2}, // 0x08
+    {"RRC C",      OperandKind::None, 2, 2, 2}, // 0x09
+    {"RRC D",      OperandKind::None, 2, 2, 2}, // 0x0a
+    {"RRC E",      OperandKind::None, 2, 2, 2}, // 0x0b
+    {"RRC H",      OperandKind::None, 2, 2, 2}, // 0x0c
+    {"RRC L",      OperandKind::None, 2, 2, 2}, // 0x0d
+    {"RRC (HL)",   OperandKind::None, 2, 4, 4}, // 0x0e
+    {"RRC A",      OperandKind::None, 2, 2, 2}, // 0x0f
+    {"RL B",       OperandKind::None, 2, 2, 2}, // 0x10
+    {"RL C",       OperandKind::None, 2, 2, 2}, // 0x11
+    {"RL D",       OperandKind::None, 2, 2, 2}, // 0x12
+    {"RL E",       OperandKind::None, 2, 2, 2}, // 0x13
+    {"RL H",       OperandKind::None, 2, 2, 2}, // 0x14
+    {"RL L",       OperandKind::None, 2, 2, 2}, // 0x15
+    {"RL (HL)",    OperandKind::None, 2, 4, 4}, // 0x16
+    {"RL A",       OperandKind::None, 2, 2, 2}, // 0x17
+    {"RR B",       OperandKind::None, 2, 2, 2}, // 0x18
+    {"RR C",       OperandKind::None, 2, 2, 2}, // 0x19
+    {"RR D",       OperandKind::None, 2, 2, 2}, // 0x1a
+    {"RR E",       OperandKind::None, 2, 2, 2}, // 0x1b
+    {"RR H",       OperandKind::None, 2, 2, 2}, // 0x1c
+    {"RR L",       OperandKind::None, 2, 2, 2}, // 0x1d
+    {"RR (HL)",    OperandKind::None, 2, 4, 4}, // 0x1e
+    {"RR A",       OperandKind::None, 2, 2, 2}, // 0x1f
+    {"SLA B",      OperandKind::None, 2, 2, 2}, // 0x20
+    {"SLA C",      OperandKind::None, 2, 2, 2}, // 0x21
+    {"SLA D",      OperandKind::None, 2, 2, 2}, // 0x22
+    {"SLA E",      OperandKind::None, 2, 2, 2}, // 0x23
+    {"SLA H",      OperandKind::None, 2, 2, 2}, // 0x24
+    {"SLA L",      OperandKind::None, 2, 2, 2}, // 0x25
+    {"SLA (HL)",   OperandKind::None, 2, 4, 4}, // 0x26
+    {"SLA A",      OperandKind::None, 2, 2, 2}, // 0x27
+    {"SRA B",      OperandKind::None, 2, 2, 2}, // 0x28
+    {"SRA C",      OperandKind::None, 2, 2, 2}, // 0x29
+    {"SRA D",      OperandKind::None, 2, 2, 2}, // 0x2a
+    {"SRA E",      OperandKind::None, 2, 2, 2}, // 0x2b
+    {"SRA H",      OperandKind::None, 2, 2, 2}, // 0x2c
+    {"SRA L",      OperandKind::None, 2, 2, 2}, // 0x2d
+    {"SRA (HL)",   OperandKind::None, 2, 4, 4}, // 0x2e
+    {"SRA A",      OperandKind::None, 2, 2, 2}, // 0x2f
+    {"SWAP B",     OperandKind::None, 2, 2, 2}, // 0x30
+    {"SWAP C",     OperandKind::None, 2, 2, 2}, // 0x31
+    {"SWAP D",     OperandKind::None, 2, 2, 2}, // 0x32
+    {"SWAP E",     OperandKind::None, 2, 2, 2}, // 0x33
+    {"SWAP H",     OperandKind::None, 2, 2, 2}, // 0x34
+    {"SWAP L",     OperandKind::None, 2, 2, 2}, // 0x35
+    {"SWAP (HL)",  OperandKind::None, 2, 4, 4}, // 0x36
+    {"SWAP A",     OperandKind::None, 2, 2, 2}, // 0x37
+    {"SRL B",      OperandKind::None, 2, 2, 2}, // 0x38
+    {"SRL C",      OperandKind::None, 2, 2, 2}, // 0x39
+    {"SRL D",      OperandKind::None, 2, 2, 2}, // 0x3a
+    {"SRL E",      OperandKind::None, 2, 2, 2}, // 0x3b
+    {"SRL H",      OperandKind::None, 2, 2, 2}, // 0x3c
+    {"SRL L",      OperandKind::None, 2, 2, 2}, // 0x3d
+    {"SRL (HL)",   OperandKind::None, 2, 4, 4}, // 0x3e
+    {"SRL A",      OperandKind::None, 2, 2, 2}, // 0x3f
+    {"BIT 0,B",    OperandKind::None, 2, 2, 2}, // 0x40
+    {"BIT 0,C",    OperandKind::None, 2, 2, 2}, // 0x41
+    {"BIT 0,D",    OperandKind::None, 2, 2, 2}, // 0x42
+    {"BIT 0,E",    OperandKind::None, 2, 2, 2}, // 0x43
+    {"BIT 0,H",    OperandKind::None, 2, 2, 2}, // 0x44
+    {"BIT 0,L",    OperandKind::None, 2, 2, 2}, // 0x45
+    {"BIT 0,(HL)", OperandKind::None, 2, 3, 3}, // 0x46
+    {"BIT 0,A",    OperandKind::None, 2, 2, 2}, // 0x47
+    {"BIT 1,B",    OperandKind::None, 2, 2, 2}, // 0x48
+    {"BIT 1,C",    OperandKind::None, 2, 2, 2}, // 0x49
+    {"BIT 1,D",    OperandKind::None, 2, 2, 2}, // 0x4a
+    {"BIT 1,E",    OperandKind::None, 2, 2, 2}, // 0x4b
+    {"BIT 1,H",    OperandKind::None, 2, 2, 2}, // 0x4c
+    {"BIT 1,L",    OperandKind::None, 2, 2, 2}, // 0x4d
+    {"BIT 1,(HL)", OperandKind::None, 2, 3, 3}, // 0x4e
+    {"BIT 1,A",    OperandKind::None, 2, 2, 2}, // 0x4f
+    {"BIT 2,B",    OperandKind::None, 2, 2, 2}, // 0x50
+    {"BIT 2,C",    OperandKind::None, 2, 2, 2}, // 0x51
+    {"BIT 2,D",    OperandKind::None, 2, 2, 2}, // 0x52
+    {"BIT 2,E",    OperandKind::None, 2, 2, 2}, // 0x53
+    {"BIT 2,H",    OperandKind::None, 2, 2, 2}, // 0x54
+    {"BIT 2,L",    OperandKind::None, 2, 2, 2}, // 0x55
+    {"BIT 2,(HL)", OperandKind::None, 2, 3, 3}, // 0x56
+    {"BIT 2,A",    OperandKind::None, 2, 2, 2}, // 0x57
+    {"BIT 3,B",    OperandKind::None, 2, 2, 2}, // 0x58
+    {"BIT 3,C",    OperandKind::None, 2, 2, 2}, // 0x59
+    {"BIT 3,D",    OperandKind::None, 2, 2, 2}, // 0x5a
+    {"BIT 3,E",    OperandKind::None, 2, 2, 2}, // 0x5b
+    {"BIT 3,H",    OperandKind::None, 2, 2, 2}, // 0x5c
+    {"BIT 3,L",    OperandKind::None, 2, 2, 2}, // 0x5d
+    {"BIT 3,(HL)", OperandKind::None, 2, 3, 3}, // 0x5e
+    {"BIT 3,A",    OperandKind::None, 2, 2, 2}, // 0x5f
+    {"BIT 4,B",    OperandKind::None, 2, 2, 2}, // 0x60
+    {"BIT 4,C",    OperandKind::None, 2, 2, 2}, // 0x61
+    {"BIT 4,D",    OperandKind::None, 2, 2, 2}, // 0x62
+    {"BIT 4,E",    OperandKind::None, 2, 2, 2}, // 0x63
+    {"BIT 4,H",    OperandKind::None, 2, 2, 2}, // 0x64
+    {"BIT 4,L",    OperandKind::None, 2, 2, 2}, // 0x65
+    {"BIT 4,(HL)", OperandKind::None, 2, 3, 3}, // 0x66
+    {"BIT 4,A",    OperandKind::None, 2, 2, 2}, // 0x67
+    {"BIT 5,B",    OperandKind::None, 2, 2, 2}, // 0x68
+    {"BIT 5,C",    OperandKind::None, 2, 2, 2}, // 0x69
+    {"BIT 5,D",    OperandKind::None, 2, 2, 2}, // 0x6a
+    {"BIT 5,E",    OperandKind::None, 2, 2, 2}, // 0x6b
+    {"BIT 5,H",    OperandKind::None, 2, 2, 2}, // 0x6c
+    {"BIT 5,L",    OperandKind::None, 2, 2, 2}, // 0x6d
+    {"BIT 5,(HL)", OperandKind::None, 2, 3, 3}, // 0x6e
+    {"BIT 5,A",    OperandKind::None, 2, 2, 2}, // 0x6f
+    {"BIT 6,B",    OperandKind::None, 2, 2, 2}, // 0x70
+    {"BIT 6,C",    OperandKind::None, 2, 2, 2}, // 0x71
+    {"BIT 6,D",    OperandKind::None, 2, 2, 2}, // 0x72
+    {"BIT 6,E",    OperandKind::None, 2, 2, 2}, // 0x73
+    {"BIT 6,H",    OperandKind::None, 2, 2, 2}, // 0x74
+    {"BIT 6,L",    OperandKind::None, 2, 2, 2}, // 0x75
+    {"BIT 6,(HL)", OperandKind::None, 2, 3, 3}, // 0x76
+    {"BIT 6,A",    OperandKind::None, 2, 2, 2}, // 0x77
+    {"BIT 7,B",    OperandKind::None, 2, 2, 2}, // 0x78
+    {"BIT 7,C",    OperandKind::None, 2, 2, 2}, // 0x79
+    {"BIT 7,D",    OperandKind::None, 2, 2, 2}, // 0x7a
+    {"BIT 7,E",    OperandKind::None, 2, 2, 2}, // 0x7b
+    {"BIT 7,H",    OperandKind::None, 2, 2, 2}, // 0x7c
+    {"BIT 7,L",    OperandKind::None, 2, 2, 2}, // 0x7d
+    {"BIT 7,(HL)", OperandKind::None, 2, 3, 3}, // 0x7e
+    {"BIT 7,A",    OperandKind::None, 2, 2, 2}, // 0x7f
+    {"RES 0,B",    OperandKind::None, 2, 2, 2}, // 0x80
+    {"RES 0,C",    OperandKind::None, 2, 2, 2}, // 0x81
+    {"RES 0,D",    OperandKind::None, 2, 2, 2}, // 0x82
+    {"RES 0,E",    OperandKind::None, 2, 2, 2}, // 0x83
+    {"RES 0,H",    OperandKind::None, 2, 2, 2}, // 0x84
+    {"RES 0,L",    OperandKind::None, 2, 2, 2}, // 0x85
+    {"RES 0,(HL)", OperandKind::None, 2, 4, 4}, // 0x86
+    {"RES 0,A",    OperandKind::None, 2, 2, 2}, // 0x87
+    {"RES 1,B",    OperandKind::None, 2, 2, 2}, // 0x88
+    {"RES 1,C",    OperandKind::None, 2, 2, 2}, // 0x89
+    {"RES 1,D",    OperandKind::None, 2, 2, 2}, // 0x8a
+    {"RES 1,E",    OperandKind::None, 2, 2, 2}, // 0x8b
+    {"RES 1,H",    OperandKind::None, 2, 2, 2}, // 0x8c
+    {"RES 1,L",    OperandKind::None, 2, 2, 2}, // 0x8d
+    {"RES 1,(HL)", OperandKind::None, 2, 4, 4}, // 0x8e
+    {"RES 1,A",    OperandKind::None, 2, 2, 2}, // 0x8f
+    {"RES 2,B",    OperandKind::None, 2, 2, 2}, // 0x90
+    {"RES 2,C",    OperandKind::None, 2, 2, 2}, // 0x91
+    {"RES 2,D",    OperandKind::None, 2, 2, 2}, // 0x92
+    {"RES 2,E",    OperandKind::None, 2, 2, 2}, // 0x93
+    {"RES 2,H",    OperandKind::None, 2, 2, 2}, // 0x94
+    {"RES 2,L",    OperandKind::None, 2, 2, 2}, // 0x95
+    {"RES 2,(HL)", OperandKind::None, 2, 4, 4}, // 0x96
+    {"RES 2,A",    OperandKind::None, 2, 2, 2}, // 0x97
+    {"RES 3,B",    OperandKind::None, 2, 2, 2}, // 0x98
+    {"RES 3,C",    OperandKind::None, 2, 2, 2}, // 0x99
+    {"RES 3,D",    OperandKind::None, 2, 2, 2}, // 0x9a
+    {"RES 3,E",    OperandKind::None, 2, 2, 2}, // 0x9b
+    {"RES 3,H",    OperandKind::None, 2, 2, 2}, // 0x9c
+    {"RES 3,L",    OperandKind::None, 2, 2, 2}, // 0x9d
+    {"RES 3,(HL)", OperandKind::None, 2, 4, 4}, // 0x9e
+    {"RES 3,A",    OperandKind::None, 2, 2, 2}, // 0x9f
+    {"RES 4,B",    OperandKind::None, 2, 2, 2}, // 0xa0
+    {"RES 4,C",    OperandKind::None, 2, 2, 2}, // 0xa1
+    {"RES 4,D",    OperandKind::None, 2, 2, 2}, // 0xa2
+    {"RES 4,E",    OperandKind::None, 2, 2, 2}, // 0xa3
+    {"RES 4,H",    OperandKind::None, 2, 2, 2}, // 0xa4
+    {"RES 4,L",    OperandKind::None, 2, 2, 2}, // 0xa5
+    {"RES 4,(HL)", OperandKind::None, 2, 4, 4}, // 0xa6
+    {"RES 4,A",    OperandKind::None, 2, 2, 2}, // 0xa7
+    {"RES 5,B",    OperandKind::None, 2, 2, 2}, // 0xa8
+    {"RES 5,C",    OperandKind::None, 2, 2, 2}, // 0xa9
+    {"RES 5,D",    OperandKind::None, 2, 2, 2}, // 0xaa
+    {"RES 5,E",    OperandKind::None, 2, 2, 2}, // 0xab
+    {"RES 5,H",    OperandKind::None, 2, 2, 2}, // 0xac
+    {"RES 5,L",    OperandKind::None, 2, 2, 2}, // 0xad
+    {"RES 5,(HL)", OperandKind::None, 2, 4, 4}, // 0xae
+    {"RES 5,A",    OperandKind::None, 2, 2, 2}, // 0xaf
+    {"RES 6,B",    OperandKind::None, 2, 2, 2}, // 0xb0
+    {"RES 6,C",    OperandKind::None, 2, 2, 2}, // 0xb1
+    {"RES 6,D",    OperandKind::None, 2, 2, 2}, // 0xb2
+    {"RES 6,E",    OperandKind::None, 2, 2, 2}, // 0xb3
+    {"RES 6,H",    OperandKind::None, 2, 2, 2}, // 0xb4
+    {"RES 6,L",    OperandKind::None, 2, 2, 2}, // 0xb5
+    {"RES 6,(HL)", OperandKind::None, 2, 4, 4}, // 0xb6
+    {"RES 6,A",    OperandKind::None, 2, 2, 2}, // 0xb7
+    {"RES 7,B",    OperandKind::None, 2, 2, 2}, // 0xb8
+    {"RES 7,C",    OperandKind::None, 2, 2, 2}, // 0xb9
+    {"RES 7,D",    OperandKind::None, 2, 2, 2}, // 0xba
+    {"RES 7,E",    OperandKind::None, 2, 2, 2}, // 0xbb
+    {"RES 7,H",    OperandKind::None, 2, 2, 2}, // 0xbc
+    {"RES 7,L",    OperandKind::None, 2, 2, 2}, // 0xbd
+    {"RES 7,(HL)", OperandKind::None, 2, 4, 4}, // 0xbe
+    {"RES 7,A",    OperandKind::None, 2, 2, 2}, // 0xbf
+    {"SET 0,B",    OperandKind::None, 2, 2, 2}, // 0xc0
+    {"SET 0,C",    OperandKind::None, 2, 2, 2}, // 0xc1
+    {"SET 0,D",    OperandKind::None, 2, 2, 2}, // 0xc2
+    {"SET 0,E",    OperandKind::None, 2, 2, 2}, // 0xc3
+    {"SET 0,H",    OperandKind::None, 2, 2, 2}, // 0xc4
+    {"SET 0,L",    OperandKind::None, 2, 2, 2}, // 0xc5
+    {"SET 0,(HL)", OperandKind::None, 2, 4, 4}, // 0xc6
+    {"SET 0,A",    OperandKind::None, 2, 2, 2}, // 0xc7
+    {"SET 1,B",    OperandKind::None, 2, 2, 2}, // 0xc8
+    {"SET 1,C",    OperandKind::None, 2, 2, 2}, // 0xc9
+    {"SET 1,D",    OperandKind::None, 2, 2, 2}, // 0xca
+    {"SET 1,E",    OperandKind::None, 2, 2, 2}, // 0xcb
+    {"SET 1,H",    OperandKind::None, 2, 2, 2}, // 0xcc
+    {"SET 1,L",    OperandKind::None, 2, 2, 2}, // 0xcd
+    {"SET 1,(HL)", OperandKind::None, 2, 4, 4}, // 0xce
+    {"SET 1,A",    OperandKind::None, 2, 2, 2}, // 0xcf
+    {"SET 2,B",    OperandKind::None, 2, 2, 2}, // 0xd0
+    {"SET 2,C",    OperandKind::None, 2, 2, 2}, // 0xd1
+    {"SET 2,D",    OperandKind::None, 2, 2, 2}, // 0xd2
+    {"SET 2,E",    OperandKind::None, 2, 2, 2}, // 0xd3
+    {"SET 2,H",    OperandKind::None, 2, 2, 2}, // 0xd4
+    {"SET 2,L",    OperandKind::None, 2, 2, 2}, // 0xd5
+    {"SET 2,(HL)", OperandKind::None, 2, 4, 4}, // 0xd6
+    {"SET 2,A",    OperandKind::None, 2, 2, 2}, // 0xd7
+    {"SET 3,B",    OperandKind::None, 2, 2, 2}, // 0xd8
+    {"SET 3,C",    OperandKind::None, 2, 2, 2}, // 0xd9
+    {"SET 3,D",    OperandKind::None, 2, 2, 2}, // 0xda
+    {"SET 3,E",    OperandKind::None, 2, 2, 2}, // 0xdb
+    {"SET 3,H",    OperandKind::None, 2, 2, 2}, // 0xdc
+    {"SET 3,L",    OperandKind::None, 2, 2, 2}, // 0xdd
+    {"SET 3,(HL)", OperandKind::None, 2, 4, 4}, // 0xde
+    {"SET 3,A",    OperandKind::None, 2, 2, 2}, // 0xdf
+    {"SET 4,B",    OperandKind::None, 2, 2, 2}, // 0xe0
+    {"SET 4,C",    OperandKind::None, 2, 2, 2}, // 0xe1
+    {"SET 4,D",    OperandKind::None, 2, 2, 2}, // 0xe2
+    {"SET 4,E",    OperandKind::None, 2, 2, 2}, // 0xe3
+    {"SET 4,H",    OperandKind::None, 2, 2, 2}, // 0xe4
+    {"SET 4,L",    OperandKind::None, 2, 2, 2}, // 0xe5
+    {"SET 4,(HL)", OperandKind::None, 2, 4, 4}, // 0xe6
+    {"SET 4,A",    OperandKind::None, 2, 2, 2}, // 0xe7
+    {"SET 5,B",    OperandKind::None, 2, 2, 2}, // 0xe8
+    {"SET 5,C",    OperandKind::None, 2, 2, 2}, // 0xe9
+    {"SET 5,D",    OperandKind::None, 2, 2, 2}, // 0xea
+    {"SET 5,E",    OperandKind::None, 2, 2, 2}, // 0xeb
+    {"SET 5,H",    OperandKind::None, 2, 2, 2}, // 0xec
+    {"SET 5,L",    OperandKind::None, 2, 2, 2}, // 0xed
+    {"SET 5,(HL)", OperandKind::None, 2, 4, 4}, // 0xee
+    {"SET 5,A",    OperandKind::None, 2, 2, 2}, // 0xef
+    {"SET 6,B",    OperandKind::None, 2, 2, 2}, // 0xf0
+    {"SET 6,C",    OperandKind::None, 2, 2, 2}, // 0xf1
+    {"SET 6,D",    OperandKind::None, 2, 2, 2}, // 0xf2
+    {"SET 6,E",    OperandKind::None, 2, 2, 2}, // 0xf3
+    {"SET 6,H",    OperandKind::None, 2, 2, 2}, // 0xf4
+    {"SET 6,L",    OperandKind::None, 2, 2, 2}, // 0xf5
+    {"SET 6,(HL)", OperandKind::None, 2, 4, 4}, // 0xf6
+    {"SET 6,A",    OperandKind::None, 2, 2, 2}, // 0xf7
+    {"SET 7,B",    OperandKind::None, 2, 2, 2}, // 0xf8
+    {"SET 7,C",    OperandKind::None, 2, 2, 2}, // 0xf9
+    {"SET 7,D",    OperandKind::None, 2, 2, 2}, // 0xfa
+    {"SET 7,E",    OperandKind::None, 2, 2, 2}, // 0xfb
+    {"SET 7,H",    OperandKind::None, 2, 2, 2}, // 0xfc
+    {"SET 7,L",    OperandKind::None, 2, 2, 2}, // 0xfd
+    {"SET 7,(HL)", OperandKind::None, 2, 4, 4}, // 0xfe
+    {"SET 7,A",    OperandKind::None, 2, 2, 2}, // 0xff
+}};
+
+namespace OpcodeTableDetail
+{
+constexpr int getOperandSize(OperandKind kind)
+{
+    switch (kind)
+    {
+    case OperandKind::None: return 0;
+    case OperandKind::U8:
+    case OperandKind::I8:   return 1;
+    case OperandKind::U16:  return 2;
+    }
+    return -1;
+}
+
+constexpr bool isTableValid(const std::array<OpcodeInfo, 256> &table, int prefixSize)
+{
+    for (const OpcodeInfo &info : table)
+    {
+        // STOP is followed by a byte that is skipped
+        const int operandSize{info.mnemonic == "STOP" ? 1 : getOperandSize(info.operandKind)};
+        if (info.mnemonic.empty()
+         || info.size != prefixSize+1+operandSize
+         || info.branchCycles < info.cycles)
+            return false;
+    }
+    return true;
+}
+}
+
+static_assert(OpcodeTableDetail::isTableValid(opcodeTable, 0), "Invalid opcode table");
+static_assert(OpcodeTableDetail::isTableValid(prefixedOpcodeTable, 1), "Invalid prefixed opcode table");
+
+inline constexpr const OpcodeInfo& getOpcodeInfo(uint8_t opcode, bool isPrefixed)
+{
+    return isPrefixed ? prefixedOpcodeTable[opcode] : opcodeTable[opcode];
+}
+
+// Returns the mnemonic of the opcode with the operand placeholder replaced by `operand`
+inline std::string disassemble(uint8_t opcode, uint16_t operand, bool isPrefixed)
+{
+    const OpcodeInfo &info{getOpcodeInfo(opcode, isPrefixed)};
+    std::string output{info.mnemonic};
+
+    std::string_view placeholder;
+    std::string value;
+    switch (info.operandKind)
+    {
+    case OperandKind::None:
+        return output;
+
+    case OperandKind::U8:
+        placeholder = "u8";
+        value = toHexStr(operand, 2);
+        break;
+
+    case OperandKind::I8:
+        placeholder = "i8";
+        value = std::to_string((int8_t)operand);
+        break;
+
+    case OperandKind::U16:
+        placeholder = "u16";
+        value = toHexStr(operand, 4);
+        break;
+    }
+
+    const size_t pos{output.find(placeholder)};
+    if (pos != std::string::npos)
+        output.replace(pos, placeholder.size(), value);
+    return output;
+}
+
+#endif /* OPCODE_TABLE_H_ */
@@ -0,0 +1,150 @@
+#ifndef TILE_DECODER_H_
+#define TILE_DECODER_H_
+
+/*
+ * Decoding of the 2 bits per pixel tile data and mapping the color indices to pixels.
+ *
+ * A tile row is 2 bytes, the bit planes. The leftmost pixel is the highest bit,
+ * and the bit of the first byte is the high bit of its color index.
+ * The *Scalar functions work everywhere, the others use SSE2 or AVX2 if the compiler targets them
+ * (AVX2 has to be enabled with -mavx2 or -march=native), and give the same results.
+ */
+
+// Use the scalar functions even if SIMD is available
+//#define TILE_DECODER_NO_SIMD
+
+#include <stdint.h>
+
+#if !defined(TILE_DECODER_NO_SIMD) && defined(__AVX2__)
+#   define TILE_DECODER_AVX2
+#   include <immintrin.h>
+#elif !defined(TILE_DECODER_NO_SIMD) && defined(__SSE2__)
+#   define TILE_DECODER_SSE2
+#   include <emmintrin.h>
+#endif
+
+// The bytes of a tile in the VRAM
+#define TILE_DECODER_TILE_BYTES 16
+
+// The instruction set used by decodeTile() and mapColorIndices()
+#if defined(TILE_DECODER_AVX2)
+#   define TILE_DECODER_NAME "AVX2"
+#elif defined(TILE_DECODER_SSE2)
+#   define TILE_DECODER_NAME "SSE2"
+#else
+#   define TILE_DECODER_NAME "scalar"
+#endif
+
+// Writes the 8 color indices of a tile row to `pixels`
+inline void decodeTileRowScalar(uint8_t plane0, uint8_t plane1, uint8_t *pixels)
+{
+    for (int x{}; x < 8; ++x)
+    {
+        const int bitI{7-x};
+        pixels[x] = uint8_t((((plane0 >> bitI) & 1) << 1) | ((plane1 >> bitI) & 1));
+    }
+}
+
+// Writes the 64 color indices of the tile at `tileData` to `pixels`, row by row
+inline void decodeTileScalar(const uint8_t *tileData, uint8_t *pixels)
+{
+    for (int rowI{}; rowI < 8; ++rowI)
+        decodeTileRowScalar(tileData[rowI*2], tileData[rowI*2+1], pixels+rowI*8);
+}
+
+// Writes `count` pixels to `pixels`, the colors of `indices` in `palette`
+inline void mapColorIndicesScalar(const uint8_t *indices, int count, const uint32_t *palette, uint32_t *pixels)
+{
+    for (int i{}; i < count; ++i)
+        pixels[i] = palette[indices[i]];
+}
+
+inline void decodeTile(const uint8_t *tileData, uint8_t *pixels)
+{
+#if defined(TILE_DECODER_AVX2)
+    // Both lanes get the whole tile, then each lane makes 2 rows
+    const __m256i data{_mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)tileData))};
+    // Broadcasts the plane bytes of rows 0-3 to 8 bytes each
+    const __m256i plane0Shuffle{_mm256_setr_epi8(
+            0, 0, 0, 0, 0, 0, 0, 0, 2, 2, 2, 2, 2, 2, 2, 2,
+            4, 4, 4, 4, 4, 4, 4, 4, 6, 6, 6, 6, 6, 6, 6, 6)};
+    const __m256i plane1Shuffle{_mm256_add_epi8(plane0Shuffle, _mm256_set1_epi8(1))};
+    // The bit of each pixel in a row
+    const __m256i bitMask{_mm256_set1_epi64x(0x0102040810204080)};
+
+    for (int half{}; half < 2; ++half)
+    {
+        // Rows 4-7 are 8 bytes later
+        const __m256i rowOffset{_mm256_set1_epi8(char(half*8))};
+        const __m256i plane0{_mm256_shuffle_epi8(data, _mm256_add_epi8(plane0Shuffle, rowOffset))};
+        const __m256i plane1{_mm256_shuffle_epi8(data, _mm256_add_epi8(plane1Shuffle, rowOffset))};
+        const __m256i bits0{_mm256_cmpeq_epi8(_mm256_and_si256(plane0, bitMask), bitMask)};
+        const __m256i bits1{_mm256_cmpeq_epi8(_mm256_and_si256(plane1, bitMask), bitMask)};
+        const __m256i colorIs{_mm256_or_si256(
+                _mm256_and_si256(bits0, _mm256_set1_epi8(2)), _mm256_and_si256(bits1, _mm256_set1_epi8(1)))};
+        _mm256_storeu_si256((__m256i*)(pixels+half*32), colorIs);
+    }
+#elif defined(TILE_DECODER_SSE2)
+    const __m128i data{_mm_loadu_si128((const __m128i*)tileData)};
+    const __m128i bitMask{_mm_set1_epi64x(0x0102040810204080)};
+
+    // `rowA` and `rowB` are the plane 0 byte 8 times then the plane 1 byte 8 times, returns both rows decoded
+    auto decodeRowPair{[&bitMask](__m128i rowA, __m128i rowB){
+        const __m128i bitsA{_mm_cmpeq_epi8(_mm_and_si128(rowA, bitMask), bitMask)};
+        const __m128i bitsB{_mm_cmpeq_epi8(_mm_and_si128(rowB, bitMask), bitMask)};
+        const __m128i plane0{_mm_unpacklo_epi64(bitsA, bitsB)};
+        const __m128i plane1{_mm_unpackhi_epi64(bitsA, bitsB)};
+        return _mm_or_si128(_mm_and_si128(plane0, _mm_set1_epi8(2)), _mm_and_si128(plane1, _mm_set1_epi8(1)));
+    }};
+
+    for (int half{}; half < 2; ++half)
+    {
+        // Each byte of rows 0-3 (or 4-7) twice, then 4 times
+        const __m128i bytes2{half ? _mm_unpackhi_epi8(data, data) : _mm_unpacklo_epi8(data, data)};
+        const __m128i bytes4Lo{_mm_unpacklo_epi16(bytes2, bytes2)};
+        const __m128i bytes4Hi{_mm_unpackhi_epi16(bytes2, bytes2)};
+
+        _mm_storeu_si128((__m128i*)(pixels+half*32),
+                decodeRowPair(_mm_unpacklo_epi32(bytes4Lo, bytes4Lo), _mm_unpackhi_epi32(bytes4Lo, bytes4Lo)));
+        _mm_storeu_si128((__m128i*)(pixels+half*32+16),
+                decodeRowPair(_mm_unpacklo_epi32(bytes4Hi, bytes4Hi), _mm_unpackhi_epi32(bytes4Hi, bytes4Hi)));
+    }
+#else
+    decodeTileScalar(tileData, pixels);
+#endif
+}
+
+inline void mapColorIndices(const uint8_t *indices, int count, const uint32_t *palette, uint32_t *pixels)
+{
+    int i{};
+#if defined(TILE_DECODER_AVX2)
+    // The palette is looked up with a permute, the upper 4 entries are never used
+    const __m256i paletteVec{_mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)palette))};
+    for (; i+8 <= count; i += 8)
+    {
+        const __m256i indexVec{_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(indices+i)))};
+        _mm256_storeu_si256((__m256i*)(pixels+i), _mm256_permutevar8x32_epi32(paletteVec, indexVec));
+    }
+#elif defined(TILE_DECODER_SSE2)
+    const __m128i zero{_mm_setzero_si128()};
+    for (; i+4 <= count; i += 4)
+    {
+        uint32_t indices4;
+        __builtin_memcpy(&indices4, indices+i, 4);
+        const __m128i indexVec{_mm_unpacklo_epi16(
+                _mm_unpacklo_epi8(_mm_cvtsi32_si128(int(indices4)), zero), zero)};
+
+        // Select the entry of each pixel with masks
+        __m128i result{zero};
+        for (int colorI{}; colorI < 4; ++colorI)
+        {
+            const __m128i isColor{_mm_cmpeq_epi32(indexVec, _mm_set1_epi32(colorI))};
+            result = _mm_or_si128(result, _mm_and_si128(isColor, _mm_set1_epi32(int(palette[colorI]))));
+        }
+        _mm_storeu_si128((__m128i*)(pixels+i), result);
+    }
+#endif
+    mapColorIndicesScalar(indices+i, count-i, palette, pixels+i);
+}
+
+#endif /* TILE_DECODER_H_ */